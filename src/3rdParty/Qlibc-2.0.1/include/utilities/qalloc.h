@@ -58,6 +58,7 @@ struct qalloc_obj_s
 extern bool qalloc_init ( void );
 extern void * qalloc_new ( unsigned int, char *, unsigned int );
 extern void * qalloc_add ( void*, unsigned int, char *, unsigned int );
+extern void * qalloc_resize ( void *, unsigned int );
 extern bool qalloc_delete ( void * );
 extern void qalloc_exit ( void );
 
@@ -97,11 +97,10 @@ struct qzip_entry_s
 {
     qzip_cd_file_header_t file_header;
     char file_name[FILENAME_MAX];
-    FILE* file_io;
     z_streamp zlib_stream;
     int compressed_data_position;
-    char* inbuf;
-    int readed;
+    uint8_t* data; // Entry data, in the file mapping
+    uint32_t readed; // Stored bytes already given
 };
 
 typedef struct qzip_file_s qzip_file_t;
@@ -109,14 +108,14 @@ struct qzip_file_s
 {
     qzip_cd_end_record_t zip_end_record;
     char file_name[FILENAME_MAX];
-    FILE* file;
-    char* map;
+    char* map; // Whole file, only read through the mapping so a zip can be shared by threads
     int file_size;
 };
 
 extern qzip_entry_t* qzip_open_entry ( qzip_file_t*, const char*, uint32_t );
 extern bool qzip_seek_entry ( qzip_entry_t*, uint32_t );
 extern int32_t qzip_read_entry ( qzip_entry_t*, uint8_t*, uint32_t );
+extern const uint8_t* qzip_map_entry ( qzip_entry_t*, uint32_t* );
 extern uint8_t* qzip_load_entry ( qzip_file_t*, const char*, uint32_t* );
 extern bool qzip_close_entry ( qzip_entry_t* );
 extern qzip_file_t* qzip_open_file ( const char* );
@@ -174,6 +174,80 @@ void * qalloc_add ( void * memory, unsigned int bytesize, char * filename, unsig
     return ( memory );
 }
 
+/**
+ * Resizes a memory block, keeping its content up to the smallest size.
+ *
+ * @param memory block given by qalloc_new()
+ * @param bytesize new size in bytes
+ *
+ * @return the resized block, which may have moved, NULL when it fails and the block is left unchanged
+ *
+ */
+void * qalloc_resize ( void * memory, unsigned int bytesize )
+{
+    char key[255];
+    qalloc_obj_t mnode;
+    qalloc_obj_t * old = NULL;
+    char * resized = NULL;
+
+    if ( memory == NULL )
+    {
+        errno = EINVAL;
+        return ( NULL );
+    }
+
+    if ( bytesize == 0 )
+    {
+        errno = EINVAL;
+        return ( NULL );
+    }
+
+    sprintf ( key, "%x", ( int ) memory );
+    qstrupper ( key );
+
+    old = qlisttbl_get ( tbl, key, NULL, false );
+    if ( old == NULL )
+    {
+        errno = ENOKEY;
+        return ( NULL );
+    }
+
+    memcpy ( &mnode, old, sizeof ( qalloc_obj_t ) );
+
+    resized = ( char * ) realloc ( mnode.startpointer, ( bytesize + 2 ) );
+    if ( resized == NULL )
+    {
+        errno = ENOMEM;
+        return ( NULL );
+    }
+
+    /* New bytes are zeroed like qalloc_new() ones, overflow guard included */
+    if ( bytesize > mnode.size )
+    {
+        memset ( &resized[mnode.size + 1], 0, ( bytesize - mnode.size ) + 1 );
+    }
+    else
+    {
+        resized[bytesize + 1] = 0;
+    }
+
+    qlisttbl_remove ( tbl, key );
+
+    sprintf ( key, "%x", ( int ) ( resized + 1 ) );
+    qstrupper ( key );
+
+    mnode.startpointer = resized;
+    mnode.size = bytesize;
+
+    if ( qlisttbl_put ( tbl, key, &mnode, sizeof ( qalloc_obj_t ) ) == false )
+    {
+        free ( resized );
+        return ( NULL );
+    }
+
+    return ( ( void * ) ( resized + 1 ) );
+}
+
 /**
  * ????.
  *
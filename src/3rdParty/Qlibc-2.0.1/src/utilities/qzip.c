@@ -58,7 +58,7 @@ static bool search_eof_central_dir ( qzip_file_t* zip_file )
 {
     long readBytes = 0, i = 0;
     qzip_cd_end_record_t *zip_tmp_end_record;
-    unsigned char buffer[BUFFER_SIZE]; // limits maximum zip descriptor size
+    unsigned char* buffer = NULL;
 
     /*
     Depending on the comment length, the start of the EOCD will be at different offsets
@@ -68,14 +68,13 @@ static bool search_eof_central_dir ( qzip_file_t* zip_file )
     If n=0xffff (max length comment), the EOCD starts at 22 + 0xffff = 65557 bytes from
     the end
     The interval where the EOCD signature may exist is between 65557 and 18 from the end.
-    That is a total of about 65.5 kb. That is not much on a modern computer so we can read that
-    whole interval into a buffer and scan it backwards to find the signature.
+    That is a total of about 65.5 kb. That is not much on a modern computer so we can scan
+    that whole interval of the mapping backwards to find the signature.
     */
 
-    // Fill the buffer, but at most the whole file
-    readBytes = ( zip_file->file_size < sizeof ( buffer ) ) ? zip_file->file_size : sizeof ( buffer );
-    fseek ( zip_file->file, zip_file->file_size - readBytes, SEEK_SET );
-    fread ( buffer, 1, readBytes, zip_file->file );
+    // Scan the mapping end, but at most the whole file
+    readBytes = ( zip_file->file_size < BUFFER_SIZE ) ? zip_file->file_size : BUFFER_SIZE;
+    buffer = ( unsigned char* ) zip_file->map + zip_file->file_size - readBytes;
 
     // Naively assume signature can only be found in one place...
     for ( i = readBytes - sizeof ( qzip_cd_end_record_t ); i >= 0; i-- )
@@ -119,52 +118,74 @@ static bool search_eof_central_dir ( qzip_file_t* zip_file )
  */
 static bool search_central_dir ( qzip_file_t* zip_file, qzip_entry_t *zip_entry )
 {
-    unsigned char zip_file_name[FILENAME_MAX];
     qzip_local_file_header_t tmp_file_header;
+    size_t name_length = strlen ( zip_entry->file_name );
+    long position = zip_file->zip_end_record.central_directory_offset;
+    bool found = false;
 
-    // Go to the beginning of central directory
-    fseek ( zip_file->file, zip_file->zip_end_record.central_directory_offset, SEEK_SET );
-
+    // Walk the central directory in the mapping
     for ( int i = 0; i < zip_file->zip_end_record.num_entries; i++ )
     {
-        fread ( &zip_entry->file_header, 1, sizeof ( qzip_cd_file_header_t ), zip_file->file );
-
-        // Check signature
-        if ( zip_entry->file_header.signature != 0x02014B50 )
+        if ( position + ( long ) sizeof ( qzip_cd_file_header_t ) > zip_file->file_size )
         {
             return false;
         }
 
-        fread ( zip_file_name, 1, zip_entry->file_header.filename_length, zip_file->file ); // read filename
-        zip_file_name[zip_entry->file_header.filename_length] = 0;
+        memcpy ( &zip_entry->file_header, zip_file->map + position, sizeof ( qzip_cd_file_header_t ) );
+        position += sizeof ( qzip_cd_file_header_t );
 
-        if ( strcmp ( zip_file_name, zip_entry->file_name ) != 0 )
+        // Check signature
+        if ( zip_entry->file_header.signature != 0x02014B50
+                || position + zip_entry->file_header.filename_length > zip_file->file_size )
         {
-            fseek ( zip_file->file, zip_entry->file_header.extra_field_length, SEEK_CUR ); // skip
-            fseek ( zip_file->file, zip_entry->file_header.file_comment_length, SEEK_CUR ); // skip
-            continue;
+            return false;
         }
 
-        if ( zip_entry->file_header.compression_method != 0
-                && zip_entry->file_header.compression_method != 8 )
+        found = ( zip_entry->file_header.filename_length == name_length
+                  && memcmp ( zip_file->map + position, zip_entry->file_name, name_length ) == 0 );
+
+        // skip filename, extra field and comment
+        position += zip_entry->file_header.filename_length;
+        position += zip_entry->file_header.extra_field_length;
+        position += zip_entry->file_header.file_comment_length;
+
+        if ( found == true )
         {
-            printf ( "Unsupported compression method : %d\n", zip_entry->file_header.compression_method );
-            return false;
+            break;
         }
+    }
 
-        fseek ( zip_file->file, zip_entry->file_header.extra_field_length, SEEK_CUR ); // skip
-        fseek ( zip_file->file, zip_entry->file_header.file_comment_length, SEEK_CUR ); // skip
+    if ( found == false )
+    {
+        return false;
+    }
 
-        break;
+    if ( zip_entry->file_header.compression_method != 0
+            && zip_entry->file_header.compression_method != 8 )
+    {
+        printf ( "Unsupported compression method : %d\n", zip_entry->file_header.compression_method );
+        return false;
     }
 
     // Go to the beginning of local file section
-    fseek ( zip_file->file, zip_entry->file_header.relative_offset_of_local_header, SEEK_SET );
-    fread ( &tmp_file_header, 1, sizeof ( qzip_local_file_header_t ), zip_file->file );
-    fseek ( zip_file->file, tmp_file_header.filename_length, SEEK_CUR ); // skip
-    fseek ( zip_file->file, tmp_file_header.extra_field_length, SEEK_CUR ); // skip
+    position = zip_entry->file_header.relative_offset_of_local_header;
+    if ( position + ( long ) sizeof ( qzip_local_file_header_t ) > zip_file->file_size )
+    {
+        return false;
+    }
+
+    memcpy ( &tmp_file_header, zip_file->map + position, sizeof ( qzip_local_file_header_t ) );
+    position += sizeof ( qzip_local_file_header_t );
+    position += tmp_file_header.filename_length; // skip
+    position += tmp_file_header.extra_field_length; // skip
+
+    if ( position + ( long ) zip_entry->file_header.compressed_size > zip_file->file_size )
+    {
+        printf ( "Truncated entry %s\n", zip_entry->file_name );
+        return false;
+    }
 
-    zip_entry->compressed_data_position = ftell ( zip_file->file );
+    zip_entry->compressed_data_position = position;
 
     return true;
 }
@@ -196,6 +217,17 @@ qzip_entry_t* qzip_open_entry ( qzip_file_t* zip_file, const char* filename, uin
             printf ( "CRC does not match : %d vs provided %d\n", zip_entry->file_header.crc32, file_crc );
         }
 
+        zip_entry->data = ( uint8_t* ) zip_file->map + zip_entry->compressed_data_position;
+        zip_entry->readed = 0;
+
+#ifdef MADV_WILLNEED
+        // Start reading the whole entry ahead, the pages are then mostly in memory once needed
+        long page = sysconf ( _SC_PAGESIZE );
+        long start = zip_entry->compressed_data_position & ~ ( page - 1 );
+
+        madvise ( zip_file->map + start, zip_entry->compressed_data_position + zip_entry->file_header.compressed_size - start, MADV_WILLNEED );
+#endif
+
         if ( zip_entry->file_header.compression_method == 8 )
         {
             zip_entry->zlib_stream = calloc ( 1, sizeof ( z_stream ) );
@@ -206,24 +238,23 @@ qzip_entry_t* qzip_open_entry ( qzip_file_t* zip_file, const char* filename, uin
                 return NULL;
             }
 
-            zip_entry->inbuf = zip_file->map + zip_entry->compressed_data_position;
-
             zip_entry->zlib_stream->avail_in = zip_entry->file_header.compressed_size;
-            zip_entry->zlib_stream->next_in = zip_entry->inbuf;
+            zip_entry->zlib_stream->next_in = zip_entry->data;
 
             if ( inflateInit2 ( zip_entry->zlib_stream, -MAX_WBITS ) != Z_OK )
             {
                 printf ( "Error initializing decompression\n" );
+                free ( zip_entry->zlib_stream );
+                free ( zip_entry );
                 return NULL;
             }
         }
 
-        zip_entry->readed = 0;
-        zip_entry->file_io = zip_file->file;
-
         return zip_entry;
     }
 
+    free ( zip_entry );
+
     return NULL;
 }
 /**
@@ -237,7 +268,7 @@ qzip_entry_t* qzip_open_entry ( qzip_file_t* zip_file, const char* filename, uin
 bool qzip_seek_entry ( qzip_entry_t* zip_entry, uint32_t offset )
 {
     uint8_t* buf = NULL;
-    uint32_t s = 4096, c = 0;
+    uint32_t s = 4096, c = 0, skipped = offset;
 
     if ( zip_entry == NULL )
     {
@@ -245,6 +276,13 @@ bool qzip_seek_entry ( qzip_entry_t* zip_entry, uint32_t offset )
         return false;
     }
 
+    // Stored data is in the mapping, nothing to read, but the entry must be long enough
+    if ( zip_entry->file_header.compression_method != 8 )
+    {
+        qzip_map_entry ( zip_entry, &skipped );
+        return ( skipped == offset );
+    }
+
     buf = ( uint8_t* ) calloc ( 1, s );
     if ( buf == NULL )
     {
@@ -286,7 +324,6 @@ bool qzip_seek_entry ( qzip_entry_t* zip_entry, uint32_t offset )
 int32_t qzip_read_entry ( qzip_entry_t* zip_entry, uint8_t* data, uint32_t size )
 {
     int32_t readed = 0;
-    int32_t todo = 0;
     int32_t ret = 0;
 
     if ( zip_entry == NULL )
@@ -329,19 +366,58 @@ int32_t qzip_read_entry ( qzip_entry_t* zip_entry, uint8_t* data, uint32_t size
     }
     else     /* Stored */
     {
-        todo = ( zip_entry->readed - zip_entry->file_header.uncompressed_size );
+        const uint8_t* stored = qzip_map_entry ( zip_entry, &size );
 
-        if ( todo < size )
+        if ( stored != NULL )
         {
-            todo = size;
+            memcpy ( data, stored, size );
         }
 
-        readed = fread ( data, 1, size, zip_entry->file_io );
-        zip_entry->readed += readed;
+        readed = size;
     }
 
     return readed;
 }
+/**
+ * Gives the next bytes of a stored entry, straight from the file mapping.
+ *
+ * @param zip_entry stored entry
+ * @param size bytes wanted, then bytes given, less at the end of the entry
+ *
+ * @return first byte given, NULL at the end of the entry or when the entry is compressed
+ *
+ */
+const uint8_t* qzip_map_entry ( qzip_entry_t* zip_entry, uint32_t* size )
+{
+    const uint8_t* stored = NULL;
+    uint32_t todo = 0;
+
+    if ( zip_entry == NULL || zip_entry->file_header.compression_method == 8 )
+    {
+        errno = EINVAL;
+        *size = 0;
+        return NULL;
+    }
+
+    todo = zip_entry->file_header.uncompressed_size - zip_entry->readed;
+
+    if ( todo > *size )
+    {
+        todo = *size;
+    }
+
+    *size = todo;
+
+    if ( todo == 0 )
+    {
+        return NULL;
+    }
+
+    stored = zip_entry->data + zip_entry->readed;
+    zip_entry->readed += todo;
+
+    return stored;
+}
 /**
  * ????.
  *
@@ -423,12 +499,13 @@ bool qzip_close_entry ( qzip_entry_t* zip_entry )
 qzip_file_t* qzip_open_file ( const char* filename )
 {
     qzip_file_t* zip_file = NULL;
+    FILE* file = NULL;
     struct stat sb;
 
     if ( filename == NULL )
     {
         errno = EINVAL;
-        return;
+        return NULL;
     }
 
 #ifdef __linux__
@@ -460,8 +537,8 @@ qzip_file_t* qzip_open_file ( const char* filename )
 
     strcpy ( zip_file->file_name, filename );
 
-    zip_file->file = fopen ( zip_file->file_name, "rb" );
-    if ( zip_file->file == NULL )
+    file = fopen ( zip_file->file_name, "rb" );
+    if ( file == NULL )
     {
         printf ( "Could not open file %s\n", zip_file->file_name );
         free ( zip_file );
@@ -469,10 +546,13 @@ qzip_file_t* qzip_open_file ( const char* filename )
         return NULL;
     }
 
-    fseek ( zip_file->file, 0, SEEK_END );
-    zip_file->file_size = ftell ( zip_file->file );
+    fseek ( file, 0, SEEK_END );
+    zip_file->file_size = ftell ( file );
+
+    // Everything is read from the mapping, it stays valid once the file is closed
+    zip_file->map = mmap ( 0, zip_file->file_size, PROT_READ, MAP_SHARED, fileno ( file ), 0 );
+    fclose ( file );
 
-    zip_file->map = mmap ( 0, zip_file->file_size, PROT_READ, MAP_SHARED, fileno ( zip_file->file ), 0 );
     if ( zip_file->map == MAP_FAILED )
     {
         printf ( "Could not map file %s\n", zip_file->file_name );
@@ -484,7 +564,7 @@ qzip_file_t* qzip_open_file ( const char* filename )
     if ( search_eof_central_dir ( zip_file ) == false )
     {
         printf ( "Strange %s\n", zip_file->file_name );
-        fclose ( zip_file->file );
+        munmap ( zip_file->map, zip_file->file_size );
         free ( zip_file );
         return NULL;
     }
@@ -509,7 +589,6 @@ bool qzip_close_file ( qzip_file_t* zip_file )
         return false;
     }
 
-    fclose ( zip_file->file );
     free ( zip_file );
 
     return true;
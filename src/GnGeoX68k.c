@@ -1019,12 +1019,21 @@ static void mem68k_store_pal_byte ( Uint32 address, Uint8 data )
 
         if ( ( address >> 1 ) & 0xF )
         {
-            current_pc_pal[ ( address ) >> 1] = convert_pal ( a );
+            current_pc_pal[ ( address ) >> 1] = PAL_CONVERT ( a );
         }
         else
         {
             current_pc_pal[ ( address ) >> 1] = 0xF81F;
         }
+
+        neogeo_video_generation++;
+        neogeo_palette_generation++;
+
+        /* Fix layer only uses the 16 first palettes */
+        if ( ( address >> 1 ) < 0x100 )
+        {
+            invalidate_fix_layer();
+        }
     }
     else
     {
@@ -1049,12 +1058,21 @@ static void mem68k_store_pal_word ( Uint32 address, Uint16 data )
 
         if ( ( address >> 1 ) & 0xF )
         {
-            current_pc_pal[ ( address ) >> 1] = convert_pal ( data );
+            current_pc_pal[ ( address ) >> 1] = PAL_CONVERT ( data );
         }
         else
         {
             current_pc_pal[ ( address ) >> 1] = 0xF81F;
         }
+
+        neogeo_video_generation++;
+        neogeo_palette_generation++;
+
+        /* Fix layer only uses the 16 first palettes */
+        if ( ( address >> 1 ) < 0x100 )
+        {
+            invalidate_fix_layer();
+        }
     }
     else
     {
@@ -1110,6 +1128,9 @@ static void mem68k_store_video_word ( Uint32 address, Uint16 data )
     case ( REG_VRAMRW ) :
         {
             WRITE_WORD ( &neogeo_memory.vid.ram[neogeo_memory.vid.vptr << 1], data );
+            invalidate_sprite_table ( neogeo_memory.vid.vptr );
+            invalidate_fix_cell ( neogeo_memory.vid.vptr );
+            neogeo_video_generation++;
             neogeo_memory.vid.vptr = ( neogeo_memory.vid.vptr & 0x8000 ) + ( ( neogeo_memory.vid.vptr
                                      + neogeo_memory.vid.modulo ) & 0x7fff );
             neogeo_memory.vid.rbuf = READ_WORD ( &neogeo_memory.vid.ram[neogeo_memory.vid.vptr << 1] );
@@ -1132,6 +1153,7 @@ static void mem68k_store_video_word ( Uint32 address, Uint16 data )
     case ( REG_LSPCMODE ) :
         {
             write_neo_control ( data );
+            neogeo_video_generation++;
         }
         break;
     case ( REG_TIMERHIGH ) :
@@ -1367,6 +1389,8 @@ static void mem68k_store_setting_byte ( Uint32 address, Uint8 data )
             current_fix = neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_BIOS].p;
             fix_usage = neogeo_memory.fix_board_usage;
             neogeo_memory.vid.currentfix = 0;
+            neogeo_video_generation++;
+            invalidate_fix_layer();
         }
         break;
     /* select game fix */
@@ -1375,6 +1399,8 @@ static void mem68k_store_setting_byte ( Uint32 address, Uint8 data )
             current_fix = neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].p;
             fix_usage = neogeo_memory.fix_game_usage;
             neogeo_memory.vid.currentfix = 1;
+            neogeo_video_generation++;
+            invalidate_fix_layer();
         }
         break;
     /* sram lock */
@@ -1395,6 +1421,9 @@ static void mem68k_store_setting_byte ( Uint32 address, Uint8 data )
             current_pal = neogeo_memory.vid.pal_neo[1];
             current_pc_pal = ( Uint32* ) neogeo_memory.vid.pal_host[1];
             neogeo_memory.vid.currentpal = 1;
+            neogeo_video_generation++;
+            neogeo_palette_generation++;
+            invalidate_fix_layer();
         }
         break;
     /* set palette 1 */
@@ -1403,6 +1432,9 @@ static void mem68k_store_setting_byte ( Uint32 address, Uint8 data )
             current_pal = neogeo_memory.vid.pal_neo[0];
             current_pc_pal = ( Uint32* ) neogeo_memory.vid.pal_host[0];
             neogeo_memory.vid.currentpal = 0;
+            neogeo_video_generation++;
+            neogeo_palette_generation++;
+            invalidate_fix_layer();
         }
         break;
     default:
@@ -145,6 +145,14 @@ SDL_bool neo_config_init ( char* filename )
 
     gngeox_config.transpack = qlisttbl_getint ( tbl, "graphics.transpack" );
 
+    gngeox_config.gamma = qlisttbl_getint ( tbl, "graphics.gamma" );
+
+    gngeox_config.indexed = qlisttbl_getint ( tbl, "graphics.indexed" );
+
+    gngeox_config.linebuffer = qlisttbl_getint ( tbl, "graphics.linebuffer" );
+
+    gngeox_config.dedup = qlisttbl_getint ( tbl, "graphics.dedup" );
+
     gngeox_config.forcepal = qlisttbl_getint ( tbl, "system.forcepal" );
 
     gngeox_config.country = qlisttbl_getint ( tbl, "system.country" );
@@ -185,6 +193,16 @@ SDL_bool neo_config_init ( char* filename )
 
     gngeox_config.samplerate = qlisttbl_getint ( tbl, "system.samplerate" );
 
+    gngeox_config.ym2610rate = qlisttbl_getint ( tbl, "system.ym2610rate" );
+
+    gngeox_config.soundbench = qlisttbl_getint ( tbl, "system.soundbench" );
+
+    gngeox_config.soundlog = qlisttbl_getint ( tbl, "system.soundlog" );
+
+    gngeox_config.loadbench = qlisttbl_getint ( tbl, "system.loadbench" );
+
+    gngeox_config.nosound = qlisttbl_getint ( tbl, "system.nosound" );
+
     gngeox_config.debug = qlisttbl_getint ( tbl, "system.debug" );
 
     gngeox_config.dump = qlisttbl_getint ( tbl, "system.dump" );
@@ -226,6 +244,11 @@ SDL_bool neo_config_parse_options ( int *argc, char ***argv )
         {"country", 'n', OPTTYPE_UINT, &gngeox_config.country},
         {"systemtype", 'm', OPTTYPE_UINT, &gngeox_config.systemtype},
         {"samplerate", 'l', OPTTYPE_UINT, &gngeox_config.samplerate},
+        {"ym2610rate", 'o', OPTTYPE_UINT, &gngeox_config.ym2610rate},
+        {"soundbench", 'q', OPTTYPE_BOOL, &gngeox_config.soundbench},
+        {"soundlog", 't', OPTTYPE_BOOL, &gngeox_config.soundlog},
+        {"loadbench", 'z', OPTTYPE_BOOL, &gngeox_config.loadbench},
+        {"nosound", 'w', OPTTYPE_BOOL, &gngeox_config.nosound},
         {"debug", 'g', OPTTYPE_BOOL, &gngeox_config.debug},
         {"dump", 'p', OPTTYPE_BOOL, &gngeox_config.dump},
         {"joystick", 'j', OPTTYPE_BOOL, &gngeox_config.joystick},
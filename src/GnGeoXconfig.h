@@ -53,9 +53,18 @@ typedef struct
     SDL_bool raster;
     SDL_bool forcepal;
     SDL_bool transpack;
+    Uint16 gamma;
+    SDL_bool indexed;
+    SDL_bool linebuffer;
+    SDL_bool dedup;
     Uint16 country;
     Uint16 systemtype;
     Uint16 samplerate;
+    Uint32 ym2610rate;
+    SDL_bool soundbench;
+    SDL_bool soundlog;
+    SDL_bool loadbench;
+    SDL_bool nosound;
     SDL_bool debug;
     SDL_bool dump;
     /* @todo (Tmesys#1#10/04/2024): Not implemented. */
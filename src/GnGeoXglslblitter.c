@@ -36,6 +36,8 @@
 
 #include "GnGeoXscreen.h"
 #include "GnGeoXvideo.h"
+#include "GnGeoXroms.h"
+#include "GnGeoXmemory.h"
 #include "GnGeoXscale.h"
 #include "GnGeoXscanline.h"
 #include "GnGeoXconfig.h"
@@ -66,6 +68,65 @@ static GLuint input_tex;
 /// Number of frames to clear after resize, for double buffer
 Sint32 clear_after_resize;
 
+/*
+ * Palette lookup pass, fills the input texture from palette indexes
+ */
+
+/// Palette indexes of the viewport, packed rows
+static Uint16* input_index;
+/// The palette indexes texture, low byte then high byte
+static GLuint index_tex;
+/// The current palette, 64x64 colors
+static GLuint palette_tex;
+/// Framebuffer drawing into the input texture
+static GLuint input_framebuffer;
+/// The palette lookup program
+static GLuint palette_program;
+/// Palette generation of the palette texture
+static Uint32 palette_generation;
+static SDL_bool palette_uploaded = SDL_FALSE;
+
+static const char palette_shader[] =
+    "#if defined(VERTEX)\n"
+    "#if __VERSION__ >= 130\n"
+    "#define IN in\n"
+    "#define OUT out\n"
+    "#else\n"
+    "#define IN attribute\n"
+    "#define OUT varying\n"
+    "#endif\n"
+    "uniform mat4 MVPMatrix;\n"
+    "IN vec2 VertexCoord;\n"
+    "IN vec2 TexCoord;\n"
+    "OUT vec2 v_tex_coord;\n"
+    "void main() {\n"
+    "    gl_Position = MVPMatrix * vec4(VertexCoord, 0.0, 1.0);\n"
+    "    v_tex_coord = TexCoord;\n"
+    "}\n"
+    "#elif defined(FRAGMENT)\n"
+    "#ifdef GL_ES\n"
+    "precision highp float;\n"
+    "#endif\n"
+    "#if __VERSION__ >= 130\n"
+    "#define IN in\n"
+    "#define tex2D texture\n"
+    "out vec4 FragColor;\n"
+    "#else\n"
+    "#define IN varying\n"
+    "#define FragColor gl_FragColor\n"
+    "#define tex2D texture2D\n"
+    "#endif\n"
+    "uniform sampler2D Texture;\n"
+    "uniform sampler2D Palette;\n"
+    "IN vec2 v_tex_coord;\n"
+    "void main() {\n"
+    "    vec4 texel = tex2D(Texture, v_tex_coord);\n"
+    "    float index = floor(texel.r * 255.0 + 0.5) + floor(texel." INDEX_TEXTURE_HIGH " * 255.0 + 0.5) * 256.0;\n"
+    "    vec2 entry = vec2(mod(index, 64.0), floor(index / 64.0));\n"
+    "    FragColor = vec4(tex2D(Palette, (entry + 0.5) / 64.0).rgb, 1.0);\n"
+    "}\n"
+    "#endif\n";
+
 #ifdef USE_GL2
 /// The vertex array object required for rendering with OpenGL
 static GLuint vao;
@@ -170,28 +231,42 @@ static GLuint compile_shader ( const char* shader_name, GLenum shader_type )
     //char* shader_path = NULL;
     char* full_name = NULL;
     char* src = NULL;
-    GLuint shader = 0;
     char* type_name = NULL;
     Sint32 buflen = 0;
-    Sint32 status = 0;
 
     buflen = strlen ( gngeox_config.shaderpath ) + strlen ( shader_name ) + 2;
     full_name = qalloc ( buflen );
     snprintf ( full_name, buflen, "%s/%s", gngeox_config.shaderpath, shader_name );
 
     type_name = shader_type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT";
-    shader = glCreateShader ( shader_type );
+    src = load_file_and_wrap ( full_name, type_name );
 
-    if ( shader == 0 )
+    if ( src == NULL )
     {
-        printf ( "Could not create a %s shader object\n", type_name );
         return ( GL_FALSE );
     }
 
-    src = load_file_and_wrap ( full_name, type_name );
+    return ( compile_shader_source ( src, shader_type ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Compiles a shader script.
+*
+* \param src Shader script, already wrapped.
+* \param shader_type Can be GL_VERTEX_SHADER or GL_FRAGMENT_SHADER.
+* \return Shader, GL_FALSE when error.
+*/
+/* ******************************************************************************************************************/
+static GLuint compile_shader_source ( const char* src, GLenum shader_type )
+{
+    GLuint shader = 0;
+    Sint32 status = 0;
 
-    if ( src == NULL )
+    shader = glCreateShader ( shader_type );
+
+    if ( shader == 0 )
     {
+        printf ( "Could not create a %s shader object\n", shader_type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT" );
         return ( GL_FALSE );
     }
 
@@ -225,7 +300,6 @@ static GLuint compile_shader ( const char* shader_name, GLenum shader_type )
 static GLuint compile_shader_program ( char* shader_name )
 {
     GLuint vertex = 0, fragment = 0, program = 0;
-    Sint32 linked = 0;
 
     vertex = compile_shader ( shader_name, GL_VERTEX_SHADER );
 
@@ -241,6 +315,31 @@ static GLuint compile_shader_program ( char* shader_name )
         return ( GL_FALSE );
     }
 
+    program = link_shader_program ( vertex, fragment );
+
+    if ( program == GL_FALSE )
+    {
+        return ( GL_FALSE );
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Linked shader program: %s", shader_name );
+
+    return ( program );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Links a vertex and a fragment shader.
+*
+* \param vertex Vertex shader.
+* \param fragment Fragment shader.
+* \return Shader program, GL_FALSE when error.
+*/
+/* ******************************************************************************************************************/
+static GLuint link_shader_program ( GLuint vertex, GLuint fragment )
+{
+    GLuint program = 0;
+    Sint32 linked = 0;
+
     program = glCreateProgram();
     glAttachShader ( program, vertex );
     glAttachShader ( program, fragment );
@@ -256,14 +355,13 @@ static GLuint compile_shader_program ( char* shader_name )
         glGetProgramInfoLog ( program, length, &length, log );
         printf ( "Error when linking shader:\n%s\n", log );
         qalloc_delete ( log );
-        return ( SDL_FALSE );
+        return ( GL_FALSE );
     }
 
     // GLuint attr;
     // GLuint uni;
     // glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &attr);
     // glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uni);
-    zlog_info ( gngeox_config.loggingCat, "Linked shader program: %s", shader_name );
 
     return ( program );
 }
@@ -689,6 +787,172 @@ static void render_pass ( Sint32 orig_width, Sint32 orig_height, GLuint src_text
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Compiles the palette lookup program.
+*
+* \return Shader program, GL_FALSE when error.
+*/
+/* ******************************************************************************************************************/
+static GLuint compile_palette_program ( void )
+{
+    char src[SHADER_TAG_LEN + sizeof ( palette_shader )];
+    GLuint vertex = 0, fragment = 0, program = 0;
+
+    snprintf ( src, sizeof ( src ), "#version 100\n#define VERTEX 1\n%s", palette_shader );
+    vertex = compile_shader_source ( src, GL_VERTEX_SHADER );
+
+    if ( vertex == GL_FALSE )
+    {
+        return ( GL_FALSE );
+    }
+
+    snprintf ( src, sizeof ( src ), "#version 100\n#define FRAGMENT 1\n%s", palette_shader );
+    fragment = compile_shader_source ( src, GL_FRAGMENT_SHADER );
+
+    if ( fragment == GL_FALSE )
+    {
+        return ( GL_FALSE );
+    }
+
+    program = link_shader_program ( vertex, fragment );
+
+    if ( program == GL_FALSE )
+    {
+        return ( GL_FALSE );
+    }
+
+    glUseProgram ( program );
+    glUniform1i ( glGetUniformLocation ( program, "Texture" ), 0 );
+    glUniform1i ( glGetUniformLocation ( program, "Palette" ), 1 );
+
+    return ( program );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Sets the palette lookup pass up, so frames drawn in indexed mode are colored on the gpu.
+*
+* \return SDL_FALSE when the pass is not available, SDL_TRUE otherwise.
+* \note   Without it, the colors are converted by the video code as before.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool init_palette_lookup ( void )
+{
+    palette_program = compile_palette_program();
+
+    if ( palette_program == GL_FALSE )
+    {
+        palette_program = 0;
+        return ( SDL_FALSE );
+    }
+
+    index_tex = create_input_texture();
+    palette_tex = create_input_texture();
+
+    // The input texture gets its storage now, the lookup pass draws into it
+    glBindTexture ( GL_TEXTURE_2D, input_tex );
+    glTexImage2D ( GL_TEXTURE_2D, 0, GL_RGBA, screen_rect.w, screen_rect.h,
+                   0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+
+    glGenFramebuffers ( 1, &input_framebuffer );
+    glBindFramebuffer ( GL_FRAMEBUFFER, input_framebuffer );
+    glFramebufferTexture2D ( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, input_tex, 0 );
+
+    if ( glCheckFramebufferStatus ( GL_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
+    {
+        glBindFramebuffer ( GL_FRAMEBUFFER, 0 );
+        free_palette_lookup();
+        return ( SDL_FALSE );
+    }
+
+    glBindFramebuffer ( GL_FRAMEBUFFER, 0 );
+
+    input_index = qalloc ( screen_rect.w * screen_rect.h * sizeof ( Uint16 ) );
+    if ( input_index == NULL )
+    {
+        free_palette_lookup();
+        return ( SDL_FALSE );
+    }
+
+    palette_uploaded = SDL_FALSE;
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Deletes the palette lookup pass objects.
+*
+*/
+/* ******************************************************************************************************************/
+static void free_palette_lookup ( void )
+{
+    if ( input_framebuffer != 0 )
+    {
+        glDeleteFramebuffers ( 1, &input_framebuffer );
+        input_framebuffer = 0;
+    }
+
+    if ( index_tex != 0 )
+    {
+        glDeleteTextures ( 1, &index_tex );
+        index_tex = 0;
+    }
+
+    if ( palette_tex != 0 )
+    {
+        glDeleteTextures ( 1, &palette_tex );
+        palette_tex = 0;
+    }
+
+    if ( palette_program != 0 )
+    {
+        glDeleteProgram ( palette_program );
+        palette_program = 0;
+    }
+
+    if ( input_index != NULL )
+    {
+        qalloc_delete ( input_index );
+        input_index = NULL;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Fills the input texture from the palette indexes of the last frame.
+*
+* \param viewport_rect Viewport in the video buffer.
+* \note   The palette is only uploaded again when it has changed since the last time.
+*/
+/* ******************************************************************************************************************/
+static void palette_lookup ( const SDL_Rect* viewport_rect )
+{
+    for ( Sint32 line = 0; line < screen_rect.h; line++ )
+    {
+        memcpy ( &input_index[line * screen_rect.w],
+                 &neogeo_video_index[ ( viewport_rect->y + line ) * INDEX_BUFFER_WIDTH + viewport_rect->x],
+                 screen_rect.w * sizeof ( Uint16 ) );
+    }
+
+    glActiveTexture ( GL_TEXTURE1 );
+    glBindTexture ( GL_TEXTURE_2D, palette_tex );
+
+    if ( ( palette_uploaded == SDL_FALSE ) || ( palette_generation != neogeo_palette_generation ) )
+    {
+        glTexImage2D ( GL_TEXTURE_2D, 0, GL_RGBA, 64, 64, 0, GL_BGRA, GL_UNSIGNED_BYTE, current_pc_pal );
+        palette_generation = neogeo_palette_generation;
+        palette_uploaded = SDL_TRUE;
+    }
+
+    glActiveTexture ( GL_TEXTURE0 );
+    glBindTexture ( GL_TEXTURE_2D, index_tex );
+    glTexImage2D ( GL_TEXTURE_2D, 0, INDEX_TEXTURE_INTERNAL, screen_rect.w, screen_rect.h,
+                   0, INDEX_TEXTURE_FORMAT, GL_UNSIGNED_BYTE, input_index );
+
+    render_pass ( screen_rect.w, screen_rect.h,
+                  index_tex, screen_rect.w, screen_rect.h,
+                  input_framebuffer, screen_rect.w, screen_rect.h,
+                  palette_program );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Initializes Glsl blitter.
 *
 * \return SDL_FALSE when error, SDL_TRUE otherwise.
@@ -767,6 +1031,16 @@ SDL_bool blitter_glsl_init ( void )
         return SDL_FALSE;
     }
 
+    if ( gngeox_config.indexed == SDL_TRUE )
+    {
+        neogeo_video_palette_blitter = init_palette_lookup();
+
+        if ( neogeo_video_palette_blitter == SDL_FALSE )
+        {
+            zlog_warn ( gngeox_config.loggingCat, "Palette lookup pass not available, colors are converted by the cpu" );
+        }
+    }
+
     SDL_ShowWindow ( sdl_window );
 
     return ( SDL_TRUE );
@@ -825,8 +1099,32 @@ void blitter_glsl_update ( void )
     SDL_Rect viewport_rect = screen_rect;
     viewport_rect.x += visible_area.x;
     viewport_rect.y += visible_area.y;
-    SDL_BlitSurface ( sdl_surface_buffer, &viewport_rect, input_pixels, NULL );
 
+    // A frame drawn in indexed mode only has palette indexes, the first pass looks them up
+    if ( neogeo_video_index_only == SDL_TRUE )
+    {
+        palette_lookup ( &viewport_rect );
+    }
+    else
+    {
+        SDL_BlitSurface ( sdl_surface_buffer, &viewport_rect, input_pixels, NULL );
+
+        glActiveTexture ( GL_TEXTURE0 );
+        glBindTexture ( GL_TEXTURE_2D, input_tex );
+        glTexImage2D ( GL_TEXTURE_2D, 0, GL_RGBA, screen_rect.w, screen_rect.h,
+                       0, GL_BGRA, GL_UNSIGNED_BYTE, input_pixels->pixels );
+    }
+
+    blitter_glsl_present();
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Runs the shader passes again on the last uploaded input texture.
+*
+*/
+/* ******************************************************************************************************************/
+void blitter_glsl_present ( void )
+{
     if ( clear_after_resize > 0 )
     {
         glBindFramebuffer ( GL_FRAMEBUFFER, 0 );
@@ -835,11 +1133,6 @@ void blitter_glsl_update ( void )
         clear_after_resize--;
     }
 
-    glActiveTexture ( GL_TEXTURE0 );
-    glBindTexture ( GL_TEXTURE_2D, input_tex );
-    glTexImage2D ( GL_TEXTURE_2D, 0, GL_RGBA, screen_rect.w, screen_rect.h,
-                   0, GL_BGRA, GL_UNSIGNED_BYTE, input_pixels->pixels );
-
     // render: TEX -> (pass1_prog) -> FBO -> ... -> (pass2_prog) -> OUTPUT
     for ( Sint32 i = 0; i < nb_passes; i++ )
     {
@@ -862,6 +1155,9 @@ void blitter_glsl_close ( void )
 {
     //if (sdl_surface_screen != NULL)
     //  SDL_FreeSurface(sdl_surface_screen);
+
+    free_palette_lookup();
+    neogeo_video_palette_blitter = SDL_FALSE;
 }
 /* ******************************************************************************************************************/
 /*!
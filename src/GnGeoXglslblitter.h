@@ -26,6 +26,19 @@
 
 #define SHADER_TAG_LEN 200
 
+/*
+ * Palette indexes texture, two bytes per pixel, read back as palette * 16 + pen by the lookup pass
+ */
+#ifdef USE_GL2
+#define INDEX_TEXTURE_INTERNAL GL_RG8
+#define INDEX_TEXTURE_FORMAT   GL_RG
+#define INDEX_TEXTURE_HIGH     "g"
+#else
+#define INDEX_TEXTURE_INTERNAL GL_LUMINANCE_ALPHA
+#define INDEX_TEXTURE_FORMAT   GL_LUMINANCE_ALPHA
+#define INDEX_TEXTURE_HIGH     "a"
+#endif
+
 #define GLSLP_SHADER        "shader"
 #define GLSLP_SCALE_TYPE_X  "scale_type_x"
 #define GLSLP_SCALE_TYPE_Y  "scale_type_y"
@@ -106,7 +119,13 @@ typedef struct _pass_
 #ifdef _GNGEOX_GLSLBLITTER_C_
 static char* load_file_and_wrap ( const char*, const char* );
 static GLuint compile_shader ( const char*, GLenum );
+static GLuint compile_shader_source ( const char*, GLenum );
 static GLuint compile_shader_program ( char* );
+static GLuint link_shader_program ( GLuint, GLuint );
+static GLuint compile_palette_program ( void );
+static SDL_bool init_palette_lookup ( void );
+static void free_palette_lookup ( void );
+static void palette_lookup ( const SDL_Rect* );
 static void set_texture_filter_linear ( GLuint, Sint32 );
 static GLuint create_input_texture ( void );
 static void create_pass_framebuffer ( GLuint*, GLuint* );
@@ -120,6 +139,7 @@ static void render_pass ( Sint32, Sint32, GLuint, Sint32, Sint32, GLuint, Sint32
 SDL_bool blitter_glsl_init ( void ) __attribute__ ( ( warn_unused_result ) );
 SDL_bool blitter_glsl_resize ( Sint32, Sint32 ) __attribute__ ( ( warn_unused_result ) );
 void blitter_glsl_update ( void );
+void blitter_glsl_present ( void );
 void blitter_glsl_close ( void );
 void blitter_glsl_fullscreen ( void );
 
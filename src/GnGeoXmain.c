@@ -43,6 +43,7 @@
 #include "GnGeoXframecap.h"
 #include "GnGeoXconfig.h"
 #include "GnGeoXromsgno.h"
+#include "GnGeoXworkers.h"
 
 Sint32 main ( Sint32 argc, char* argv[] )
 {
@@ -97,6 +98,12 @@ Sint32 main ( Sint32 argc, char* argv[] )
     }
     zlog_info ( gngeox_config.loggingCat, "SDL initialization OK" );
 
+    if ( neo_workers_init() == SDL_FALSE )
+    {
+        exit ( EXIT_FAILURE );
+    }
+    atexit ( neo_workers_close );
+
     if ( neo_controllers_init() == SDL_FALSE )
     {
         exit ( EXIT_FAILURE );
@@ -104,6 +111,13 @@ Sint32 main ( Sint32 argc, char* argv[] )
     atexit ( neo_controllers_close );
     zlog_info ( gngeox_config.loggingCat, "Controllers initialization OK" );
 
+    /* If asked, benchmark rom files loading and exit, before the game regions are allocated */
+    if ( gngeox_config.loadbench == SDL_TRUE )
+    {
+        benchmark_roms_load();
+        exit ( EXIT_SUCCESS );
+    }
+
     if ( init_game ( gngeox_config.gamename ) == SDL_FALSE )
     {
         zlog_error ( gngeox_config.loggingCat, "Can't init %s", gngeox_config.gamename );
@@ -121,6 +135,14 @@ Sint32 main ( Sint32 argc, char* argv[] )
         exit ( EXIT_SUCCESS );
     }
 
+    /* If asked, benchmark YM2610 synthesis and exit */
+    if ( gngeox_config.soundbench == SDL_TRUE )
+    {
+        neo_sound_benchmark();
+        close_game();
+        exit ( EXIT_SUCCESS );
+    }
+
     neo_frame_cap_init();
     atexit ( neo_frame_cap_close );
 
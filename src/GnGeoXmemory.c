@@ -17,6 +17,7 @@
 #define _GNGEOX_MEMORY_C_
 #endif // _GNGEOX_MEMORY_C_
 
+#include <math.h>
 #include <SDL2/SDL.h>
 #include "zlog.h"
 #include "qlibc.h"
@@ -41,6 +42,8 @@ Uint8* current_pal = NULL;
 Uint32* current_pc_pal = NULL;
 Uint8* current_fix = NULL;
 Uint8* fix_usage = NULL;
+/* Every Neo Geo color converted to the host format */
+Uint32 neo_pal_table[65536];
 SDL_bool sram_lock = SDL_FALSE;
 
 /* @note (Tmesys#1#12/04/2022): This one is heavily used in neoboot but commented. */
@@ -79,9 +82,11 @@ void write_irq2pos ( Uint32 data )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief Todo.
+* \brief Converts a Neo Geo color to RGB24.
 *
-* \param npal Todo.
+* \param npal Neo Geo color (dark bit, 5 bits per component plus a shared low bit).
+* \return RGB24 color.
+* \note  Reference conversion, palette writes use neo_pal_table instead.
 */
 /* ******************************************************************************************************************/
 Uint32 convert_pal ( Uint16 npal )
@@ -100,7 +105,51 @@ Uint32 convert_pal ( Uint16 npal )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief Todo.
+* \brief Builds the Neo Geo color conversion table.
+*
+* \param format Host color format, the surfaces and blitters only take RGB24 for now.
+* \param gamma Gamma correction in hundredths, 0 or 100 for none.
+* \note  The format and the gamma cost nothing per palette write, they are only applied here.
+*/
+/* ******************************************************************************************************************/
+void neo_pal_table_init ( enum_gngeoxmemory_pal_format format, Uint16 gamma )
+{
+    Uint8 level[256];
+
+    for ( Sint32 i = 0; i < 256; i++ )
+    {
+        if ( ( gamma == 0 ) || ( gamma == 100 ) )
+        {
+            level[i] = i;
+        }
+        else
+        {
+            level[i] = ( Uint8 ) ( pow ( i / 255.0, 100.0 / gamma ) * 255.0 + 0.5 );
+        }
+    }
+
+    for ( Sint32 npal = 0; npal < 65536; npal++ )
+    {
+        Uint32 rgb = convert_pal ( npal );
+        Uint32 r = level[COLOR_RGB24_R ( rgb )];
+        Uint32 g = level[COLOR_RGB24_G ( rgb )];
+        Uint32 b = level[COLOR_RGB24_B ( rgb )];
+
+        switch ( format )
+        {
+        case ( PAL_FORMAT_RGB24 ) :
+        case ( PAL_FORMAT_MAX ) :
+        default :
+            {
+                neo_pal_table[npal] = ( r << 16 ) | ( g << 8 ) | b;
+            }
+            break;
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Converts again both palette banks.
 *
 */
 /* ******************************************************************************************************************/
@@ -114,9 +163,13 @@ void update_all_pal ( void )
     {
         //pc_pal1[i] = convert_pal(READ_WORD_ROM(&memory.pal1[i<<1]));
         //pc_pal2[i] = convert_pal(READ_WORD_ROM(&memory.pal2[i<<1]));
-        pc_pal1[i] = convert_pal ( READ_WORD ( &neogeo_memory.vid.pal_neo[0][i << 1] ) );
-        pc_pal2[i] = convert_pal ( READ_WORD ( &neogeo_memory.vid.pal_neo[1][i << 1] ) );
+        pc_pal1[i] = PAL_CONVERT ( READ_WORD ( &neogeo_memory.vid.pal_neo[0][i << 1] ) );
+        pc_pal2[i] = PAL_CONVERT ( READ_WORD ( &neogeo_memory.vid.pal_neo[1][i << 1] ) );
     }
+
+    neogeo_video_generation++;
+    neogeo_palette_generation++;
+    invalidate_fix_layer();
 }
 /* ******************************************************************************************************************/
 /*!
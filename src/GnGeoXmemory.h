@@ -26,6 +26,9 @@
 #define SWAP16(y) SDL_Swap16(y)
 #define SWAP32(y) SDL_Swap32(y)
 
+/* Neo Geo 16 bits color to host color, through the table built by neo_pal_table_init() */
+#define PAL_CONVERT(_X_) ( neo_pal_table[( Uint16 ) ( _X_ )] )
+
 /* Since the JEIDA data bus is 16-bits wide, make sure to double the address for 8-bit cards if you choose to access their memory directly. */
 #define DECODE_MEMCARD_ADDRESS(_X_) (QBIT_RANGE_EXTRACT ( address, 0, 12 ) / 2)
 
@@ -42,6 +45,12 @@
 #    define READ_BYTE_ROM READ_BYTE
 #  endif
 
+typedef enum
+{
+    PAL_FORMAT_RGB24 = 0,
+    PAL_FORMAT_MAX
+} enum_gngeoxmemory_pal_format;
+
 typedef enum
 {
     STATUS_B_START_P1 = 0,
@@ -118,6 +127,7 @@ extern Uint8* current_pal;
 extern Uint32* current_pc_pal;
 extern Uint8* current_fix;
 extern Uint8* fix_usage;
+extern Uint32 neo_pal_table[65536];
 /* sram */
 extern Uint8 sram_lock;
 /* 68k cpu Banking control */
@@ -129,6 +139,7 @@ extern Uint32 cpu_68k_bankaddress;
 void write_neo_control ( Uint16 );
 void write_irq2pos ( Uint32 );
 Uint32 convert_pal ( Uint16 ) __attribute__ ( ( warn_unused_result ) );
+void neo_pal_table_init ( enum_gngeoxmemory_pal_format, Uint16 );
 void update_all_pal ( void );
 Uint16 sma_random ( void ) __attribute__ ( ( warn_unused_result ) );
 void dump_hardware_reg ( void );
@@ -110,12 +110,15 @@
 #endif // _GNGEOX_NEOCRYPT_C_
 
 #include <SDL2/SDL.h>
+#include "zlog.h"
 #include "qlibc.h"
 
 #include "GnGeoXroms.h"
 #include "GnGeoXmamelayer.h"
 #include "GnGeoXneocrypt.h"
 #include "GnGeoXneocryptdata.h"
+#include "GnGeoXconfig.h"
+#include "GnGeoXworkers.h"
 
 static Uint8* type0_t03 = 0;
 static Uint8* type0_t12 = 0;
@@ -168,81 +171,291 @@ static void decrypt ( Uint8* r0, Uint8* r1, Uint8 c0,  Uint8 c1, const Uint8* ta
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief Decrypts game gfx.
-*
-* \param machine Todo.
-* \param extra_xor Todo.
+* \brief  Computes the encrypted address of a gfx rom word.
 *
+* \param  rpos Decrypted word address.
+* \param  extra_xor Game address xor.
+* \param  rom_size Sprites region size.
+* \return Encrypted word address.
 */
 /* ******************************************************************************************************************/
-static void neogeo_gfx_decrypt ( struct_gngeoxroms_game_roms* machine, Sint32 extra_xor )
+static Sint32 neogeo_gfx_address ( Sint32 rpos, Sint32 extra_xor, Sint32 rom_size )
 {
-    Sint32 rom_size = 0;
-    Uint8* buf = NULL;
-    Uint8* rom = NULL;
+    Sint32 baser = rpos;
 
-    rom_size = memory_region_length ( machine, GNGEO_MEMORYREGION_SPRITES );
-    buf = alloc_array_or_die ( Uint8, rom_size );
-    rom = memory_region ( machine, GNGEO_MEMORYREGION_SPRITES );
+    baser ^= extra_xor;
+    baser ^= address_8_15_xor1[ ( baser >> 16 ) & 0xff] << 8;
+    baser ^= address_8_15_xor2[baser & 0xff] << 8;
+    baser ^= address_16_23_xor1[baser & 0xff] << 16;
+    baser ^= address_16_23_xor2[ ( baser >> 8 ) & 0xff] << 16;
+    baser ^= address_0_7_xor[ ( baser >> 8 ) & 0xff];
 
-    for ( Sint32 rpos = 0; rpos < ( rom_size / 4 ); rpos++ )
+    if ( rom_size == 0x3000000 ) /* special handling for preisle2 */
     {
-        decrypt ( buf + 4 * rpos + 0, buf + 4 * rpos + 3, rom[4 * rpos + 0], rom[4 * rpos + 3], type0_t03, type0_t12, type1_t03, rpos, ( rpos >> 8 ) & 1 );
-        decrypt ( buf + 4 * rpos + 1, buf + 4 * rpos + 2, rom[4 * rpos + 1], rom[4 * rpos + 2], type0_t12, type0_t03, type1_t12, rpos, ( ( rpos >> 16 ) ^ address_16_23_xor2[ ( rpos >> 8 ) & 0xff] ) & 1 );
+        if ( rpos < 0x2000000 / 4 )
+        {
+            baser &= ( 0x2000000 / 4 ) - 1;
+        }
+        else
+        {
+            baser = 0x2000000 / 4 + ( baser & ( ( 0x1000000 / 4 ) - 1 ) );
+        }
     }
-
-
-    // Address xor
-    for ( Sint32 rpos = 0; rpos < rom_size / 4; rpos++ )
+    else
     {
-        Sint32 baser;
-
-        baser = rpos;
-        baser ^= extra_xor;
-        baser ^= address_8_15_xor1[ ( baser >> 16 ) & 0xff] << 8;
-        baser ^= address_8_15_xor2[baser & 0xff] << 8;
-        baser ^= address_16_23_xor1[baser & 0xff] << 16;
-        baser ^= address_16_23_xor2[ ( baser >> 8 ) & 0xff] << 16;
-        baser ^= address_0_7_xor[ ( baser >> 8 ) & 0xff];
-
-        if ( rom_size == 0x3000000 ) /* special handling for preisle2 */
+        if ( rom_size == 0x6000000 )    /* special handling for kf2k3pcb */
         {
-            if ( rpos < 0x2000000 / 4 )
+            if ( rpos < 0x4000000 / 4 )
             {
-                baser &= ( 0x2000000 / 4 ) - 1;
+                baser &= ( 0x4000000 / 4 ) - 1;
             }
             else
             {
-                baser = 0x2000000 / 4 + ( baser & ( ( 0x1000000 / 4 ) - 1 ) );
+                baser = 0x4000000 / 4 + ( baser & ( ( 0x1000000 / 4 ) - 1 ) );
             }
         }
-        else
+
+        else /* Clamp to the real rom size */
+        {
+            baser &= ( rom_size / 4 ) - 1;
+        }
+    }
+
+    return ( baser );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decrypts gfx data of a part of the rom.
+*
+* \param  data Gfx decryption job.
+* \param  part Part index.
+* \note   In place, words are also moved inside their 256 words line by the last address step.
+*/
+/* ******************************************************************************************************************/
+static void gfx_data_part ( void* data, Sint32 part )
+{
+    struct_gngeoxneocrypt_gfx* gfx = ( struct_gngeoxneocrypt_gfx* ) data;
+    Sint32 words = gfx->rom_size / 4;
+    Sint32 lines = ( words + 255 ) / 256;
+    Sint32 start = ( Sint64 ) lines * part / gfx->nb_parts;
+    Sint32 end = ( Sint64 ) lines * ( part + 1 ) / gfx->nb_parts;
+    Uint8 line[1024];
+
+    for ( Sint32 i = start; i < end; i++ )
+    {
+        Uint8* src = gfx->rom + i * 1024;
+        Uint8* dst = ( gfx->buf != NULL ) ? gfx->buf + i * 1024 : line;
+        Sint32 move = ( gfx->buf != NULL ) ? 0 : address_0_7_xor[i & 0xff];
+        Sint32 count = SDL_min ( words - ( i << 8 ), 256 );
+
+        for ( Sint32 j = 0; j < count; j++ )
         {
-            if ( rom_size == 0x6000000 )    /* special handling for kf2k3pcb */
+            Sint32 rpos = ( i << 8 ) | j;
+
+            if ( ( gfx->mirror != 0 ) && ( rpos >= gfx->mirror ) )
             {
-                if ( rpos < 0x4000000 / 4 )
-                {
-                    baser &= ( 0x4000000 / 4 ) - 1;
-                }
-                else
-                {
-                    baser = 0x4000000 / 4 + ( baser & ( ( 0x1000000 / 4 ) - 1 ) );
-                }
+                rpos -= gfx->mirror_offset;
             }
+            Uint8* word = dst + 4 * ( j ^ move );
+
+            decrypt ( word + 0, word + 3, src[4 * j + 0], src[4 * j + 3], type0_t03, type0_t12, type1_t03, rpos, ( rpos >> 8 ) & 1 );
+            decrypt ( word + 1, word + 2, src[4 * j + 1], src[4 * j + 2], type0_t12, type0_t03, type1_t12, rpos, ( ( rpos >> 16 ) ^ address_16_23_xor2[ ( rpos >> 8 ) & 0xff] ) & 1 );
+        }
 
-            else /* Clamp to the real rom size */
+        if ( gfx->buf == NULL )
+        {
+            memcpy ( src, line, sizeof ( line ) );
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Applies address bits 16 - 23 steps to a part of the rom.
+*
+* \param  data Gfx decryption job.
+* \param  part Part index, 256 words columns of all 64K words blocks.
+* \note   Both steps xor the block with a value of the word position in the block, so they only swap words pairs.
+*/
+/* ******************************************************************************************************************/
+static void gfx_address_high_part ( void* data, Sint32 part )
+{
+    struct_gngeoxneocrypt_gfx* gfx = ( struct_gngeoxneocrypt_gfx* ) data;
+    Uint32 high = address_16_23_xor2[part];
+    Uint8 tmp[4];
+
+    for ( Uint32 block = 0; block < gfx->nb_blocks; block++ )
+    {
+        Uint8* src = gfx->rom + ( ( ( gfx->base + block ) << 16 ) | ( part << 8 ) ) * 4;
+
+        for ( Sint32 j = 0; j < 256; j++ )
+        {
+            Uint32 other = block ^ ( ( address_16_23_xor1[j] ^ high ) & ( gfx->nb_blocks - 1 ) );
+
+            if ( other > block )
             {
-                baser &= ( rom_size / 4 ) - 1;
+                Uint8* dst = src + ( ( other - block ) << 16 ) * 4;
+
+                memcpy ( tmp, src + 4 * j, 4 );
+                memcpy ( src + 4 * j, dst + 4 * j, 4 );
+                memcpy ( dst + 4 * j, tmp, 4 );
             }
         }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Applies address bits 0 - 15 steps to a part of the rom.
+*
+* \param  data Gfx decryption job.
+* \param  part Part index.
+* \note   Words stay in their 64K words block, staged in the part buffer.
+*/
+/* ******************************************************************************************************************/
+static void gfx_address_low_part ( void* data, Sint32 part )
+{
+    struct_gngeoxneocrypt_gfx* gfx = ( struct_gngeoxneocrypt_gfx* ) data;
+    Sint32 blocks = gfx->rom_size >> 18;
+    Sint32 start = ( Sint64 ) blocks * part / gfx->nb_parts;
+    Sint32 end = ( Sint64 ) blocks * ( part + 1 ) / gfx->nb_parts;
+    Uint8* stage = gfx->stage + ( part << 18 );
 
-        rom[4 * rpos + 0] = buf[4 * baser + 0];
-        rom[4 * rpos + 1] = buf[4 * baser + 1];
-        rom[4 * rpos + 2] = buf[4 * baser + 2];
-        rom[4 * rpos + 3] = buf[4 * baser + 3];
+    for ( Sint32 i = start; i < end; i++ )
+    {
+        Uint8* block = gfx->rom + ( i << 18 );
+        Sint32 middle = address_8_15_xor1[i & 0xff] << 8;
+
+        memcpy ( stage, block, 1 << 18 );
+
+        for ( Sint32 j = 0; j < 0x10000; j++ )
+        {
+            Sint32 baser = j ^ gfx->extra_xor ^ middle;
+
+            baser ^= address_8_15_xor2[baser & 0xff] << 8;
+            memcpy ( block + 4 * j, stage + 4 * baser, 4 );
+        }
     }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Moves the words of a part of the rom to their decrypted address.
+*
+* \param  data Gfx decryption job.
+* \param  part Part index.
+*/
+/* ******************************************************************************************************************/
+static void gfx_address_copy_part ( void* data, Sint32 part )
+{
+    struct_gngeoxneocrypt_gfx* gfx = ( struct_gngeoxneocrypt_gfx* ) data;
+    Sint32 words = gfx->rom_size / 4;
+    Sint32 start = ( Sint64 ) words * part / gfx->nb_parts;
+    Sint32 end = ( Sint64 ) words * ( part + 1 ) / gfx->nb_parts;
 
-    qalloc_delete ( buf );
+    for ( Sint32 rpos = start; rpos < end; rpos++ )
+    {
+        memcpy ( gfx->rom + 4 * rpos, gfx->buf + 4 * neogeo_gfx_address ( rpos, gfx->extra_xor, gfx->rom_size ), 4 );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Decrypts game gfx.
+*
+* \param machine Todo.
+* \param extra_xor Todo.
+*
+* \note  Every address step xors some address bits with a value of other bits, so it is its own inverse. The rom is
+*        decrypted in place : data and the last step by 256 words lines, then the two bits 16 - 23 steps as words
+*        swaps between 64K words blocks, then the first three steps inside each block. Only a block per thread is
+*        staged. Rom sizes the steps can't be split for go through a full copy.
+*/
+/* ******************************************************************************************************************/
+static void neogeo_gfx_decrypt ( struct_gngeoxroms_game_roms* machine, Sint32 extra_xor )
+{
+    struct_gngeoxneocrypt_gfx gfx;
+    Uint32 pieces[3][2] = { { 0, 0 }, { 0, 0 }, { 0, 0 } };
+    SDL_bool in_place = SDL_TRUE;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+
+    SDL_zero ( gfx );
+    gfx.rom_size = memory_region_length ( machine, GNGEO_MEMORYREGION_SPRITES );
+    gfx.rom = memory_region ( machine, GNGEO_MEMORYREGION_SPRITES );
+    gfx.extra_xor = extra_xor;
+    gfx.nb_parts = neo_workers_count();
+
+    /* Address clamping splits the rom in pieces, first word and size in 64K words blocks */
+    if ( gfx.rom_size == 0x3000000 )
+    {
+        pieces[0][1] = 0x2000000 >> 18;
+        pieces[1][0] = 0x2000000 >> 18;
+        pieces[1][1] = 0x1000000 >> 18;
+    }
+    else if ( gfx.rom_size == 0x6000000 )
+    {
+        /* Words after 0x5000000 / 4 are another scramble of the previous 0x1000000 / 4 ones */
+        pieces[0][1] = 0x4000000 >> 18;
+        pieces[1][0] = 0x4000000 >> 18;
+        pieces[1][1] = 0x1000000 >> 18;
+        pieces[2][0] = 0x5000000 >> 18;
+        pieces[2][1] = 0x1000000 >> 18;
+        gfx.mirror = 0x5000000 / 4;
+        gfx.mirror_offset = 0x1000000 / 4;
+    }
+    else
+    {
+        pieces[0][1] = gfx.rom_size >> 18;
+        in_place = ( ( gfx.rom_size & 0x3FFFF ) == 0 ) ? SDL_TRUE : SDL_FALSE;
+    }
+
+    for ( Sint32 i = 0; i < 3; i++ )
+    {
+        if ( ( pieces[i][1] & ( pieces[i][1] - 1 ) ) != 0 )
+        {
+            in_place = SDL_FALSE;
+        }
+    }
+
+    if ( ( extra_xor & ~0xFFFF ) != 0 )
+    {
+        in_place = SDL_FALSE;
+    }
+
+    if ( in_place == SDL_TRUE )
+    {
+        gfx.stage = alloc_array_or_die ( Uint8, ( gfx.nb_parts << 18 ) );
+
+        if ( gfx.mirror != 0 )
+        {
+            memcpy ( gfx.rom + gfx.mirror * 4, gfx.rom + ( gfx.mirror - gfx.mirror_offset ) * 4, gfx.mirror_offset * 4 );
+        }
+
+        neo_workers_run ( gfx_data_part, &gfx, gfx.nb_parts );
+
+        for ( Sint32 i = 0; i < 3; i++ )
+        {
+            gfx.base = pieces[i][0];
+            gfx.nb_blocks = pieces[i][1];
+
+            if ( gfx.nb_blocks > 1 )
+            {
+                neo_workers_run ( gfx_address_high_part, &gfx, 256 );
+            }
+        }
+
+        neo_workers_run ( gfx_address_low_part, &gfx, gfx.nb_parts );
+
+        qalloc_delete ( gfx.stage );
+    }
+    else
+    {
+        gfx.buf = alloc_array_or_die ( Uint8, gfx.rom_size );
+
+        neo_workers_run ( gfx_data_part, &gfx, gfx.nb_parts );
+        neo_workers_run ( gfx_address_copy_part, &gfx, gfx.nb_parts );
+
+        qalloc_delete ( gfx.buf );
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Gfx decrypted in %.1f ms (%s)",
+                ( SDL_GetPerformanceCounter() - ticks ) * 1000.0 / SDL_GetPerformanceFrequency(), in_place == SDL_TRUE ? "in place" : "copy" );
 }
 /* ******************************************************************************************************************/
 /*!
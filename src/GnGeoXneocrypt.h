@@ -108,8 +108,27 @@
 #ifndef _GNGEOX_NEOCRYPT_H_
 #define _GNGEOX_NEOCRYPT_H_
 
+typedef struct
+{
+    Uint8* rom;  /* Sprites region */
+    Uint8* buf;  /* Decrypted data copy, when the rom can't be decrypted in place */
+    Uint8* stage;  /* 64K words block of each part */
+    Sint32 rom_size;
+    Sint32 extra_xor;
+    Uint32 base;  /* Piece first 64K words block */
+    Uint32 nb_blocks;  /* Piece 64K words blocks */
+    Sint32 mirror;  /* First word scrambled again from the words mirror_offset below, 0 when none */
+    Sint32 mirror_offset;
+    Sint32 nb_parts;
+} struct_gngeoxneocrypt_gfx;
+
 #ifdef _GNGEOX_NEOCRYPT_C_
 static void decrypt ( Uint8*, Uint8*, Uint8,  Uint8, const Uint8*, const Uint8*, const Uint8*, Sint32, Sint32 );
+static Sint32 neogeo_gfx_address ( Sint32, Sint32, Sint32 ) __attribute__ ( ( warn_unused_result ) );
+static void gfx_data_part ( void*, Sint32 );
+static void gfx_address_high_part ( void*, Sint32 );
+static void gfx_address_low_part ( void*, Sint32 );
+static void gfx_address_copy_part ( void*, Sint32 );
 static void neogeo_gfx_decrypt ( struct_gngeoxroms_game_roms*, Sint32 );
 static void neogeo_sfix_decrypt ( struct_gngeoxroms_game_roms* );
 static void load_cmc42_table ( void );
@@ -208,7 +208,25 @@ void blitter_opengl_update ( void )
     {
         SDL_BlitSurface ( sdl_surface_buffer, &visible_area, tex_opengl, NULL );
         glTexImage2D ( GL_TEXTURE_2D, 0, 3, 512, 256, 0, GL_BGRA, GL_UNSIGNED_BYTE, tex_opengl->pixels );
+    }
+    else
+    {
+        SDL_BlitSurface ( sdl_surface_screen, &glrectef, tex_opengl, NULL );
+        glTexImage2D ( GL_TEXTURE_2D, 0, 3, 1024, 512, 0, GL_BGRA, GL_UNSIGNED_BYTE, tex_opengl->pixels );
+    }
 
+    blitter_opengl_present();
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws again the last uploaded texture, without uploading anything.
+*
+*/
+/* ******************************************************************************************************************/
+void blitter_opengl_present ( void )
+{
+    if ( gngeox_config.effect_index == 0 )
+    {
         glBegin ( GL_QUADS );
         glTexCoord2f ( 0.0f, 0.0f );
         glVertex2f ( -1.0f, 1.0f );
@@ -225,9 +243,6 @@ void blitter_opengl_update ( void )
     }
     else
     {
-        SDL_BlitSurface ( sdl_surface_screen, &glrectef, tex_opengl, NULL );
-        glTexImage2D ( GL_TEXTURE_2D, 0, 3, 1024, 512, 0, GL_BGRA, GL_UNSIGNED_BYTE, tex_opengl->pixels );
-
         glBegin ( GL_QUADS );
         glTexCoord2f ( 0.0f, 0.0f );
         glVertex2f ( -1.0f, 1.0f );
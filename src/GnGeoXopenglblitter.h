@@ -19,6 +19,7 @@
 SDL_bool blitter_opengl_init ( void ) __attribute__ ( ( warn_unused_result ) );
 SDL_bool blitter_opengl_resize ( Sint32, Sint32 ) __attribute__ ( ( warn_unused_result ) );
 void blitter_opengl_update ( void );
+void blitter_opengl_present ( void );
 void blitter_opengl_close ( void );
 void blitter_opengl_fullscreen ( void );
 
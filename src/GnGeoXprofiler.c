@@ -17,13 +17,18 @@
 #define _GNGEOX_PROFILER_C_
 #endif // _GNGEOX_PROFILER_C_
 
+#include <string.h>
 #include <SDL2/SDL.h>
 #include "zlog.h"
 
 #include "GnGeoXprofiler.h"
 #include "GnGeoXconfig.h"
+#include "GnGeoXworkers.h"
 
 static Uint32 counter[MAX_BLOCK];
+/* Last frame band rendering times, in microseconds */
+static Uint32 band_usecs[WORKERS_MAX + 1];
+static Sint32 nb_bands = 0;
 
 /* ******************************************************************************************************************/
 /*!
@@ -47,13 +52,34 @@ void profiler_stop ( enum_gngeoxroms_profiler_type type )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Records band rendering times.
+*
+* \param  ticks Performance counter ticks spent on each band.
+* \param  count Number of bands.
+*/
+/* ******************************************************************************************************************/
+void profiler_bands ( const Uint64* ticks, Sint32 count )
+{
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    nb_bands = SDL_min ( count, WORKERS_MAX + 1 );
+
+    for ( Sint32 i = 0; i < nb_bands; i++ )
+    {
+        band_usecs[i] = ( Uint32 ) ( ( ticks[i] * 1000000 ) / frequency );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Shows profiler stats.
 *
 */
 /* ******************************************************************************************************************/
 void profiler_show_stat ( void )
 {
-    char buffer[256];
+    /* Counters, then " Bands(us):" and up to WORKERS_MAX + 1 band timings of 10 digits and a separator */
+    char buffer[128 + 12 + ( ( WORKERS_MAX + 1 ) * 11 )];
+    size_t length = 0;
 
     Uint32 all = SDL_GetTicks() - counter[PROF_ALL];
 
@@ -64,9 +90,21 @@ void profiler_show_stat ( void )
         video = counter[PROF_VIDEO];
     }
 
-    sprintf ( buffer, "Video:%d (%d) Sound:%d 68K:%d Z80:%d ALL:%d",
-              counter[PROF_VIDEO], video, counter[PROF_SOUND],
-              counter[PROF_68K], counter[PROF_Z80], all );
+    snprintf ( buffer, sizeof ( buffer ), "Video:%d (%d) Blend:%d Sound:%d 68K:%d Z80:%d ALL:%d",
+               counter[PROF_VIDEO], video, counter[PROF_BLEND], counter[PROF_SOUND],
+               counter[PROF_68K], counter[PROF_Z80], all );
+
+    for ( Sint32 i = 0; i < nb_bands; i++ )
+    {
+        length = strlen ( buffer );
+
+        if ( length >= ( sizeof ( buffer ) - 1 ) )
+        {
+            break;
+        }
+
+        snprintf ( buffer + length, sizeof ( buffer ) - length, "%s%u", ( i == 0 ) ? " Bands(us):" : "/", band_usecs[i] );
+    }
 
     zlog_info ( gngeox_config.loggingCat, "%s", buffer );
 }
@@ -24,11 +24,13 @@ typedef enum
     PROF_Z80 = 3,
     PROF_SDLBLIT = 4,
     PROF_SOUND = 5,
-    MAX_BLOCK = 6
+    PROF_BLEND = 6,
+    MAX_BLOCK = 7
 } enum_gngeoxroms_profiler_type;
 
 void profiler_start ( enum_gngeoxroms_profiler_type );
 void profiler_stop ( enum_gngeoxroms_profiler_type );
+void profiler_bands ( const Uint64*, Sint32 );
 void profiler_show_stat ( void );
 
 #endif
@@ -0,0 +1,338 @@
+/*!
+*
+*   \file    GnGeoXresampler.c
+*   \brief   Polyphase windowed-sinc audio resampler.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    The filter is a Kaiser windowed sinc, tabulated for RESAMPLER_PHASES
+*            fractional positions in Q15. The low pass cutoff follows the lowest
+*            of both rates so that decimating from the YM2610 native rate does not alias.
+*/
+#ifndef _GNGEOX_RESAMPLER_C_
+#define _GNGEOX_RESAMPLER_C_
+#endif // _GNGEOX_RESAMPLER_C_
+
+#include <string.h>
+#include <math.h>
+
+#include <SDL2/SDL.h>
+#include "zlog.h"
+#include "qlibc.h"
+
+#if defined ( __SSE2__ )
+#include <emmintrin.h>
+#elif defined ( __ARM_NEON )
+#include <arm_neon.h>
+#endif
+
+#include "GnGeoXresampler.h"
+#include "GnGeoXconfig.h"
+
+static struct_gngeoxresampler_state resampler;
+
+/* ******************************************************************************************************************/
+/*!
+* \brief  Modified Bessel function of the first kind, order zero.
+*
+* \param  x Function argument.
+* \return I0(x).
+*/
+/* ******************************************************************************************************************/
+static double neo_resampler_bessel_i0 ( double x )
+{
+    double sum = 1.0;
+    double term = 1.0;
+
+    for ( Sint32 k = 1; k < 32; k++ )
+    {
+        term *= ( x / ( 2.0 * k ) ) * ( x / ( 2.0 * k ) );
+        sum += term;
+
+        if ( term < ( sum * 1e-12 ) )
+        {
+            break;
+        }
+    }
+
+    return ( sum );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Builds polyphase filter coefficients.
+*
+* \note   Each phase is normalized to an exact unity DC gain after rounding.
+*/
+/* ******************************************************************************************************************/
+static void neo_resampler_build_coefs ( void )
+{
+    double cutoff = 0.9;
+    double half = RESAMPLER_TAPS / 2.0;
+    double window_norm = neo_resampler_bessel_i0 ( RESAMPLER_KAISER_BETA );
+
+    if ( resampler.out_rate < resampler.in_rate )
+    {
+        cutoff *= ( double ) resampler.out_rate / ( double ) resampler.in_rate;
+    }
+
+    for ( Sint32 phase = 0; phase < RESAMPLER_PHASES; phase++ )
+    {
+        double taps[RESAMPLER_TAPS];
+        double fraction = ( double ) phase / RESAMPLER_PHASES;
+        double sum = 0.0;
+        Sint32 total = 0;
+        Sint32 peak = 0;
+
+        for ( Sint32 k = 0; k < RESAMPLER_TAPS; k++ )
+        {
+            double t = ( double ) k - ( half - 1.0 ) - fraction;
+            double x = t / half;
+            double sinc = 1.0;
+
+            if ( fabs ( t ) > 1e-9 )
+            {
+                sinc = sin ( M_PI * cutoff * t ) / ( M_PI * cutoff * t );
+            }
+
+            if ( fabs ( x ) >= 1.0 )
+            {
+                taps[k] = 0.0;
+            }
+            else
+            {
+                taps[k] = cutoff * sinc * neo_resampler_bessel_i0 ( RESAMPLER_KAISER_BETA * sqrt ( 1.0 - x * x ) ) / window_norm;
+            }
+
+            sum += taps[k];
+        }
+
+        for ( Sint32 k = 0; k < RESAMPLER_TAPS; k++ )
+        {
+            resampler.coefs[phase][k] = ( Sint16 ) lrint ( ( taps[k] / sum ) * 32768.0 );
+            total += resampler.coefs[phase][k];
+
+            if ( taps[k] > taps[peak] )
+            {
+                peak = k;
+            }
+        }
+
+        /* @note (Tmesys#1#18/10/2026): Rounding error goes to the main lobe, so silence stays silent and DC is unchanged. */
+        resampler.coefs[phase][peak] += ( Sint16 ) ( 32768 - total );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Convolves one channel with one filter phase.
+*
+* \param  samples First input sample under the filter.
+* \param  coefs Filter phase.
+* \return Q15 accumulated value.
+*/
+/* ******************************************************************************************************************/
+static inline Sint32 neo_resampler_filter ( const Sint16* samples, const Sint16* coefs )
+{
+#if defined ( __SSE2__ )
+    __m128i acc = _mm_setzero_si128();
+
+    for ( Sint32 k = 0; k < RESAMPLER_TAPS; k += 8 )
+    {
+        acc = _mm_add_epi32 ( acc, _mm_madd_epi16 ( _mm_loadu_si128 ( ( const __m128i* ) &samples[k] ),
+                                                    _mm_loadu_si128 ( ( const __m128i* ) &coefs[k] ) ) );
+    }
+
+    acc = _mm_add_epi32 ( acc, _mm_shuffle_epi32 ( acc, _MM_SHUFFLE ( 1, 0, 3, 2 ) ) );
+    acc = _mm_add_epi32 ( acc, _mm_shuffle_epi32 ( acc, _MM_SHUFFLE ( 2, 3, 0, 1 ) ) );
+
+    return ( _mm_cvtsi128_si32 ( acc ) );
+#elif defined ( __ARM_NEON )
+    int32x4_t acc = vdupq_n_s32 ( 0 );
+
+    for ( Sint32 k = 0; k < RESAMPLER_TAPS; k += 4 )
+    {
+        acc = vmlal_s16 ( acc, vld1_s16 ( &samples[k] ), vld1_s16 ( &coefs[k] ) );
+    }
+
+    return ( vgetq_lane_s32 ( acc, 0 ) + vgetq_lane_s32 ( acc, 1 ) + vgetq_lane_s32 ( acc, 2 ) + vgetq_lane_s32 ( acc, 3 ) );
+#else
+    Sint32 acc = 0;
+
+    for ( Sint32 k = 0; k < RESAMPLER_TAPS; k++ )
+    {
+        acc += samples[k] * coefs[k];
+    }
+
+    return ( acc );
+#endif
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Pulls input frames from the source.
+*
+* \param  count Number of frames to append.
+*/
+/* ******************************************************************************************************************/
+static void neo_resampler_fill ( Uint32 count )
+{
+    resampler.source ( count, resampler.interleaved );
+
+    for ( Uint32 loop = 0; loop < count; loop++ )
+    {
+        resampler.left[resampler.frames + loop] = ( Sint16 ) resampler.interleaved[loop * 2];
+        resampler.right[resampler.frames + loop] = ( Sint16 ) resampler.interleaved[loop * 2 + 1];
+    }
+
+    resampler.frames += count;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Produces at most max_out_frames output frames.
+*
+* \param  buffer Interleaved stereo output.
+* \param  frames Number of frames to produce.
+*/
+/* ******************************************************************************************************************/
+static void neo_resampler_chunk ( Sint16* buffer, Uint32 frames )
+{
+    Uint64 last = resampler.position + ( Uint64 ) ( frames - 1 ) * resampler.step;
+    Uint32 needed = ( Uint32 ) ( last >> 32 ) + RESAMPLER_TAPS;
+    Uint32 consumed = 0;
+
+    if ( needed > resampler.frames )
+    {
+        neo_resampler_fill ( needed - resampler.frames );
+    }
+
+    for ( Uint32 loop = 0; loop < frames; loop++ )
+    {
+        Uint32 index = ( Uint32 ) ( resampler.position >> 32 );
+        const Sint16* coefs = resampler.coefs[ ( resampler.position >> ( 32 - RESAMPLER_PHASE_BITS ) ) & ( RESAMPLER_PHASES - 1 )];
+        Sint32 left = ( neo_resampler_filter ( &resampler.left[index], coefs ) + ( 1 << 14 ) ) >> 15;
+        Sint32 right = ( neo_resampler_filter ( &resampler.right[index], coefs ) + ( 1 << 14 ) ) >> 15;
+
+        buffer[loop * 2] = ( Sint16 ) SDL_max ( -32768, SDL_min ( left, 32767 ) );
+        buffer[loop * 2 + 1] = ( Sint16 ) SDL_max ( -32768, SDL_min ( right, 32767 ) );
+
+        resampler.position += resampler.step;
+    }
+
+    /* Drop the history no longer under the filter */
+    consumed = SDL_min ( ( Uint32 ) ( resampler.position >> 32 ), resampler.frames );
+
+    if ( consumed != 0 )
+    {
+        resampler.frames -= consumed;
+        memmove ( resampler.left, &resampler.left[consumed], resampler.frames * sizeof ( Sint16 ) );
+        memmove ( resampler.right, &resampler.right[consumed], resampler.frames * sizeof ( Sint16 ) );
+        resampler.position -= ( ( Uint64 ) consumed << 32 );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Initializes resampler.
+*
+* \param  in_rate Rate of the source stream in Hz.
+* \param  out_rate Rate of the produced stream in Hz.
+* \param  max_out_frames Largest number of frames produced at once.
+* \param  source Source stream producer.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+*/
+/* ******************************************************************************************************************/
+SDL_bool neo_resampler_init ( Uint32 in_rate, Uint32 out_rate, Uint32 max_out_frames, resampler_source source )
+{
+    neo_resampler_close();
+
+    if ( ( in_rate == 0 ) || ( out_rate == 0 ) || ( max_out_frames == 0 ) || ( source == NULL ) )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Invalid resampler parameters" );
+        return ( SDL_FALSE );
+    }
+
+    /* @note (Tmesys#1#18/10/2026): Larger ratios would skip input samples entirely. */
+    if ( in_rate > ( out_rate * ( RESAMPLER_TAPS / 2 ) ) )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Resampling ratio too high : %u Hz -> %u Hz", in_rate, out_rate );
+        return ( SDL_FALSE );
+    }
+
+    resampler.in_rate = in_rate;
+    resampler.out_rate = out_rate;
+    resampler.step = ( ( Uint64 ) in_rate << 32 ) / out_rate;
+    resampler.position = 0;
+    resampler.frames = 0;
+    resampler.max_out_frames = max_out_frames;
+    resampler.capacity = ( Uint32 ) ( ( ( Uint64 ) max_out_frames * in_rate + out_rate - 1 ) / out_rate ) + RESAMPLER_TAPS + 2;
+    resampler.source = source;
+
+    resampler.left = ( Sint16* ) qalloc ( resampler.capacity * sizeof ( Sint16 ) );
+    resampler.right = ( Sint16* ) qalloc ( resampler.capacity * sizeof ( Sint16 ) );
+    resampler.interleaved = ( Uint16* ) qalloc ( resampler.capacity * 2 * sizeof ( Uint16 ) );
+
+    if ( ( resampler.left == NULL ) || ( resampler.right == NULL ) || ( resampler.interleaved == NULL ) )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Can not allocate resampler buffers" );
+        neo_resampler_close();
+        return ( SDL_FALSE );
+    }
+
+    neo_resampler_build_coefs();
+
+    zlog_info ( gngeox_config.loggingCat, "Resampling %u Hz -> %u Hz (%d taps, %d phases)", in_rate, out_rate, RESAMPLER_TAPS, RESAMPLER_PHASES );
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Produces resampled frames.
+*
+* \param  buffer Interleaved stereo output.
+* \param  frames Number of frames to produce.
+*/
+/* ******************************************************************************************************************/
+void neo_resampler_run ( Sint16* buffer, Uint32 frames )
+{
+    while ( frames != 0 )
+    {
+        Uint32 count = SDL_min ( frames, resampler.max_out_frames );
+
+        neo_resampler_chunk ( buffer, count );
+
+        buffer += count * 2;
+        frames -= count;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Frees resampler buffers.
+*
+*/
+/* ******************************************************************************************************************/
+void neo_resampler_close ( void )
+{
+    if ( resampler.left != NULL )
+    {
+        qalloc_delete ( resampler.left );
+    }
+
+    if ( resampler.right != NULL )
+    {
+        qalloc_delete ( resampler.right );
+    }
+
+    if ( resampler.interleaved != NULL )
+    {
+        qalloc_delete ( resampler.interleaved );
+    }
+
+    SDL_zero ( resampler );
+}
+
+#ifdef _GNGEOX_RESAMPLER_C_
+#undef _GNGEOX_RESAMPLER_C_
+#endif // _GNGEOX_RESAMPLER_C_
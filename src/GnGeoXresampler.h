@@ -0,0 +1,61 @@
+/*!
+*
+*   \file    GnGeoXresampler.h
+*   \brief   Polyphase windowed-sinc audio resampler header.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Converts a stereo 16 bits stream produced at the YM2610 internal rate
+*            to the rate obtained from the audio device.
+*/
+#ifndef _GNGEOX_RESAMPLER_H_
+#define _GNGEOX_RESAMPLER_H_
+
+#include <SDL2/SDL.h>
+
+/* Filter length in input samples, must be a multiple of 8 */
+#define RESAMPLER_TAPS       32
+#define RESAMPLER_PHASE_BITS 8
+#define RESAMPLER_PHASES     ( 1 << RESAMPLER_PHASE_BITS )
+#define RESAMPLER_KAISER_BETA 7.0
+
+/* Produces the requested number of interleaved stereo frames */
+typedef void ( *resampler_source ) ( Sint32, Uint16* );
+
+typedef struct
+{
+    Uint32 in_rate;
+    Uint32 out_rate;
+    /* 32.32 fixed point position and step in input frames */
+    Uint64 position;
+    Uint64 step;
+    /* Buffered input frames and capacity */
+    Uint32 frames;
+    Uint32 capacity;
+    Uint32 max_out_frames;
+    Sint16* left;
+    Sint16* right;
+    Uint16* interleaved;
+    resampler_source source;
+    Sint16 coefs[RESAMPLER_PHASES][RESAMPLER_TAPS];
+} struct_gngeoxresampler_state;
+
+#ifdef _GNGEOX_RESAMPLER_C_
+static double neo_resampler_bessel_i0 ( double );
+static void neo_resampler_build_coefs ( void );
+static Sint32 neo_resampler_filter ( const Sint16*, const Sint16* );
+static void neo_resampler_fill ( Uint32 );
+static void neo_resampler_chunk ( Sint16*, Uint32 );
+#endif // _GNGEOX_RESAMPLER_C_
+
+SDL_bool neo_resampler_init ( Uint32, Uint32, Uint32, resampler_source ) __attribute__ ( ( warn_unused_result ) );
+void neo_resampler_run ( Sint16*, Uint32 );
+void neo_resampler_close ( void );
+
+#endif
@@ -28,6 +28,8 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
@@ -46,8 +48,26 @@
 #include "GnGeoXromsgno.h"
 #include "GnGeoXscreen.h"
 #include "GnGeoXemu.h"
+#include "GnGeoXworkers.h"
+
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#include <immintrin.h>
+#define ROMS_SIMD_X86 1
+#define TARGET_SSSE3 __attribute__ ( ( target ( "ssse3" ) ) )
+#define TARGET_SSE2 __attribute__ ( ( target ( "sse2" ) ) )
+#endif
 
 Sint32 neo_rom_fix_bank_type = 0;
+/* For each plane byte value, its 8 bits as bit 0 of 8 pens, first pixel in the top nibble */
+static Uint32 tile_spread[256];
+/* Tile conversion in use */
+static tile_convert_kernel convert_tile = NULL;
+/* Sprites converted by the pipeline thread while loading */
+static struct_gngeoxroms_load_pipeline load_pipeline;
+static SDL_bool load_streaming = SDL_FALSE;
+/* Sprite files interleaving in use */
+static struct_gngeoxroms_load_interleave load_interleave;
+
 char * neo_rom_region_name[] =
 {
     "audio cpu bios",
@@ -157,6 +177,96 @@ static void free_region ( struct_gngeoxroms_rom_region* rom_region )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Interleaves sprite file bytes, one at a time.
+*
+* \param  dst First destination byte.
+* \param  src Sprite file bytes.
+* \param  size Number of bytes.
+*/
+/* ******************************************************************************************************************/
+static void load_interleave_scalar ( Uint8* dst, const Uint8* src, Uint32 size )
+{
+    for ( Uint32 i = 0; i < size; i++ )
+    {
+        dst[i << 1] = src[i];
+    }
+}
+#ifdef ROMS_SIMD_X86
+/* ******************************************************************************************************************/
+/*!
+* \brief  Interleaves sprite file bytes, 16 at a time.
+*
+* \param  dst First destination byte.
+* \param  src Sprite file bytes.
+* \param  size Number of bytes.
+* \note   The other file bytes are read and written back, the last one is left to the scalar loop so no byte after
+*         the last destination byte is touched.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE2 static void load_interleave_sse2 ( Uint8* dst, const Uint8* src, Uint32 size )
+{
+    const __m128i keep = _mm_set1_epi16 ( ( short ) 0xFF00 );
+    const __m128i zero = _mm_setzero_si128();
+    Uint32 i = 0;
+
+    for ( ; i + 16 < size; i += 16 )
+    {
+        __m128i bytes = _mm_loadu_si128 ( ( const __m128i* ) ( src + i ) );
+        __m128i* out = ( __m128i* ) ( dst + ( i << 1 ) );
+        __m128i low = _mm_and_si128 ( _mm_loadu_si128 ( out ), keep );
+        __m128i high = _mm_and_si128 ( _mm_loadu_si128 ( out + 1 ), keep );
+
+        _mm_storeu_si128 ( out, _mm_or_si128 ( low, _mm_unpacklo_epi8 ( bytes, zero ) ) );
+        _mm_storeu_si128 ( out + 1, _mm_or_si128 ( high, _mm_unpackhi_epi8 ( bytes, zero ) ) );
+    }
+
+    load_interleave_scalar ( dst + ( i << 1 ), src + i, size - i );
+}
+#endif // ROMS_SIMD_X86
+/* ******************************************************************************************************************/
+/*!
+* \brief  Interleaves sprite file bytes in the sprites region.
+*
+* \param  dst First destination byte.
+* \param  src Sprite file bytes.
+* \param  size Number of bytes.
+* \note   When the other lane file loads at the same time, each block is written under its lock as the kernel writes
+*         the other lane bytes back.
+*/
+/* ******************************************************************************************************************/
+static void load_interleave_lanes ( Uint8* dst, const Uint8* src, Uint32 size )
+{
+    Uint32 offset = 0, block = 0, count = 0;
+
+    if ( load_interleave.locks == NULL )
+    {
+        load_interleave.kernel ( dst, src, size );
+        return;
+    }
+
+    offset = dst - load_interleave.base;
+
+    while ( size )
+    {
+        block = offset >> LOAD_BLOCK_SHIFT;
+        count = ( ( ( block + 1 ) << LOAD_BLOCK_SHIFT ) - offset + 1 ) >> 1;
+
+        if ( count > size )
+        {
+            count = size;
+        }
+
+        SDL_AtomicLock ( &load_interleave.locks[block] );
+        load_interleave.kernel ( load_interleave.base + offset, src, count );
+        SDL_AtomicUnlock ( &load_interleave.locks[block] );
+
+        offset += count << 1;
+        src += count;
+        size -= count;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Reads from ZIP rom file.
 *
 * \param  zip_entry Todo.
@@ -168,6 +278,7 @@ static void free_region ( struct_gngeoxroms_rom_region* rom_region )
 static SDL_bool read_data_i ( qzip_entry_t* zip_entry, struct_gngeoxroms_rom_region* rom_region, Uint32 dest, Uint32 size )
 {
     Uint8* p = NULL;
+    const Uint8* src = NULL;
     Uint32 s = LOAD_BUF_SIZE, c = 0;
     Uint8 iloadbuf[LOAD_BUF_SIZE];
 
@@ -194,19 +305,30 @@ static SDL_bool read_data_i ( qzip_entry_t* zip_entry, struct_gngeoxroms_rom_reg
             c = s;
         }
 
-        c = qzip_read_entry ( zip_entry, &iloadbuf, c );
+        if ( zip_entry->file_header.compression_method == 0 )
+        {
+            /* Stored, interleaved straight from the zip mapping */
+            src = qzip_map_entry ( zip_entry, &c );
+        }
+        else
+        {
+            c = qzip_read_entry ( zip_entry, iloadbuf, c );
+            src = iloadbuf;
+        }
 
         if ( c == 0 )
         {
             return ( SDL_TRUE );
         }
 
-        for ( Uint32 i = 0; i < c; i++ )
+        load_interleave_lanes ( p, src, c );
+
+        if ( load_streaming == SDL_TRUE )
         {
-            *p = iloadbuf[i];
-            p += 2;
+            load_pipeline_loaded ( p, c );
         }
 
+        p += c << 1;
         size -= c;
     }
 
@@ -275,6 +397,7 @@ static SDL_bool read_data_p ( qzip_entry_t* zip_entry, struct_gngeoxroms_rom_reg
 static SDL_bool load_region ( qzip_file_t* pz_file, struct_gngeoxroms_game_roms* rom, struct_gngeoxdrivers_rom_def* drv, Sint32 index )
 {
     qzip_entry_t* zip_entry = NULL;
+    Uint64 ticks = SDL_GetPerformanceCounter();
 
     zlog_info ( gngeox_config.loggingCat, "Loading file %s in (%s) region", drv->rom[index].filename->data, neo_rom_region_name[drv->rom[index].region] );
 
@@ -326,7 +449,8 @@ static SDL_bool load_region ( qzip_file_t* pz_file, struct_gngeoxroms_game_roms*
         }
     }
 
-    zlog_info ( gngeox_config.loggingCat, "Loading completed uncompressed size %d bytes : OK ", zip_entry->file_header.uncompressed_size );
+    zlog_info ( gngeox_config.loggingCat, "Loading %s completed uncompressed size %d bytes in %.1f ms : OK ", drv->rom[index].filename->data,
+                zip_entry->file_header.uncompressed_size, load_stage_ms ( ticks ) );
 
     qzip_close_entry ( zip_entry );
 
@@ -334,6 +458,200 @@ static SDL_bool load_region ( qzip_file_t* pz_file, struct_gngeoxroms_game_roms*
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Loads a rom file, from the parent when the game zip doesn't have it.
+*
+* \param  zip_file Game zip.
+* \param  rom Todo.
+* \param  drv Todo.
+* \param  index Rom file index.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool load_entry ( qzip_file_t* zip_file, struct_gngeoxroms_game_roms* rom, struct_gngeoxdrivers_rom_def* drv, Sint32 index )
+{
+    qzip_file_t* gzp_file = NULL;
+
+    if ( load_region ( zip_file, rom, drv, index ) == SDL_TRUE )
+    {
+        return ( SDL_TRUE );
+    }
+
+    if ( biseqcstrcaseless ( drv->parent, "neogeo" ) != 0 )
+    {
+        return ( SDL_TRUE );
+    }
+
+    /* File not found in the roms, try the parent */
+    zlog_info ( gngeox_config.loggingCat, "Get file from parent" );
+
+    /* Open Parent. For now, only one parent is supported, no recursion */
+    gzp_file = open_rom_zip ( gngeox_config.rompath, ( const char* ) drv->parent->data );
+    if ( gzp_file == NULL )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Parent %s/%s.zip not found", gngeox_config.rompath, gngeox_config.gamename );
+        return ( SDL_FALSE );
+    }
+
+    if ( load_region ( gzp_file, rom, drv, index ) == SDL_FALSE )
+    {
+        zlog_error ( gngeox_config.loggingCat, "File %s not found", drv->rom[index].filename->data );
+        qzip_close_file ( gzp_file );
+        return ( SDL_FALSE );
+    }
+
+    qzip_close_file ( gzp_file );
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Tells if two rom files write the same bytes.
+*
+* \param  drv Todo.
+* \param  i First rom file index.
+* \param  j Second rom file index.
+* \return SDL_TRUE when they do, SDL_FALSE otherwise.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool load_entries_overlap ( struct_gngeoxdrivers_rom_def* drv, Uint32 i, Uint32 j )
+{
+    Uint32 start_i = drv->rom[i].dest, start_j = drv->rom[j].dest;
+
+    if ( drv->rom[i].region != drv->rom[j].region )
+    {
+        return ( SDL_FALSE );
+    }
+
+    /* Even and odd sprite bytes come from different files */
+    if ( drv->rom[i].region == REGION_SPRITES )
+    {
+        if ( ( ( start_i ^ start_j ) & 1 ) != 0 )
+        {
+            return ( SDL_FALSE );
+        }
+
+        start_i >>= 1;
+        start_j >>= 1;
+    }
+
+    if ( ( start_i < start_j + drv->rom[j].size ) && ( start_j < start_i + drv->rom[i].size ) )
+    {
+        return ( SDL_TRUE );
+    }
+
+    return ( SDL_FALSE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Loads a rom file on a worker.
+*
+* \param  data Rom files loading job.
+* \param  part Part index.
+*/
+/* ******************************************************************************************************************/
+static void load_entry_part ( void* data, Sint32 part )
+{
+    struct_gngeoxroms_load_entries* entries = ( struct_gngeoxroms_load_entries* ) data;
+
+    if ( load_entry ( entries->zip, entries->rom, entries->drv, entries->order[part] ) == SDL_FALSE )
+    {
+        SDL_AtomicSet ( &entries->failed, 1 );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Loads all rom files.
+*
+* \param  zip_file Game zip.
+* \param  rom Todo.
+* \param  drv Todo.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \note   Files go to different bytes, so they are inflated at the same time by the workers, biggest first, all from
+*         the game zip mapping. Files writing the same bytes are loaded one after the other, in order.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool load_entries ( qzip_file_t* zip_file, struct_gngeoxroms_game_roms* rom, struct_gngeoxdrivers_rom_def* drv )
+{
+    struct_gngeoxroms_load_entries entries;
+    SDL_bool parallel = ( ( neo_workers_count() > 1 ) && ( drv->nb_romfile > 1 ) ) ? SDL_TRUE : SDL_FALSE;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+
+    SDL_zero ( load_interleave );
+    load_interleave.kernel = load_interleave_scalar;
+    load_interleave.base = rom->rom_region[REGION_SPRITES].p;
+
+#ifdef ROMS_SIMD_X86
+    __builtin_cpu_init();
+
+    if ( __builtin_cpu_supports ( "sse2" ) )
+    {
+        load_interleave.kernel = load_interleave_sse2;
+    }
+#endif // ROMS_SIMD_X86
+
+    for ( Uint32 i = 0; ( i < drv->nb_romfile ) && ( parallel == SDL_TRUE ); i++ )
+    {
+        for ( Uint32 j = i + 1; j < drv->nb_romfile; j++ )
+        {
+            if ( load_entries_overlap ( drv, i, j ) == SDL_TRUE )
+            {
+                parallel = SDL_FALSE;
+                break;
+            }
+        }
+    }
+
+    if ( parallel == SDL_FALSE )
+    {
+        for ( Uint32 i = 0; i < drv->nb_romfile; i++ )
+        {
+            if ( load_entry ( zip_file, rom, drv, i ) == SDL_FALSE )
+            {
+                return ( SDL_FALSE );
+            }
+        }
+
+        return ( SDL_TRUE );
+    }
+
+    if ( rom->rom_region[REGION_SPRITES].size != 0 )
+    {
+        load_interleave.locks = ( SDL_SpinLock* ) qalloc ( ( ( rom->rom_region[REGION_SPRITES].size >> LOAD_BLOCK_SHIFT ) + 1 ) * sizeof ( SDL_SpinLock ) );
+        if ( load_interleave.locks == NULL )
+        {
+            zlog_error ( gngeox_config.loggingCat, "Not enough memory to load files at the same time" );
+            return ( SDL_FALSE );
+        }
+    }
+
+    SDL_zero ( entries );
+    entries.rom = rom;
+    entries.drv = drv;
+    entries.zip = zip_file;
+
+    for ( Uint32 i = 0; i < drv->nb_romfile; i++ )
+    {
+        Uint32 j = i;
+
+        for ( ; ( j > 0 ) && ( drv->rom[entries.order[j - 1]].size < drv->rom[i].size ); j-- )
+        {
+            entries.order[j] = entries.order[j - 1];
+        }
+
+        entries.order[j] = i;
+    }
+
+    neo_workers_run ( load_entry_part, &entries, drv->nb_romfile );
+
+    qalloc_delete ( load_interleave.locks );
+    load_interleave.locks = NULL;
+
+    zlog_info ( gngeox_config.loggingCat, "%u rom files loaded on %d threads in %.1f ms", drv->nb_romfile, neo_workers_count(), load_stage_ms ( ticks ) );
+
+    return ( SDL_AtomicGet ( &entries.failed ) == 0 ? SDL_TRUE : SDL_FALSE );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Loads rom.
 *
 * \param  rom Todo.
@@ -346,7 +664,9 @@ static SDL_bool load_region ( qzip_file_t* pz_file, struct_gngeoxroms_game_roms*
 static SDL_bool dr_load_roms ( struct_gngeoxroms_game_roms* rom )
 {
     struct_gngeoxdrivers_rom_def* drv = NULL;
-    qzip_file_t* zip_file = NULL, *gzp_file = NULL;
+    qzip_file_t* zip_file = NULL;
+    SDL_bool streaming = SDL_FALSE;
+    Uint64 ticks = SDL_GetPerformanceCounter();
 
     memset ( rom, 0, sizeof ( struct_gngeoxroms_game_roms ) );
 
@@ -388,33 +708,13 @@ static SDL_bool dr_load_roms ( struct_gngeoxroms_game_roms* rom )
         return ( SDL_FALSE );
     }
 
+    /* Sprites are converted while the next files get inflated, unless the whole region is needed first */
+    streaming = load_pipeline_start ( rom, drv );
+
     /* Now, load the roms */
-    for ( Uint32 i = 0; i < drv->nb_romfile; i++ )
+    if ( load_entries ( zip_file, rom, drv ) == SDL_FALSE )
     {
-        if ( load_region ( zip_file, rom, drv, i ) == SDL_FALSE )
-        {
-            if ( biseqcstrcaseless ( drv->parent, "neogeo" ) == 0 )
-            {
-                /* File not found in the roms, try the parent */
-                zlog_info ( gngeox_config.loggingCat, "Get file from parent" );
-
-                /* Open Parent. For now, only one parent is supported, no recursion */
-                gzp_file = open_rom_zip ( gngeox_config.rompath, ( const char* ) drv->parent->data );
-                if ( gzp_file == NULL )
-                {
-                    zlog_error ( gngeox_config.loggingCat, "Parent %s/%s.zip not found", gngeox_config.rompath, gngeox_config.gamename );
-                    goto error1;
-                }
-
-                if ( load_region ( gzp_file, rom, drv, i ) == SDL_FALSE )
-                {
-                    zlog_error ( gngeox_config.loggingCat, "File %s not found", drv->rom[i].filename->data );
-                    goto error1;
-                }
-
-                qzip_close_file ( gzp_file );
-            }
-        }
+        goto error1;
     }
 
     /* Close/clean up */
@@ -430,18 +730,24 @@ static SDL_bool dr_load_roms ( struct_gngeoxroms_game_roms* rom )
 
     neogeo_memory.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
 
+    zlog_info ( gngeox_config.loggingCat, "Roms read in %.1f ms", load_stage_ms ( ticks ) );
+
     /* Init rom and bios */
-    init_roms ( rom );
-    convert_all_tile ( rom );
+    ticks = SDL_GetPerformanceCounter();
+    init_all_roms ( rom, streaming );
+    zlog_info ( gngeox_config.loggingCat, "Roms initialized in %.1f ms", load_stage_ms ( ticks ) );
+
+    if ( gngeox_config.dedup == SDL_TRUE )
+    {
+        dedup_all_tile ( rom );
+    }
+
     return ( neo_bios_load ( rom ) );
 
 error1:
-    qzip_close_file ( zip_file );
+    load_pipeline_stop();
 
-    if ( gzp_file )
-    {
-        qzip_close_file ( gzp_file );
-    }
+    qzip_close_file ( zip_file );
 
     qalloc_delete ( drv );
 
@@ -449,6 +755,18 @@ error1:
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Gets the duration of a loading stage.
+*
+* \param  start Performance counter at the stage start.
+* \return Duration in milliseconds.
+*/
+/* ******************************************************************************************************************/
+static double load_stage_ms ( Uint64 start )
+{
+    return ( ( SDL_GetPerformanceCounter() - start ) * 1000.0 / SDL_GetPerformanceFrequency() );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Opens rom Zip.
 *
 * \param  rom_path Todo.
@@ -473,153 +791,808 @@ static qzip_file_t* open_rom_zip ( const char* rom_path, const char* name )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Converts rom tiles.
+* \brief  Drops a rom zip from the page cache.
 *
-* \param  gfx Todo.
-* \param  tileno Todo.
+* \param  name Zip name, without extension.
+* \return SDL_FALSE when the zip stays cached, SDL_TRUE otherwise.
+* \note   Only the pages no one maps are dropped.
 */
 /* ******************************************************************************************************************/
-static Sint32 convert_roms_tile ( Uint8* gfx, Sint32 tileno )
+static SDL_bool load_bench_evict ( const char* name )
 {
-    Uint8 swap[128];
-    Uint32* gfxdata = NULL;
-    Uint32 pen = 0, usage = 0;
-
-    gfxdata = ( Uint32* ) & gfx[tileno << 7];
+    SDL_bool evicted = SDL_FALSE;
+#ifdef POSIX_FADV_DONTNEED
+    bstring fpath = NULL;
+    int fd = -1;
 
-    memcpy ( swap, gfxdata, 128 );
+    fpath = bfromcstr ( gngeox_config.rompath );
+    bcatcstr ( fpath, "/" );
+    bcatcstr ( fpath, name );
+    bcatcstr ( fpath, ".zip" );
 
-    //filed=1;
-    for ( Sint32 y = 0; y < 16; y++ )
+    fd = open ( ( const char* ) fpath->data, O_RDONLY );
+    if ( fd != -1 )
     {
-        Uint32 dw = 0;
-
-        for ( Sint32 x = 0; x < 8; x++ )
-        {
-            pen = ( ( swap[64 + ( y << 2 ) + 3] >> x ) & 1 ) << 3;
-            pen |= ( ( swap[64 + ( y << 2 ) + 1] >> x ) & 1 ) << 2;
-            pen |= ( ( swap[64 + ( y << 2 ) + 2] >> x ) & 1 ) << 1;
-            pen |= ( swap[64 + ( y << 2 )] >> x ) & 1;
-            //if (!pen) filed=0;
-            dw |= pen << ( ( 7 - x ) << 2 );
-            //memory.pen_usage[tileno]  |= (1 << pen);
-            usage |= ( 1 << pen );
-        }
-
-        * ( gfxdata++ ) = dw;
+        evicted = ( posix_fadvise ( fd, 0, 0, POSIX_FADV_DONTNEED ) == 0 ) ? SDL_TRUE : SDL_FALSE;
+        close ( fd );
+    }
 
-        dw = 0;
+    bdestroy ( fpath );
+#endif // POSIX_FADV_DONTNEED
 
-        for ( Uint32 x = 0; x < 8; x++ )
-        {
-            pen = ( ( swap[ ( y << 2 ) + 3] >> x ) & 1 ) << 3;
-            pen |= ( ( swap[ ( y << 2 ) + 1] >> x ) & 1 ) << 2;
-            pen |= ( ( swap[ ( y << 2 ) + 2] >> x ) & 1 ) << 1;
-            pen |= ( swap[ ( y << 2 )] >> x ) & 1;
-            //if (!pen) filed=0;
-            dw |= pen << ( ( 7 - x ) << 2 );
-            //memory.pen_usage[tileno]  |= (1 << pen);
-            usage |= ( 1 << pen );
-        }
+    return ( evicted );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts a rom tile from bit planes to packed pens, one byte at a time.
+*
+* \param  tile Tile 128 bytes, converted in place.
+* \note   Each plane byte gives one bit of 8 pens, tile_spread[] puts its bits in the right place of the 8 nibbles.
+*/
+/* ******************************************************************************************************************/
+static void convert_tile_scalar ( Uint8* tile )
+{
+    Uint8 swap[128];
+    Uint32* gfxdata = ( Uint32* ) tile;
 
-        * ( gfxdata++ ) = dw;
-    }
+    memcpy ( swap, tile, 128 );
 
-    //if ((usage & ~1) == 0) pen_usage|=(TILE_INVISIBLE<<((tileno&0xF)*2));
-    /* @todo (Tmesys#1#12/16/2022): transpack support ? */
-    if ( ( usage & ~1 ) == 0 )
-    {
-        return ( TILE_INVISIBLE << ( ( tileno & 0xF ) * 2 ) );
-    }
-    else
+    for ( Sint32 y = 0; y < 16; y++ )
     {
-        return ( 0 );
+        const Uint8* right = &swap[64 + ( y << 2 )];
+        const Uint8* left = &swap[y << 2];
+
+        * ( gfxdata++ ) = tile_spread[right[0]] | ( tile_spread[right[2]] << 1 ) | ( tile_spread[right[1]] << 2 )
+                          | ( tile_spread[right[3]] << 3 );
+        * ( gfxdata++ ) = tile_spread[left[0]] | ( tile_spread[left[2]] << 1 ) | ( tile_spread[left[1]] << 2 )
+                          | ( tile_spread[left[3]] << 3 );
     }
 }
+
+#ifdef ROMS_SIMD_X86
 /* ******************************************************************************************************************/
 /*!
-* \brief  Converts all rom tiles.
+* \brief  Converts the bit planes of four tile rows to packed pens, SSSE3 version.
 *
-* \param  rom Todo.
+* \param  planes Four rows of four plane bytes.
+* \return One 32 bits word of 8 pens per row.
+* \note   Bytes are bit reversed with two nibble lookups, then each plane goes in its own 32 bits lanes where its
+*         8 bits are spread to one bit per nibble with three shift / mask steps.
 */
 /* ******************************************************************************************************************/
-static void convert_all_tile ( struct_gngeoxroms_game_roms* rom )
+TARGET_SSSE3 static inline __m128i convert_rows_ssse3 ( __m128i planes )
 {
-    allocate_region ( &rom->spr_usage, ( rom->rom_region[REGION_SPRITES].size >> 11 ) * sizeof ( Uint32 ), REGION_SPR_USAGE );
+    const __m128i nibble = _mm_set1_epi8 ( 0x0f );
+    const __m128i reverse_low = _mm_setr_epi8 ( 0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf );
+    const __m128i reverse_high = _mm_slli_epi16 ( reverse_low, 4 );
+    __m128i reversed;
+    /* Plane byte of each pen bit : bit 0 in byte 0, bit 1 in byte 2, bit 2 in byte 1, bit 3 in byte 3 */
+    __m128i spread[4] =
+    {
+        _mm_setr_epi8 ( 0, -1, -1, -1, 4, -1, -1, -1, 8, -1, -1, -1, 12, -1, -1, -1 ),
+        _mm_setr_epi8 ( 2, -1, -1, -1, 6, -1, -1, -1, 10, -1, -1, -1, 14, -1, -1, -1 ),
+        _mm_setr_epi8 ( 1, -1, -1, -1, 5, -1, -1, -1, 9, -1, -1, -1, 13, -1, -1, -1 ),
+        _mm_setr_epi8 ( 3, -1, -1, -1, 7, -1, -1, -1, 11, -1, -1, -1, 15, -1, -1, -1 )
+    };
 
-    for ( Uint32 i = 0; i < rom->rom_region[REGION_SPRITES].size >> 7; i++ )
+    reversed = _mm_or_si128 ( _mm_shuffle_epi8 ( reverse_high, _mm_and_si128 ( planes, nibble ) ),
+                              _mm_shuffle_epi8 ( reverse_low, _mm_and_si128 ( _mm_srli_epi16 ( planes, 4 ), nibble ) ) );
+
+    for ( Sint32 bit = 0; bit < 4; bit++ )
     {
-        ( ( Uint32* ) rom->spr_usage.p ) [i >> 4] |= convert_roms_tile ( rom->rom_region[REGION_SPRITES].p, i );
+        spread[bit] = _mm_shuffle_epi8 ( reversed, spread[bit] );
+        spread[bit] = _mm_and_si128 ( _mm_or_si128 ( spread[bit], _mm_slli_epi32 ( spread[bit], 12 ) ), _mm_set1_epi32 ( 0x000F000F ) );
+        spread[bit] = _mm_and_si128 ( _mm_or_si128 ( spread[bit], _mm_slli_epi32 ( spread[bit], 6 ) ), _mm_set1_epi32 ( 0x03030303 ) );
+        spread[bit] = _mm_and_si128 ( _mm_or_si128 ( spread[bit], _mm_slli_epi32 ( spread[bit], 3 ) ), _mm_set1_epi32 ( 0x11111111 ) );
     }
+
+    return ( _mm_or_si128 ( _mm_or_si128 ( spread[0], _mm_slli_epi32 ( spread[1], 1 ) ),
+                            _mm_or_si128 ( _mm_slli_epi32 ( spread[2], 2 ), _mm_slli_epi32 ( spread[3], 3 ) ) ) );
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Converts all rom chars.
+* \brief  Converts a rom tile from bit planes to packed pens, SSSE3 version.
 *
-* \param  ptr Todo.
-* \param  size Todo.
-* \param  usage_ptr Todo.
+* \param  tile Tile 128 bytes, converted in place.
+* \note   Right half rows are the 64 last bytes, each output row is the right half word then the left half one.
 */
 /* ******************************************************************************************************************/
-void convert_all_char ( enum_gngeoxroms_region_type region_type, Uint8* usage_ptr )
+TARGET_SSSE3 static void convert_tile_ssse3 ( Uint8* tile )
 {
-    Uint8 usage = 0;
-    Uint8* src = NULL;
-    Uint8* sav_src = NULL;
-    Uint8* ptr = neogeo_memory.rom.rom_region[region_type].p;
+    __m128i planes[8];
 
-    src = ( Uint8* ) qalloc ( neogeo_memory.rom.rom_region[region_type].size );
-    if ( src == NULL )
+    for ( Sint32 i = 0; i < 8; i++ )
     {
-        zlog_error ( gngeox_config.loggingCat, "Not enough memory ! Requesting %d bytes", neogeo_memory.rom.rom_region[region_type].size );
-        return;
+        planes[i] = _mm_loadu_si128 ( ( const __m128i* ) &tile[i << 4] );
     }
 
-    sav_src = src;
-    memcpy ( src, ptr, neogeo_memory.rom.rom_region[region_type].size );
-
-    for ( Sint32 i = neogeo_memory.rom.rom_region[region_type].size; i > 0; i -= 32 )
+    for ( Sint32 group = 0; group < 4; group++ )
     {
-        usage = 0;
-
-        for ( Sint32 j = 0; j < 8; j++ )
-        {
-#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
-            *ptr++ = * ( src + 8 );
-            usage |= * ( src + 8 );
-            *ptr++ = * ( src );
-            usage |= * ( src );
-            *ptr++ = * ( src + 24 );
-            usage |= * ( src + 24 );
-            *ptr++ = * ( src + 16 );
-            usage |= * ( src + 16 );
-            src++;
-#else
-            *ptr++ = * ( src + 16 );
-            usage |= * ( src + 16 );
-            *ptr++ = * ( src + 24 );
-            usage |= * ( src + 24 );
-            *ptr++ = * ( src );
-            usage |= * ( src );
-            *ptr++ = * ( src + 8 );
-            usage |= * ( src + 8 );
-            src++;
-#endif
-        }
+        __m128i right = convert_rows_ssse3 ( planes[group + 4] );
+        __m128i left = convert_rows_ssse3 ( planes[group] );
 
-        src += 24;
-        *usage_ptr++ = usage;
+        _mm_storeu_si128 ( ( __m128i* ) &tile[group << 5], _mm_unpacklo_epi32 ( right, left ) );
+        _mm_storeu_si128 ( ( __m128i* ) &tile[ ( group << 5 ) + 16], _mm_unpackhi_epi32 ( right, left ) );
     }
-
-    qalloc_delete ( sav_src );
 }
+#endif // ROMS_SIMD_X86
 /* ******************************************************************************************************************/
 /*!
-* \brief  Loads game.
-*
-* \param  name Todo.
+* \brief  Converts rom tiles.
 *
-* \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \param  gfx Todo.
+* \param  tileno Todo.
+* \param  rows Rows masks, bit y set when row y is empty, bit y + 16 set when it is opaque.
+*/
+/* ******************************************************************************************************************/
+static Sint32 convert_roms_tile ( Uint8* gfx, Sint32 tileno, Uint32* rows )
+{
+    Uint32* gfxdata = ( Uint32* ) & gfx[tileno << 7];
+    Uint32 usage = 0;
+
+    *rows = 0;
+
+    convert_tile ( &gfx[tileno << 7] );
+
+    for ( Sint32 y = 0; y < 16; y++ )
+    {
+        Uint32 right = gfxdata[y << 1], left = gfxdata[ ( y << 1 ) + 1];
+
+        usage |= right | left;
+
+        /* Some nibble is zero when a borrow reaches its top bit */
+        if ( ( right | left ) == 0 )
+        {
+            *rows |= ( 1 << y );
+        }
+        else if ( ( ( ( ( right - 0x11111111 ) & ~right ) | ( ( left - 0x11111111 ) & ~left ) ) & 0x88888888 ) == 0 )
+        {
+            *rows |= ( 0x10000 << y );
+        }
+    }
+
+    /* @todo (Tmesys#1#12/16/2022): transpack support ? */
+    if ( usage == 0 )
+    {
+        return ( TILE_INVISIBLE << ( ( tileno & 0xF ) * 2 ) );
+    }
+    else
+    {
+        return ( 0 );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts a part of the rom tiles.
+*
+* \param  data Conversion state.
+* \param  part Part index.
+* \note   Parts hold whole groups of 16 tiles, so each pen usage word is written by one part only.
+*/
+/* ******************************************************************************************************************/
+static void convert_tile_part ( void* data, Sint32 part )
+{
+    struct_gngeoxroms_convert* convert = ( struct_gngeoxroms_convert* ) data;
+    Uint32 groups = ( convert->nb_of_tiles + 15 ) >> 4;
+    Uint32 start = ( ( Uint64 ) groups * part / convert->nb_parts ) << 4;
+    Uint32 end = SDL_min ( ( ( Uint64 ) groups * ( part + 1 ) / convert->nb_parts ) << 4, convert->nb_of_tiles );
+    Uint32 rows = 0;
+
+    for ( Uint32 i = start; i < end; i++ )
+    {
+        convert->usage[i >> 4] |= convert_roms_tile ( convert->tiles, i, &rows );
+
+        if ( convert->rows != NULL )
+        {
+            convert->rows[i] = rows;
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Prepares sprite tiles conversion.
+*
+* \param  rom Todo.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool convert_tile_init ( struct_gngeoxroms_game_roms* rom )
+{
+    for ( Uint32 value = 0; value < 256; value++ )
+    {
+        tile_spread[value] = 0;
+
+        for ( Sint32 x = 0; x < 8; x++ )
+        {
+            tile_spread[value] |= ( ( value >> x ) & 1 ) << ( ( 7 - x ) << 2 );
+        }
+    }
+
+    convert_tile = convert_tile_scalar;
+
+#ifdef ROMS_SIMD_X86
+    __builtin_cpu_init();
+
+    if ( __builtin_cpu_supports ( "ssse3" ) )
+    {
+        convert_tile = convert_tile_ssse3;
+    }
+#endif // ROMS_SIMD_X86
+
+    /* 2 bits per tile, the last word may be partial */
+    if ( allocate_region ( &rom->spr_usage, ( ( ( rom->rom_region[REGION_SPRITES].size >> 7 ) + 15 ) >> 4 ) * sizeof ( Uint32 ), REGION_SPR_USAGE ) == SDL_FALSE )
+    {
+        return ( SDL_FALSE );
+    }
+
+    /* Without rows masks, the renderer tests each row itself */
+    if ( allocate_region ( &rom->spr_rows, ( rom->rom_region[REGION_SPRITES].size >> 7 ) * sizeof ( Uint32 ), REGION_SPR_ROWS ) == SDL_FALSE )
+    {
+        zlog_warn ( gngeox_config.loggingCat, "Sprite rows masks disabled" );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts all rom tiles.
+*
+* \param  rom Todo.
+* \note   Tiles are shared between the worker threads.
+*/
+/* ******************************************************************************************************************/
+static void convert_all_tile ( struct_gngeoxroms_game_roms* rom )
+{
+    struct_gngeoxroms_convert convert;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+
+    if ( convert_tile_init ( rom ) == SDL_FALSE )
+    {
+        return;
+    }
+
+    SDL_zero ( convert );
+    convert.tiles = rom->rom_region[REGION_SPRITES].p;
+    convert.usage = ( Uint32* ) rom->spr_usage.p;
+    convert.rows = ( Uint32* ) rom->spr_rows.p;
+    convert.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
+    convert.nb_parts = neo_workers_count() * 4;
+
+    neo_workers_run ( convert_tile_part, &convert, convert.nb_parts );
+
+    zlog_info ( gngeox_config.loggingCat, "Sprite tiles converted in %.1f ms (%s)", load_stage_ms ( ticks ),
+                ( convert_tile == convert_tile_scalar ) ? "scalar" : "SSSE3" );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts the tiles of a fully loaded sprites block.
+*
+* \param  block Block index.
+*/
+/* ******************************************************************************************************************/
+static void load_convert_block ( Uint32 block )
+{
+    struct_gngeoxroms_convert* convert = &load_pipeline.convert;
+    Uint32 start = block << ( LOAD_BLOCK_SHIFT - 7 );
+    Uint32 end = SDL_min ( start + ( 1 << ( LOAD_BLOCK_SHIFT - 7 ) ), convert->nb_of_tiles );
+    Uint32 rows = 0;
+
+    for ( Uint32 i = start; i < end; i++ )
+    {
+        convert->usage[i >> 4] |= convert_roms_tile ( convert->tiles, i, &rows );
+
+        if ( convert->rows != NULL )
+        {
+            convert->rows[i] = rows;
+        }
+    }
+
+    load_pipeline.converted[block] = 1;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Counts sprite bytes interleaved in the region.
+*
+* \param  dst Region first byte.
+* \param  size Number of bytes, every other byte from dst.
+* \note   Queues the blocks that got all their bytes, files can be loaded at the same time.
+*/
+/* ******************************************************************************************************************/
+static void load_pipeline_loaded ( Uint8* dst, Uint32 size )
+{
+    Uint32 offset = dst - load_pipeline.convert.tiles;
+
+    while ( size )
+    {
+        Uint32 block = offset >> LOAD_BLOCK_SHIFT;
+        Sint32 block_size = SDL_min ( load_pipeline.region_size - ( block << LOAD_BLOCK_SHIFT ), 1 << LOAD_BLOCK_SHIFT );
+        Sint32 count = SDL_min ( ( ( ( block + 1 ) << LOAD_BLOCK_SHIFT ) - offset + 1 ) >> 1, size );
+
+        offset += count << 1;
+        size -= count;
+
+        if ( SDL_AtomicAdd ( &load_pipeline.loaded[block], count ) + count == block_size )
+        {
+            SDL_LockMutex ( load_pipeline.lock );
+            load_pipeline.queue[load_pipeline.nb_queued++] = block;
+            SDL_UnlockMutex ( load_pipeline.lock );
+            SDL_SemPost ( load_pipeline.ready );
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts sprite blocks as they get loaded.
+*
+* \param  data Unused.
+* \return Thread exit code.
+*/
+/* ******************************************************************************************************************/
+static int load_convert_thread ( void* data )
+{
+    Uint32 head = 0;
+
+    ( void ) data;
+
+    while ( 1 )
+    {
+        Uint32 block = 0;
+
+        SDL_SemWait ( load_pipeline.ready );
+
+        SDL_LockMutex ( load_pipeline.lock );
+        block = load_pipeline.queue[head++];
+        SDL_UnlockMutex ( load_pipeline.lock );
+
+        if ( block == LOAD_BLOCK_END )
+        {
+            break;
+        }
+
+        load_convert_block ( block );
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Tells if sprites can be converted while loading.
+*
+* \param  rom Todo.
+* \param  drv Todo.
+* \return SDL_TRUE when they can, SDL_FALSE when the whole region is needed first.
+* \note   Sprites decryption works on the whole region, sprites are converted after it. Other regions decryption
+*         and patches do not matter here. A block is complete once it got all its bytes, so sprite files must not
+*         overlap.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool load_pipeline_usable ( struct_gngeoxroms_game_roms* rom, struct_gngeoxdrivers_rom_def* drv )
+{
+    if ( ( rom->rom_region[REGION_SPRITES].size == 0 ) || ( init_roms_sprites_needed ( rom ) == SDL_TRUE ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    for ( Uint32 i = 0; i < drv->nb_romfile; i++ )
+    {
+        for ( Uint32 j = i + 1; ( j < drv->nb_romfile ) && ( drv->rom[i].region == REGION_SPRITES ); j++ )
+        {
+            if ( load_entries_overlap ( drv, i, j ) == SDL_TRUE )
+            {
+                zlog_info ( gngeox_config.loggingCat, "Sprite files %s and %s overlap", drv->rom[i].filename->data, drv->rom[j].filename->data );
+                return ( SDL_FALSE );
+            }
+        }
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Starts the load pipeline threads.
+*
+* \param  rom Todo.
+* \param  drv Todo.
+* \return SDL_TRUE when sprites get converted while loading, SDL_FALSE otherwise.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool load_pipeline_start ( struct_gngeoxroms_game_roms* rom, struct_gngeoxdrivers_rom_def* drv )
+{
+    SDL_zero ( load_pipeline );
+
+    if ( load_pipeline_usable ( rom, drv ) == SDL_FALSE )
+    {
+        return ( SDL_FALSE );
+    }
+
+    load_pipeline.region_size = rom->rom_region[REGION_SPRITES].size;
+    load_pipeline.nb_blocks = ( load_pipeline.region_size + ( 1 << LOAD_BLOCK_SHIFT ) - 1 ) >> LOAD_BLOCK_SHIFT;
+    load_pipeline.loaded = ( SDL_atomic_t* ) qalloc ( load_pipeline.nb_blocks * sizeof ( SDL_atomic_t ) );
+    load_pipeline.queue = ( Uint32* ) qalloc ( ( load_pipeline.nb_blocks + 1 ) * sizeof ( Uint32 ) );
+    load_pipeline.converted = ( Uint8* ) qalloc ( load_pipeline.nb_blocks );
+    load_pipeline.ready = SDL_CreateSemaphore ( 0 );
+    load_pipeline.lock = SDL_CreateMutex();
+
+    if ( ( load_pipeline.loaded == NULL ) || ( load_pipeline.queue == NULL ) || ( load_pipeline.converted == NULL )
+            || ( load_pipeline.ready == NULL ) || ( load_pipeline.lock == NULL ) || ( convert_tile_init ( rom ) == SDL_FALSE ) )
+    {
+        load_pipeline_stop();
+        return ( SDL_FALSE );
+    }
+
+    load_pipeline.convert.tiles = rom->rom_region[REGION_SPRITES].p;
+    load_pipeline.convert.usage = ( Uint32* ) rom->spr_usage.p;
+    load_pipeline.convert.rows = ( Uint32* ) rom->spr_rows.p;
+    load_pipeline.convert.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
+
+    load_pipeline.convert_thread = SDL_CreateThread ( load_convert_thread, "GnGeoXconvert", NULL );
+
+    if ( load_pipeline.convert_thread == NULL )
+    {
+        zlog_warn ( gngeox_config.loggingCat, "Load pipeline not started : %s", SDL_GetError() );
+        load_pipeline_stop();
+        free_region ( &rom->spr_usage );
+        free_region ( &rom->spr_rows );
+        return ( SDL_FALSE );
+    }
+
+    load_streaming = SDL_TRUE;
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Waits for the load pipeline thread.
+*
+* \note   Blocks already queued are still converted.
+*/
+/* ******************************************************************************************************************/
+static void load_pipeline_join ( void )
+{
+    if ( load_pipeline.convert_thread != NULL )
+    {
+        SDL_LockMutex ( load_pipeline.lock );
+        load_pipeline.queue[load_pipeline.nb_queued++] = LOAD_BLOCK_END;
+        SDL_UnlockMutex ( load_pipeline.lock );
+        SDL_SemPost ( load_pipeline.ready );
+
+        SDL_WaitThread ( load_pipeline.convert_thread, NULL );
+        load_pipeline.convert_thread = NULL;
+    }
+
+    load_streaming = SDL_FALSE;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Stops the load pipeline.
+*
+*/
+/* ******************************************************************************************************************/
+static void load_pipeline_stop ( void )
+{
+    load_pipeline_join();
+
+    if ( load_pipeline.ready != NULL )
+    {
+        SDL_DestroySemaphore ( load_pipeline.ready );
+    }
+
+    if ( load_pipeline.lock != NULL )
+    {
+        SDL_DestroyMutex ( load_pipeline.lock );
+    }
+
+    qalloc_delete ( load_pipeline.loaded );
+    qalloc_delete ( load_pipeline.queue );
+    qalloc_delete ( load_pipeline.converted );
+
+    SDL_zero ( load_pipeline );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Waits for the load pipeline and converts the blocks it could not.
+*
+* \note   Blocks stay incomplete when sprite files are shorter than expected.
+*/
+/* ******************************************************************************************************************/
+static void load_pipeline_finish ( void )
+{
+    Uint32 left = 0;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+
+    load_pipeline_join();
+
+    for ( Uint32 block = 0; block < load_pipeline.nb_blocks; block++ )
+    {
+        if ( load_pipeline.converted[block] == 0 )
+        {
+            load_convert_block ( block );
+            left++;
+        }
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Sprite tiles converted while loading, %u of %u blocks after it in %.1f ms (%s)",
+                left, load_pipeline.nb_blocks, load_stage_ms ( ticks ), ( convert_tile == convert_tile_scalar ) ? "scalar" : "SSSE3" );
+
+    load_pipeline_stop();
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decrypts and patches the roms, sprites apart.
+*
+* \param  data Game roms.
+* \return Thread exit code.
+*/
+/* ******************************************************************************************************************/
+static int load_init_thread ( void* data )
+{
+    init_roms ( ( struct_gngeoxroms_game_roms* ) data );
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decrypts and patches the loaded roms, then converts the sprites left.
+*
+* \param  rom Game roms.
+* \param  streaming Sprites converted by the load pipeline.
+* \note   Program and audio regions are decrypted while the load pipeline converts its last blocks. Otherwise a
+*         thread decrypts them while the workers decrypt and convert the whole sprites region.
+*/
+/* ******************************************************************************************************************/
+static void init_all_roms ( struct_gngeoxroms_game_roms* rom, SDL_bool streaming )
+{
+    SDL_Thread* thread = NULL;
+
+    if ( streaming == SDL_TRUE )
+    {
+        init_roms ( rom );
+        load_pipeline_finish();
+        return;
+    }
+
+    thread = SDL_CreateThread ( load_init_thread, "GnGeoXinit", rom );
+    if ( thread == NULL )
+    {
+        init_roms ( rom );
+    }
+
+    init_roms_sprites ( rom );
+    convert_all_tile ( rom );
+
+    if ( thread != NULL )
+    {
+        SDL_WaitThread ( thread, NULL );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Hashes a sprite tile.
+*
+* \param  tile Tile 128 bytes.
+* \return Tile hash.
+*/
+/* ******************************************************************************************************************/
+static Uint64 dedup_tile_hash ( const Uint8* tile )
+{
+    Uint64 hash = 0x9E3779B97F4A7C15ULL;
+
+    for ( Sint32 i = 0; i < 16; i++ )
+    {
+        Uint64 word = 0;
+
+        /* Regions are not 8 bytes aligned */
+        memcpy ( &word, &tile[i << 3], sizeof ( Uint64 ) );
+        hash = ( hash ^ word ) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    return ( hash );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Hashes a part of the sprite tiles.
+*
+* \param  data Deduplication state.
+* \param  part Part index.
+*/
+/* ******************************************************************************************************************/
+static void dedup_hash_part ( void* data, Sint32 part )
+{
+    struct_gngeoxroms_dedup* dedup = ( struct_gngeoxroms_dedup* ) data;
+    Uint32 start = ( Uint64 ) dedup->nb_of_tiles * part / dedup->nb_parts;
+    Uint32 end = ( Uint64 ) dedup->nb_of_tiles * ( part + 1 ) / dedup->nb_parts;
+
+    for ( Uint32 tile = start; tile < end; tile++ )
+    {
+        dedup->hashes[tile] = dedup_tile_hash ( &dedup->tiles[tile << 7] );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Keeps only one copy of identical sprite tiles.
+*
+* \param  rom Game roms.
+* \note   Tiles are hashed by the worker threads, then looked up in an open addressing table whose entries are
+*         the first loaded tile of each content. Unique tiles are then moved down in place, in first occurrence
+*         order, and the sprites region is shrunk to them, padded to a whole 4KB block for the .gno dump.
+*         spr_remap gives the unique tile of each tile number. Pen usage and rows masks stay indexed by tile number.
+*         Hashes and table are freed before the move, so the work memory stays around a quarter of the region.
+*         Nothing changes when memory is short or when no tile is shared.
+*/
+/* ******************************************************************************************************************/
+static void dedup_all_tile ( struct_gngeoxroms_game_roms* rom )
+{
+    struct_gngeoxroms_dedup dedup;
+    Uint8* tiles = NULL;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+    Uint32* table = NULL;
+    Uint32* first = NULL;
+    Uint32* remap = NULL;
+    Uint32 table_mask = 1, padded = 0;
+
+    SDL_zero ( dedup );
+
+    dedup.tiles = rom->rom_region[REGION_SPRITES].p;
+    dedup.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
+    dedup.nb_parts = neo_workers_count();
+
+    if ( dedup.nb_of_tiles == 0 )
+    {
+        return;
+    }
+
+    /* At most half full */
+    while ( table_mask < ( dedup.nb_of_tiles << 1 ) )
+    {
+        table_mask <<= 1;
+    }
+
+    dedup.hashes = ( Uint64* ) qalloc ( dedup.nb_of_tiles * sizeof ( Uint64 ) );
+    table = ( Uint32* ) qalloc ( table_mask * sizeof ( Uint32 ) );
+    first = ( Uint32* ) qalloc ( dedup.nb_of_tiles * sizeof ( Uint32 ) );
+    table_mask--;
+
+    if ( ( dedup.hashes == NULL ) || ( table == NULL ) || ( first == NULL )
+            || ( allocate_region ( &rom->spr_remap, dedup.nb_of_tiles * sizeof ( Uint32 ), REGION_SPR_REMAP ) == SDL_FALSE ) )
+    {
+        zlog_warn ( gngeox_config.loggingCat, "Sprite tiles deduplication skipped, not enough memory" );
+        goto cleanup;
+    }
+
+    remap = ( Uint32* ) rom->spr_remap.p;
+
+    neo_workers_run ( dedup_hash_part, &dedup, dedup.nb_parts );
+
+    /* Table entries are unique tile + 1, zero when free */
+    for ( Uint32 tile = 0; tile < dedup.nb_of_tiles; tile++ )
+    {
+        Uint64 hash = dedup.hashes[tile];
+        Uint32 slot = hash & table_mask;
+
+        while ( table[slot] != 0 )
+        {
+            Uint32 other = first[table[slot] - 1];
+
+            if ( ( dedup.hashes[other] == hash ) && ( memcmp ( &dedup.tiles[other << 7], &dedup.tiles[tile << 7], 128 ) == 0 ) )
+            {
+                break;
+            }
+
+            slot = ( slot + 1 ) & table_mask;
+        }
+
+        if ( table[slot] == 0 )
+        {
+            first[dedup.nb_of_unique] = tile;
+            table[slot] = ++dedup.nb_of_unique;
+        }
+
+        remap[tile] = table[slot] - 1;
+    }
+
+    /* Only remap and first are needed from here */
+    qalloc_delete ( dedup.hashes );
+    qalloc_delete ( table );
+    dedup.hashes = NULL;
+    table = NULL;
+
+    padded = ( dedup.nb_of_unique + 31 ) & ~31;
+
+    /* The remap table costs 4 bytes per tile */
+    if ( ( padded >= dedup.nb_of_tiles ) || ( ( ( dedup.nb_of_tiles - padded ) << 5 ) <= dedup.nb_of_tiles ) )
+    {
+        zlog_info ( gngeox_config.loggingCat, "Sprite tiles : %u unique of %u, not worth it", dedup.nb_of_unique,
+                    dedup.nb_of_tiles );
+        free_region ( &rom->spr_remap );
+        goto cleanup;
+    }
+
+    tiles = rom->rom_region[REGION_SPRITES].p;
+
+    /* first[unique] >= unique, so a tile is always moved down over one already moved or duplicated */
+    for ( Uint32 unique = 0; unique < dedup.nb_of_unique; unique++ )
+    {
+        if ( first[unique] != unique )
+        {
+            memmove ( &tiles[unique << 7], &tiles[first[unique] << 7], 128 );
+        }
+    }
+
+    /* Padding tiles are empty, as in a new region */
+    memset ( &tiles[dedup.nb_of_unique << 7], 0, ( padded - dedup.nb_of_unique ) << 7 );
+
+    tiles = ( Uint8* ) qalloc_resize ( rom->rom_region[REGION_SPRITES].p, padded << 7 );
+    if ( tiles == NULL )
+    {
+        /* Still right, the tiles past the padding are just never used */
+        zlog_warn ( gngeox_config.loggingCat, "Sprite tiles : unable to shrink the region" );
+    }
+    else
+    {
+        rom->rom_region[REGION_SPRITES].p = tiles;
+        rom->rom_region[REGION_SPRITES].size = padded << 7;
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Sprite tiles : %u unique of %u, %u KB saved in %.1f ms", dedup.nb_of_unique,
+                dedup.nb_of_tiles, ( ( ( dedup.nb_of_tiles - padded ) << 7 ) - ( dedup.nb_of_tiles << 2 ) ) >> 10,
+                load_stage_ms ( ticks ) );
+
+cleanup:
+    qalloc_delete ( dedup.hashes );
+    qalloc_delete ( table );
+    qalloc_delete ( first );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts all rom chars.
+*
+* \param  region_type Fix layer region.
+* \param  usage_ptr Usage of each char, zero when empty.
+* \note   Chars are converted in place, one 32 bytes char at a time.
+*/
+/* ******************************************************************************************************************/
+void convert_all_char ( enum_gngeoxroms_region_type region_type, Uint8* usage_ptr )
+{
+    Uint64 ticks = SDL_GetPerformanceCounter();
+    Uint8* ptr = neogeo_memory.rom.rom_region[region_type].p;
+    Uint8 src[32];
+
+    for ( Sint32 i = neogeo_memory.rom.rom_region[region_type].size; i >= 32; i -= 32 )
+    {
+        Uint8 usage = 0;
+
+        memcpy ( src, ptr, 32 );
+
+        for ( Sint32 j = 0; j < 8; j++ )
+        {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            *ptr++ = src[j + 8];
+            *ptr++ = src[j];
+            *ptr++ = src[j + 24];
+            *ptr++ = src[j + 16];
+#else
+            *ptr++ = src[j + 16];
+            *ptr++ = src[j + 24];
+            *ptr++ = src[j];
+            *ptr++ = src[j + 8];
+#endif
+            usage |= src[j] | src[j + 8] | src[j + 16] | src[j + 24];
+        }
+
+        *usage_ptr++ = usage;
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Fix chars of %s converted in %.1f ms", neo_rom_region_name[region_type],
+                load_stage_ms ( ticks ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Loads game.
+*
+* \param  name Todo.
+*
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
 */
 /* ******************************************************************************************************************/
 static SDL_bool dr_load_game ( char* name )
@@ -677,8 +1650,9 @@ static void dr_free_roms ( struct_gngeoxroms_game_roms* rom )
     }
     else
     {
-        fclose ( neogeo_memory.vid.spr_cache.gno );
+        /* The prefetch thread may still read the file */
         free_sprite_cache();
+        fclose ( neogeo_memory.vid.spr_cache.gno );
         qalloc_delete ( neogeo_memory.vid.spr_cache.offset );
     }
 
@@ -704,6 +1678,8 @@ static void dr_free_roms ( struct_gngeoxroms_game_roms* rom )
     qalloc_delete ( neogeo_memory.fix_game_usage );
 
     free_region ( &rom->spr_usage );
+    free_region ( &rom->spr_rows );
+    free_region ( &rom->spr_remap );
 
     qalloc_delete ( rom->info.name );
     qalloc_delete ( rom->info.longname );
@@ -758,6 +1734,11 @@ SDL_bool init_game ( char* rom_name )
         }
     }
 
+    if ( neo_transpack_usage_init ( ( Uint32* ) neogeo_memory.rom.spr_usage.p, neogeo_memory.nb_of_tiles ) == SDL_FALSE )
+    {
+        return ( SDL_FALSE );
+    }
+
     open_nvram ( );
     open_memcard ( );
 
@@ -780,6 +1761,101 @@ SDL_bool init_game ( char* rom_name )
 
     return ( SDL_TRUE );
 }
+/* ******************************************************************************************************************/
+/*!
+* \brief  Benchmarks the rom files loading, with a cold then a warm page cache.
+*
+* \note   Only the zip reading is timed, no decryption, tile conversion or bios. Runs before init_game(), so that only
+*         one copy of the regions is allocated at a time.
+*/
+/* ******************************************************************************************************************/
+void benchmark_roms_load ( void )
+{
+    struct_gngeoxroms_game_roms rom;
+    struct_gngeoxdrivers_rom_def* drv = NULL;
+    qzip_file_t* zip_file = NULL;
+    SDL_bool loaded = SDL_FALSE, cold = SDL_FALSE;
+    double cold_ms = 0.0, warm_ms = 0.0, ms = 0.0;
+    Uint64 ticks = 0;
+
+    drv = neo_driver_load ( gngeox_config.gamename );
+    if ( drv == NULL )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Rom files benchmark needs a zip game" );
+        return;
+    }
+
+    for ( Sint32 run = 0; run <= LOAD_BENCH_RUNS; run++ )
+    {
+        SDL_zero ( rom );
+
+        for ( Uint32 i = 0; i < REGION_MAX; i++ )
+        {
+            if ( allocate_region ( &rom.rom_region[i], drv->romsize[i], i ) == SDL_FALSE )
+            {
+                zlog_error ( gngeox_config.loggingCat, "Rom files benchmark : not enough memory for the regions" );
+                goto error1;
+            }
+        }
+
+        if ( run == 0 )
+        {
+            cold = load_bench_evict ( gngeox_config.gamename );
+
+            if ( biseqcstrcaseless ( drv->parent, "neogeo" ) == 0 )
+            {
+                cold = ( load_bench_evict ( ( const char* ) drv->parent->data ) == SDL_TRUE ) ? cold : SDL_FALSE;
+            }
+        }
+
+        ticks = SDL_GetPerformanceCounter();
+
+        zip_file = open_rom_zip ( gngeox_config.rompath, gngeox_config.gamename );
+        loaded = ( zip_file != NULL ) ? load_entries ( zip_file, &rom, drv ) : SDL_FALSE;
+
+        if ( zip_file != NULL )
+        {
+            qzip_close_file ( zip_file );
+        }
+
+        ms = load_stage_ms ( ticks );
+
+        for ( Uint32 i = 0; i < REGION_MAX; i++ )
+        {
+            free_region ( &rom.rom_region[i] );
+        }
+
+        if ( loaded == SDL_FALSE )
+        {
+            zlog_error ( gngeox_config.loggingCat, "Rom files benchmark : loading failed" );
+            neo_driver_free ( drv );
+            return;
+        }
+
+        if ( run == 0 )
+        {
+            cold_ms = ms;
+        }
+        else if ( ( run == 1 ) || ( ms < warm_ms ) )
+        {
+            warm_ms = ms;
+        }
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Rom files loaded in %.1f ms with a %s page cache, %.1f ms warm (best of %d)", cold_ms,
+                ( cold == SDL_TRUE ) ? "cold" : "partly warm", warm_ms, LOAD_BENCH_RUNS );
+
+    neo_driver_free ( drv );
+    return;
+
+error1:
+    for ( Uint32 i = 0; i < REGION_MAX; i++ )
+    {
+        free_region ( &rom.rom_region[i] );
+    }
+
+    neo_driver_free ( drv );
+}
 
 #ifdef _GNGEOX_ROMS_C_
 #undef _GNGEOX_ROMS_C_
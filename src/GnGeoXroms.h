@@ -27,6 +27,11 @@
 #define HAS_CUSTOM_AUDIO_BIOS 0x2
 
 #define LOAD_BUF_SIZE (128*1024)
+/* Load pipeline sprite blocks of 512 tiles */
+#define LOAD_BLOCK_SHIFT 16
+#define LOAD_BLOCK_END 0xFFFFFFFF
+/* Rom files loading benchmark, runs with a warm page cache after the cold one */
+#define LOAD_BENCH_RUNS 3
 
 typedef enum
 {
@@ -42,6 +47,8 @@ typedef enum
     REGION_SPRITES               = 9,
     REGION_MAX                   = 10,
     REGION_SPR_USAGE             = 11,
+    REGION_SPR_ROWS              = 12,
+    REGION_SPR_REMAP             = 13,
 } enum_gngeoxroms_region_type;
 
 typedef struct
@@ -65,18 +72,98 @@ typedef struct struct_gngeoxroms_game_roms
     struct_gngeoxroms_game_info info;
     struct_gngeoxroms_rom_region rom_region[REGION_MAX];
     struct_gngeoxroms_rom_region spr_usage;
+    struct_gngeoxroms_rom_region spr_rows;
+    struct_gngeoxroms_rom_region spr_remap;
 } struct_gngeoxroms_game_roms;
 
+/* Tile 128 bytes, converted in place */
+typedef void ( *tile_convert_kernel ) ( Uint8* );
+/* Bytes to even destination bytes, odd ones left as they are */
+typedef void ( *load_interleave_kernel ) ( Uint8*, const Uint8*, Uint32 );
+
+typedef struct
+{
+    Uint8* tiles;           /* Sprite tiles, converted in place */
+    Uint32* usage;          /* Pen usage, 2 bits per tile */
+    Uint32* rows;           /* Rows masks, NULL when not kept */
+    Uint32 nb_of_tiles;
+    Sint32 nb_parts;
+} struct_gngeoxroms_convert;
+
+typedef struct
+{
+    SDL_Thread* convert_thread; /* Converts the sprite blocks once fully loaded */
+    SDL_sem* ready;         /* Blocks to convert */
+    SDL_mutex* lock;        /* Blocks queue */
+    SDL_atomic_t* loaded;   /* Bytes loaded in each block */
+    Uint32* queue;          /* Fully loaded blocks, then LOAD_BLOCK_END */
+    Uint32 nb_queued;
+    Uint8* converted;       /* Converted blocks */
+    Uint32 nb_blocks;
+    Uint32 region_size;
+    struct_gngeoxroms_convert convert;
+} struct_gngeoxroms_load_pipeline;
+
+typedef struct
+{
+    load_interleave_kernel kernel;
+    Uint8* base;            /* Sprites region */
+    SDL_SpinLock* locks;    /* Lock of each sprites block when both lanes load at the same time, NULL otherwise */
+} struct_gngeoxroms_load_interleave;
+
+typedef struct
+{
+    const Uint8* tiles;     /* Sprite tiles as loaded */
+    Uint64* hashes;         /* Hash of each loaded tile */
+    Uint32 nb_of_tiles;
+    Uint32 nb_of_unique;
+    Sint32 nb_parts;
+} struct_gngeoxroms_dedup;
+
 
 #ifdef _GNGEOX_ROMS_C_
+/* Needs GnGeoXdrivers.h, which only the roms code includes before this header */
+typedef struct
+{
+    struct_gngeoxroms_game_roms* rom;
+    struct_gngeoxdrivers_rom_def* drv;
+    qzip_file_t* zip;       /* Game zip, shared by the parts */
+    Uint32 order[32];       /* Rom files, biggest first */
+    SDL_atomic_t failed;
+} struct_gngeoxroms_load_entries;
+
 static void setup_misc_patch ( void );
 static void free_region ( struct_gngeoxroms_rom_region* );
+static void load_interleave_scalar ( Uint8*, const Uint8*, Uint32 );
+static void load_interleave_lanes ( Uint8*, const Uint8*, Uint32 );
 static SDL_bool read_data_i ( qzip_entry_t*, struct_gngeoxroms_rom_region*, Uint32, Uint32 ) __attribute__ ( ( warn_unused_result ) );
 static SDL_bool read_data_p ( qzip_entry_t*, struct_gngeoxroms_rom_region*, struct_gngeoxdrivers_rom_file ) __attribute__ ( ( warn_unused_result ) );
 static SDL_bool load_region ( qzip_file_t*, struct_gngeoxroms_game_roms*, struct_gngeoxdrivers_rom_def*, Sint32 ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool load_entry ( qzip_file_t*, struct_gngeoxroms_game_roms*, struct_gngeoxdrivers_rom_def*, Sint32 ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool load_entries_overlap ( struct_gngeoxdrivers_rom_def*, Uint32, Uint32 ) __attribute__ ( ( warn_unused_result ) );
+static void load_entry_part ( void*, Sint32 );
+static SDL_bool load_entries ( qzip_file_t*, struct_gngeoxroms_game_roms*, struct_gngeoxdrivers_rom_def* ) __attribute__ ( ( warn_unused_result ) );
+static double load_stage_ms ( Uint64 ) __attribute__ ( ( warn_unused_result ) );
 static qzip_file_t* open_rom_zip ( const char*, const char* ) __attribute__ ( ( warn_unused_result ) );
-static Sint32 convert_roms_tile ( Uint8*, Sint32 ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool load_bench_evict ( const char* ) __attribute__ ( ( warn_unused_result ) );
+static void convert_tile_scalar ( Uint8* );
+static Sint32 convert_roms_tile ( Uint8*, Sint32, Uint32* ) __attribute__ ( ( warn_unused_result ) );
+static void convert_tile_part ( void*, Sint32 );
+static SDL_bool convert_tile_init ( struct_gngeoxroms_game_roms* ) __attribute__ ( ( warn_unused_result ) );
 static void convert_all_tile ( struct_gngeoxroms_game_roms* );
+static void load_convert_block ( Uint32 );
+static void load_pipeline_loaded ( Uint8*, Uint32 );
+static int load_convert_thread ( void* );
+static SDL_bool load_pipeline_usable ( struct_gngeoxroms_game_roms*, struct_gngeoxdrivers_rom_def* ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool load_pipeline_start ( struct_gngeoxroms_game_roms*, struct_gngeoxdrivers_rom_def* ) __attribute__ ( ( warn_unused_result ) );
+static void load_pipeline_join ( void );
+static void load_pipeline_stop ( void );
+static void load_pipeline_finish ( void );
+static int load_init_thread ( void* );
+static void init_all_roms ( struct_gngeoxroms_game_roms*, SDL_bool );
+static Uint64 dedup_tile_hash ( const Uint8* ) __attribute__ ( ( warn_unused_result ) );
+static void dedup_hash_part ( void*, Sint32 );
+static void dedup_all_tile ( struct_gngeoxroms_game_roms* );
 static SDL_bool dr_load_roms ( struct_gngeoxroms_game_roms* ) __attribute__ ( ( warn_unused_result ) );
 static SDL_bool dr_load_game ( char* ) __attribute__ ( ( warn_unused_result ) );
 static void dr_free_roms ( struct_gngeoxroms_game_roms* );
@@ -89,5 +176,6 @@ SDL_bool allocate_region ( struct_gngeoxroms_rom_region*, Uint32, enum_gngeoxrom
 void convert_all_char ( enum_gngeoxroms_region_type, Uint8* );
 SDL_bool init_game ( char* ) __attribute__ ( ( warn_unused_result ) );
 void close_game ( void );
+void benchmark_roms_load ( void );
 
 #endif
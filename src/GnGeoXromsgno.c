@@ -58,7 +58,12 @@ static SDL_bool dump_region ( FILE* gno, const struct_gngeoxroms_rom_region* rom
     if ( type == 0 )
     {
         zlog_info ( gngeox_config.loggingCat, "Dump region id %d size %d", idx, rom_region->size );
-        fwrite ( rom_region->p, rom_region->size, 1, gno );
+
+        if ( fwrite ( rom_region->p, rom_region->size, 1, gno ) != 1 )
+        {
+            zlog_error ( gngeox_config.loggingCat, "Unable to write region id %d", idx );
+            return ( SDL_FALSE );
+        }
     }
     else
     {
@@ -173,6 +178,16 @@ SDL_bool dr_save_gno ( struct_gngeoxroms_game_roms* rom, const char* filename )
         nb_sec += 2;
     }
 
+    if ( rom->spr_rows.p )
+    {
+        nb_sec++;
+    }
+
+    if ( rom->spr_remap.p )
+    {
+        nb_sec++;
+    }
+
     if ( rom->rom_region[REGION_FIXED_LAYER_CARTRIDGE].p )
     {
         nb_sec++;
@@ -204,6 +219,23 @@ SDL_bool dr_save_gno ( struct_gngeoxroms_game_roms* rom, const char* filename )
     dump_region ( gno_file, &rom->rom_region[REGION_FIXED_LAYER_CARTRIDGE], REGION_FIXED_LAYER_CARTRIDGE, 0, 0 );
     dump_region ( gno_file, &rom->spr_usage, REGION_SPR_USAGE, 0, 0 );
 
+    if ( rom->spr_rows.p )
+    {
+        if ( dump_region ( gno_file, &rom->spr_rows, REGION_SPR_ROWS, 0, 0 ) == SDL_FALSE )
+        {
+            goto error1;
+        }
+    }
+
+    /* Deduplicated sprites are unusable without their remap table */
+    if ( rom->spr_remap.p )
+    {
+        if ( dump_region ( gno_file, &rom->spr_remap, REGION_SPR_REMAP, 0, 0 ) == SDL_FALSE )
+        {
+            goto error1;
+        }
+    }
+
     if ( ( rom->info.flags & HAS_CUSTOM_CPU_BIOS ) )
     {
         dump_region ( gno_file, &rom->rom_region[REGION_MAIN_CPU_BIOS], REGION_MAIN_CPU_BIOS, 0, 0 );
@@ -215,6 +247,14 @@ SDL_bool dr_save_gno ( struct_gngeoxroms_game_roms* rom, const char* filename )
     fclose ( gno_file );
 
     return ( SDL_TRUE );
+
+error1:
+    /* A partial dump would still look like a valid gno */
+    zlog_error ( gngeox_config.loggingCat, "Unable to save %s", filename );
+    fclose ( gno_file );
+    remove ( filename );
+
+    return ( SDL_FALSE );
 }
 /* ******************************************************************************************************************/
 /*!
@@ -283,6 +323,18 @@ static SDL_bool read_region ( FILE* gno, struct_gngeoxroms_game_roms* roms )
         }
         break;
 
+    case ( REGION_SPR_ROWS ) :
+        {
+            rom_region = &roms->spr_rows;
+        }
+        break;
+
+    case ( REGION_SPR_REMAP ) :
+        {
+            rom_region = &roms->spr_remap;
+        }
+        break;
+
     case ( REGION_FIXED_LAYER_BIOS ) :
         {
             rom_region = &roms->rom_region[REGION_FIXED_LAYER_BIOS];
@@ -404,7 +456,15 @@ Sint32 dr_open_gno ( const char* filename )
         rom->rom_region[REGION_AUDIO_DATA_2].size = rom->rom_region[REGION_AUDIO_DATA_1].size;
     }
 
-    neogeo_memory.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
+    /* Deduplicated sprites hold less tiles than the game uses */
+    if ( rom->spr_remap.p != NULL )
+    {
+        neogeo_memory.nb_of_tiles = rom->spr_remap.size / sizeof ( Uint32 );
+    }
+    else
+    {
+        neogeo_memory.nb_of_tiles = rom->rom_region[REGION_SPRITES].size >> 7;
+    }
 
     /* Init rom and bios */
     init_roms ( rom );
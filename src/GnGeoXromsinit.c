@@ -119,42 +119,43 @@ static Sint32 bankoffset_kof2000[64] =
 
 static Uint8 scramblecode_kof2000[7] = {0xEC, 15, 14, 7, 3, 10, 5,};
 
+/* Sprite decryption needs the whole region, the other regions are decrypted by init */
 struct_gngeoxroms_init_func init_func_table[] =
 {
-    { "kof99", init_kof99},
-    { "kof99n", init_kof99n},
-    { "garou", init_garou},
-    { "garouo", init_garouo},
-    { "garoubl", init_garoubl},
-    { "mslug3", init_mslug3},
-    { "mslug3h", init_mslug3h},
-    { "mslug3n", init_mslug3h},
-    { "mslug3b6", init_mslug3b6},
-    { "kof2000", init_kof2000},
-    { "kof2000n", init_kof2000n},
-    { "kof2001", init_kof2001},
-    { "mslug4", init_mslug4},
-    { "ms4plus", init_ms4plus},
-    { "ganryu", init_ganryu},
-    { "s1945p", init_s1945p},
-    { "preisle2", init_preisle2},
-    { "bangbead", init_bangbead},
-    { "nitd", init_nitd},
-    { "zupapa", init_zupapa},
-    { "sengoku3", init_sengoku3},
-    { "kof98", init_kof98},
-    { "rotd", init_rotd},
-    { "kof2002", init_kof2002},
-    { "kof2002b", init_kof2002b},
-    { "kf2k2pls", init_kf2k2pls},
-    { "kf2k2mp", init_kf2k2mp},
-    { "kof2km2", init_kof2km2},
-    { "matrim", init_matrim},
-    { "pnyaa", init_pnyaa},
-    { "mslug5", init_mslug5},
-    { "ms5pcb", init_ms5pcb},
-    { "ms5plus", init_ms5plus},
-    { NULL, NULL}
+    { "kof99", init_kof99, kof99_neogeo_gfx_decrypt, 0x00},
+    { "kof99n", init_kof99n, kof99_neogeo_gfx_decrypt, 0x00},
+    { "garou", init_garou, kof99_neogeo_gfx_decrypt, 0x06},
+    { "garouo", init_garouo, kof99_neogeo_gfx_decrypt, 0x06},
+    { "garoubl", NULL, init_garoubl_gfx, 0x00},
+    { "mslug3", init_mslug3, kof99_neogeo_gfx_decrypt, 0xAD},
+    { "mslug3h", init_mslug3h, kof99_neogeo_gfx_decrypt, 0xAD},
+    { "mslug3n", init_mslug3h, kof99_neogeo_gfx_decrypt, 0xAD},
+    { "mslug3b6", NULL, init_mslug3b6_gfx, 0xAD},
+    { "kof2000", init_kof2000, kof2000_neogeo_gfx_decrypt, 0x00},
+    { "kof2000n", init_kof2000n, kof2000_neogeo_gfx_decrypt, 0x00},
+    { "kof2001", init_kof2001, kof2000_neogeo_gfx_decrypt, 0x1E},
+    { "mslug4", init_mslug4, kof2000_neogeo_gfx_decrypt, 0x31},
+    { "ms4plus", init_ms4plus, cmc50_neogeo_gfx_decrypt, 0x31},
+    { "ganryu", init_ganryu, kof99_neogeo_gfx_decrypt, 0x07},
+    { "s1945p", init_s1945p, kof99_neogeo_gfx_decrypt, 0x05},
+    { "preisle2", init_preisle2, kof99_neogeo_gfx_decrypt, 0x9F},
+    { "bangbead", init_bangbead, kof99_neogeo_gfx_decrypt, 0xF8},
+    { "nitd", init_nitd, kof99_neogeo_gfx_decrypt, 0xFF},
+    { "zupapa", init_zupapa, kof99_neogeo_gfx_decrypt, 0xBD},
+    { "sengoku3", init_sengoku3, kof99_neogeo_gfx_decrypt, 0xFE},
+    { "kof98", init_kof98, NULL, 0x00},
+    { "rotd", init_rotd, kof2000_neogeo_gfx_decrypt, 0x3F},
+    { "kof2002", init_kof2002, kof2000_neogeo_gfx_decrypt, 0xEC},
+    { "kof2002b", init_kof2002b, NULL, 0x00},
+    { "kf2k2pls", init_kf2k2pls, cmc50_neogeo_gfx_decrypt, 0xEC},
+    { "kf2k2mp", init_kf2k2mp, cmc50_neogeo_gfx_decrypt, 0xEC},
+    { "kof2km2", init_kof2km2, cmc50_neogeo_gfx_decrypt, 0xEC},
+    { "matrim", init_matrim, kof2000_neogeo_gfx_decrypt, 0x6A},
+    { "pnyaa", init_pnyaa, kof2000_neogeo_gfx_decrypt, 0x2E},
+    { "mslug5", init_mslug5, kof2000_neogeo_gfx_decrypt, 0x19},
+    { "ms5pcb", init_ms5pcb, init_ms5pcb_gfx, 0x19},
+    { "ms5plus", init_ms5plus, cmc50_neogeo_gfx_decrypt, 0x19},
+    { NULL, NULL, NULL, 0x00}
 };
 /* ******************************************************************************************************************/
 /*!
@@ -168,7 +169,6 @@ static void init_kof99 ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         kof99_decrypt_68k ( rom );
-        kof99_neogeo_gfx_decrypt ( rom, 0x00 );
     }
 
     neo_rom_fix_bank_type = 0;
@@ -186,12 +186,9 @@ static void init_kof99 ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_kof99n ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0x00 );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -205,7 +202,6 @@ static void init_garou ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         garou_decrypt_68k ( rom );
-        kof99_neogeo_gfx_decrypt ( rom, 0x06 );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -226,7 +222,6 @@ static void init_garouo ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         garouo_decrypt_68k ( rom );
-        kof99_neogeo_gfx_decrypt ( rom, 0x06 );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -238,19 +233,19 @@ static void init_garouo ( struct_gngeoxroms_game_roms* rom )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Initializes garoubl.
+* \brief  Decrypts garoubl sprites and fix layer.
 *
 * \param  rom Game rom.
+* \param  extra_xor Unused.
 */
 /* ******************************************************************************************************************/
-static void init_garoubl ( struct_gngeoxroms_game_roms* rom )
+static void init_garoubl_gfx ( struct_gngeoxroms_game_roms* rom, Sint32 extra_xor )
 {
     /* @todo (Tmesys#1#20/10/2023): Bootleg support */
-    if ( rom->need_decrypt )
-    {
-        neogeo_bootleg_sx_decrypt ( rom, 2 );
-        neogeo_bootleg_cx_decrypt ( rom );
-    }
+    ( void ) extra_xor;
+
+    neogeo_bootleg_sx_decrypt ( rom, 2 );
+    neogeo_bootleg_cx_decrypt ( rom );
 }
 /* ******************************************************************************************************************/
 /*!
@@ -264,7 +259,6 @@ static void init_mslug3 ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         mslug3_decrypt_68k ( rom );
-        kof99_neogeo_gfx_decrypt ( rom, 0xAD );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -284,28 +278,23 @@ static void init_mslug3 ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_mslug3h ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0xad );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Initializes mslug3b6.
+* \brief  Decrypts mslug3b6 sprites and fix layer.
 *
 * \param  rom Game rom.
+* \param  extra_xor CMC42 key.
 */
 /* ******************************************************************************************************************/
-static void init_mslug3b6 ( struct_gngeoxroms_game_roms* rom )
+static void init_mslug3b6_gfx ( struct_gngeoxroms_game_roms* rom, Sint32 extra_xor )
 {
     /* TODO: Bootleg support */
-    if ( rom->need_decrypt )
-    {
-        neogeo_bootleg_sx_decrypt ( rom, 2 );
-        cmc42_neogeo_gfx_decrypt ( rom, 0xad );
-    }
+    neogeo_bootleg_sx_decrypt ( rom, 2 );
+    cmc42_neogeo_gfx_decrypt ( rom, extra_xor );
 }
 /* ******************************************************************************************************************/
 /*!
@@ -322,8 +311,6 @@ static void init_mslug4 ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x31 );
-
         neo_pcm2_snk_1999 ( rom, 8 );
     }
 }
@@ -338,7 +325,6 @@ static void init_ms4plus ( struct_gngeoxroms_game_roms* rom )
 {
     if ( rom->need_decrypt )
     {
-        cmc50_neogeo_gfx_decrypt ( rom, 0x31 );
         neo_pcm2_snk_1999 ( rom, 8 );
         neogeo_cmc50_m1_decrypt ( rom );
     }
@@ -356,7 +342,6 @@ static void init_kof2000 ( struct_gngeoxroms_game_roms* rom )
     {
         kof2000_decrypt_68k ( rom );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x00 );
     }
 
     neo_rom_fix_bank_type = 2;
@@ -379,7 +364,6 @@ static void init_kof2000n ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x00 );
     }
 }
 /* ******************************************************************************************************************/
@@ -395,7 +379,6 @@ static void init_kof2001 ( struct_gngeoxroms_game_roms* rom )
 
     if ( rom->need_decrypt )
     {
-        kof2000_neogeo_gfx_decrypt ( rom, 0x1e );
         neogeo_cmc50_m1_decrypt ( rom );
     }
 }
@@ -408,12 +391,9 @@ static void init_kof2001 ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_ganryu ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0x07 );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -424,12 +404,9 @@ static void init_ganryu ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_s1945p ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0x05 );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -440,12 +417,9 @@ static void init_s1945p ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_preisle2 ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0x9f );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -456,12 +430,9 @@ static void init_preisle2 ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_bangbead ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0xf8 );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -472,12 +443,9 @@ static void init_bangbead ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_nitd ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0xff );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -488,12 +456,9 @@ static void init_nitd ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_zupapa ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0xbd );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -504,12 +469,9 @@ static void init_zupapa ( struct_gngeoxroms_game_roms* rom )
 /* ******************************************************************************************************************/
 static void init_sengoku3 ( struct_gngeoxroms_game_roms* rom )
 {
-    neo_rom_fix_bank_type = 1;
+    ( void ) rom;
 
-    if ( rom->need_decrypt )
-    {
-        kof99_neogeo_gfx_decrypt ( rom, 0xfe );
-    }
+    neo_rom_fix_bank_type = 1;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -540,7 +502,6 @@ static void init_rotd ( struct_gngeoxroms_game_roms* rom )
     {
         neo_pcm2_snk_1999 ( rom, 16 );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x3f );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -559,7 +520,6 @@ static void init_kof2002 ( struct_gngeoxroms_game_roms* rom )
         kof2002_decrypt_68k ( rom );
         neo_pcm2_swap ( rom, 0 );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0xec );
     }
 }
 /* ******************************************************************************************************************/
@@ -595,7 +555,6 @@ static void init_kf2k2pls ( struct_gngeoxroms_game_roms* rom )
         kof2002_decrypt_68k ( rom );
         neo_pcm2_swap ( rom, 0 );
         neogeo_cmc50_m1_decrypt ( rom );
-        cmc50_neogeo_gfx_decrypt ( rom, 0xec );
     }
 }
 /* ******************************************************************************************************************/
@@ -613,7 +572,6 @@ static void init_kf2k2mp ( struct_gngeoxroms_game_roms* rom )
         //kf2k2mp_decrypt(r);
         neo_pcm2_swap ( rom, 0 );
         //neogeo_bootleg_sx_decrypt(r, 2);
-        cmc50_neogeo_gfx_decrypt ( rom, 0xec );
     }
 }
 /* ******************************************************************************************************************/
@@ -631,7 +589,6 @@ static void init_kof2km2 ( struct_gngeoxroms_game_roms* rom )
         //kof2km2_px_decrypt(r);
         neo_pcm2_swap ( rom, 0 );
         //neogeo_bootleg_sx_decrypt(r, 1);
-        cmc50_neogeo_gfx_decrypt ( rom, 0xec );
     }
 }
 /* ******************************************************************************************************************/
@@ -648,7 +605,6 @@ static void init_matrim ( struct_gngeoxroms_game_roms* rom )
         matrim_decrypt_68k ( rom );
         neo_pcm2_swap ( rom, 1 );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x6a );
     }
 
     neo_rom_fix_bank_type = 2;
@@ -666,7 +622,6 @@ static void init_pnyaa ( struct_gngeoxroms_game_roms* rom )
     {
         neo_pcm2_snk_1999 ( rom, 4 );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x2e );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -685,7 +640,6 @@ static void init_mslug5 ( struct_gngeoxroms_game_roms* rom )
         mslug5_decrypt_68k ( rom );
         neo_pcm2_swap ( rom, 2 );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x19 );
     }
 
     neo_rom_fix_bank_type = 1;
@@ -706,10 +660,7 @@ static void init_ms5pcb ( struct_gngeoxroms_game_roms* rom )
     if ( rom->need_decrypt )
     {
         mslug5_decrypt_68k ( rom );
-        svcpcb_gfx_decrypt ( rom );
         neogeo_cmc50_m1_decrypt ( rom );
-        kof2000_neogeo_gfx_decrypt ( rom, 0x19 );
-        svcpcb_s1data_decrypt ( rom );
         neo_pcm2_swap ( rom, 2 );
     }
 
@@ -718,6 +669,21 @@ static void init_ms5pcb ( struct_gngeoxroms_game_roms* rom )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Decrypts ms5pcb sprites and fix layer.
+*
+* \param  rom Game rom.
+* \param  extra_xor CMC50 key.
+* \note   The S data comes from the CMC decrypted sprites, then gets its own scramble.
+*/
+/* ******************************************************************************************************************/
+static void init_ms5pcb_gfx ( struct_gngeoxroms_game_roms* rom, Sint32 extra_xor )
+{
+    svcpcb_gfx_decrypt ( rom );
+    kof2000_neogeo_gfx_decrypt ( rom, extra_xor );
+    svcpcb_s1data_decrypt ( rom );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Initializes ms5plus.
 *
 * \param  rom Game rom.
@@ -728,7 +694,6 @@ static void init_ms5plus ( struct_gngeoxroms_game_roms* rom )
     /* TODO: Bootleg */
     if ( rom->need_decrypt )
     {
-        cmc50_neogeo_gfx_decrypt ( rom, 0x19 );
         neo_pcm2_swap ( rom, 2 );
         //neogeo_bootleg_sx_decrypt(r, 1);
     }
@@ -739,30 +704,83 @@ static void init_ms5plus ( struct_gngeoxroms_game_roms* rom )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Converts all rom chars.
+* \brief  Finds the special init functions of a game.
 *
-* \param  rom Todo.
+* \param  name Game name.
+* \return Init functions, NULL when the game has none.
+*/
+/* ******************************************************************************************************************/
+static const struct_gngeoxroms_init_func* init_roms_find ( const char* name )
+{
+    for ( Sint32 i = 0; init_func_table[i].name; i++ )
+    {
+        if ( strcmp ( init_func_table[i].name, name ) == 0 )
+        {
+            return ( &init_func_table[i] );
+        }
+    }
+
+    return ( NULL );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Tells if a game sprites get decrypted after loading.
+*
+* \param  rom Game rom.
+* \return SDL_TRUE when the whole sprites region is rewritten by init_roms_sprites(), SDL_FALSE otherwise.
+*/
+/* ******************************************************************************************************************/
+SDL_bool init_roms_sprites_needed ( const struct_gngeoxroms_game_roms* rom )
+{
+    const struct_gngeoxroms_init_func* func = init_roms_find ( rom->info.name );
+
+    if ( ( func == NULL ) || ( func->gfx == NULL ) || ( rom->need_decrypt == SDL_FALSE ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decrypts and patches the game roms, sprites and fix layer apart.
+*
+* \param  rom Game rom.
+* \note   Only touches program, audio cpu and audio data regions, so it can run while sprites get decrypted or
+*         converted.
 */
 /* ******************************************************************************************************************/
 void init_roms ( struct_gngeoxroms_game_roms* rom )
 {
-    Sint32 i = 0;
+    const struct_gngeoxroms_init_func* func = init_roms_find ( rom->info.name );
+
     neo_rom_fix_bank_type = 0;
     neogeo_memory.bksw_handler = 0;
     neogeo_memory.bksw_unscramble = NULL;
     neogeo_memory.bksw_offset = NULL;
     neogeo_memory.sma_rng_addr = 0;
 
-    while ( init_func_table[i].name )
+    if ( ( func != NULL ) && ( func->init != NULL ) )
     {
-        if ( strcmp ( init_func_table[i].name, rom->info.name ) == 0
-                && init_func_table[i].init != NULL )
-        {
-            zlog_warn ( gngeox_config.loggingCat, "Special init func" );
-            init_func_table[i].init ( rom );
-        }
+        zlog_warn ( gngeox_config.loggingCat, "Special init func" );
+        func->init ( rom );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decrypts the game sprites, and the fix layer taken from them.
+*
+* \param  rom Game rom.
+* \note   Works on the whole sprites region, before its tiles get converted.
+*/
+/* ******************************************************************************************************************/
+void init_roms_sprites ( struct_gngeoxroms_game_roms* rom )
+{
+    if ( init_roms_sprites_needed ( rom ) == SDL_TRUE )
+    {
+        const struct_gngeoxroms_init_func* func = init_roms_find ( rom->info.name );
 
-        i++;
+        func->gfx ( rom, func->extra_xor );
     }
 }
 
@@ -20,6 +20,8 @@ typedef struct
 {
     char* name;
     void ( *init ) ( struct_gngeoxroms_game_roms* r );
+    void ( *gfx ) ( struct_gngeoxroms_game_roms* r, Sint32 extra_xor );    /* Sprites decryption, NULL when none */
+    Sint32 extra_xor;
 } struct_gngeoxroms_init_func;
 
 #ifdef _GNGEOX_ROMSINIT_C_
@@ -27,10 +29,10 @@ static void init_kof99 ( struct_gngeoxroms_game_roms* );
 static void init_kof99n ( struct_gngeoxroms_game_roms* );
 static void init_garou ( struct_gngeoxroms_game_roms* );
 static void init_garouo ( struct_gngeoxroms_game_roms* );
-static void init_garoubl ( struct_gngeoxroms_game_roms* );
+static void init_garoubl_gfx ( struct_gngeoxroms_game_roms*, Sint32 );
 static void init_mslug3 ( struct_gngeoxroms_game_roms* );
 static void init_mslug3h ( struct_gngeoxroms_game_roms* );
-static void init_mslug3b6 ( struct_gngeoxroms_game_roms* );
+static void init_mslug3b6_gfx ( struct_gngeoxroms_game_roms*, Sint32 );
 static void init_kof2000 ( struct_gngeoxroms_game_roms* );
 static void init_kof2000n ( struct_gngeoxroms_game_roms* );
 static void init_kof2001 ( struct_gngeoxroms_game_roms* );
@@ -54,9 +56,13 @@ static void init_matrim ( struct_gngeoxroms_game_roms* );
 static void init_pnyaa ( struct_gngeoxroms_game_roms* );
 static void init_mslug5 ( struct_gngeoxroms_game_roms* );
 static void init_ms5pcb ( struct_gngeoxroms_game_roms* );
+static void init_ms5pcb_gfx ( struct_gngeoxroms_game_roms*, Sint32 );
 static void init_ms5plus ( struct_gngeoxroms_game_roms* );
+static const struct_gngeoxroms_init_func* init_roms_find ( const char* ) __attribute__ ( ( warn_unused_result ) );
 #endif // _GNGEOX_ROMSINIT_C_
 
+SDL_bool init_roms_sprites_needed ( const struct_gngeoxroms_game_roms* ) __attribute__ ( ( warn_unused_result ) );
 void init_roms ( struct_gngeoxroms_game_roms* );
+void init_roms_sprites ( struct_gngeoxroms_game_roms* );
 
 #endif
@@ -38,6 +38,8 @@
 #include "GnGeoXpd4990a.h"
 #include "GnGeoXeffects.h"
 #include "GnGeoXinterp.h"
+#include "GnGeoXvideosimd.h"
+#include "GnGeoXprofiler.h"
 
 SDL_Surface* sdl_surface_screen = NULL;
 SDL_Surface* sdl_surface_buffer = NULL;
@@ -53,28 +55,34 @@ Sint32 last_line = 0;
 static blitter_func blitter[] =
 {
     {
-        "soft", "Software blitter", blitter_soft_init, NULL, blitter_soft_update, blitter_soft_fullscreen,
-        blitter_soft_close
+        "soft", "Software blitter", blitter_soft_init, NULL, blitter_soft_update, blitter_soft_present,
+        blitter_soft_fullscreen, blitter_soft_close
     },
 
     {
         "opengl", "Opengl blitter", blitter_opengl_init, blitter_opengl_resize, blitter_opengl_update,
-        blitter_opengl_fullscreen, blitter_opengl_close
+        blitter_opengl_present, blitter_opengl_fullscreen, blitter_opengl_close
     },
 
 #if (defined(HAVE_GL_GL_H) || defined(HAVE_OPENGL_GL_H)) && defined(USE_GLSL)
     {
         "glsl", "OpenGL shading language (GLSL) blitter",
-        blitter_glsl_init, blitter_glsl_resize, blitter_glsl_update, blitter_glsl_fullscreen, blitter_glsl_close
+        blitter_glsl_init, blitter_glsl_resize, blitter_glsl_update, blitter_glsl_present,
+        blitter_glsl_fullscreen, blitter_glsl_close
     },
 #endif
-    {NULL, NULL, NULL, NULL, NULL, NULL, NULL}
+    {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}
 };
 
 
 
 static SDL_Rect left_border = {16, 16, 8, 224};
 static SDL_Rect right_border = {16 + 312, 16, 8, 224};
+/* Generation and animation counter the last frame was drawn with */
+static SDL_bool drawn_valid = SDL_FALSE;
+static Uint32 drawn_generation = 0;
+static Uint32 drawn_frame_counter = 0;
+static Uint32 unchanged_frames = 0;
 /* ******************************************************************************************************************/
 /*!
 * \brief Takes a screen shot.
@@ -198,6 +206,8 @@ SDL_bool neo_screen_resize ( Sint32 width, Sint32 height )
         return ( SDL_FALSE );
     }
 
+    drawn_valid = SDL_FALSE;
+
     return ( SDL_TRUE );
 }
 /* ******************************************************************************************************************/
@@ -223,6 +233,7 @@ void neo_screen_fullscreen ( void )
 {
     gngeox_config.fullscreen ^= 1;
     blitter[gngeox_config.blitter_index].fullscreen();
+    drawn_valid = SDL_FALSE;
 }
 /* ******************************************************************************************************************/
 /*!
@@ -257,21 +268,25 @@ void neo_screen_windowtitle_set ( void )
 /* ******************************************************************************************************************/
 void neo_screen_efects_apply ( void )
 {
-    if ( gngeox_config.blending == SDL_TRUE )
+    /* Frames with palette indexes only are colored by the blitter, the colors buffer is not shown */
+    if ( neogeo_video_index_only == SDL_FALSE )
     {
-        neo_screen_blend();
-    }
+        if ( gngeox_config.blending == SDL_TRUE )
+        {
+            neo_screen_blend();
+        }
 
-    /* @note (Tmesys#1#12/18/2022): Does not seem to have any effect ? */
-    SDL_FillRect ( sdl_surface_buffer, &left_border, 0 );
-    SDL_FillRect ( sdl_surface_buffer, &right_border, 0 );
+        /* @note (Tmesys#1#12/18/2022): Does not seem to have any effect ? */
+        SDL_FillRect ( sdl_surface_buffer, &left_border, 0 );
+        SDL_FillRect ( sdl_surface_buffer, &right_border, 0 );
 
-    if ( effect[gngeox_config.effect_index].update != NULL )
-    {
-        ( *effect[gngeox_config.effect_index].update ) ();
-    }
+        if ( effect[gngeox_config.effect_index].update != NULL )
+        {
+            ( *effect[gngeox_config.effect_index].update ) ();
+        }
 
-    neo_frame_rate_display();
+        neo_frame_rate_display();
+    }
 
     ( *blitter[gngeox_config.blitter_index].update ) ();
 }
@@ -297,10 +312,18 @@ void neo_screen_update ( void )
     {
         /* there was no IRQ2 while the beam was in the
                              * visible area -> no need for scanline rendering */
-        draw_screen();
+        if ( neo_screen_unchanged() == SDL_TRUE )
+        {
+            ( *blitter[gngeox_config.blitter_index].present ) ();
+        }
+        else
+        {
+            draw_screen();
+        }
     }
     else
     {
+        drawn_valid = SDL_FALSE;
         draw_screen_scanline ( last_line - 21, 262, SDL_TRUE );
     }
 
@@ -318,6 +341,39 @@ void neo_screen_update ( void )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Checks if the frame to draw is the same as the last drawn one.
+*
+* \return SDL_TRUE when the last presented frame can be shown again, SDL_FALSE otherwise.
+* \note   The picture only depends on video ram, palettes, fix and palette banks, LSPC mode and the
+*         auto animation counter. The fps counter is drawn in the frame, so it always forces a redraw.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool neo_screen_unchanged ( void )
+{
+    if ( ( drawn_valid == SDL_FALSE ) || ( drawn_generation != neogeo_video_generation )
+            || ( drawn_frame_counter != neogeo_frame_counter ) || ( gngeox_config.showfps == SDL_TRUE )
+            || ( blitter[gngeox_config.blitter_index].present == NULL ) )
+    {
+        drawn_valid = SDL_TRUE;
+        drawn_generation = neogeo_video_generation;
+        drawn_frame_counter = neogeo_frame_counter;
+        unchanged_frames = 0;
+
+        return ( SDL_FALSE );
+    }
+
+    unchanged_frames++;
+
+    /* Blending mixes the new frame with the previous one, so the first repeat still has to be drawn */
+    if ( ( gngeox_config.blending == SDL_TRUE ) && ( unchanged_frames < 2 ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Prints blitter list.
 *
 */
@@ -370,17 +426,22 @@ static void neo_screen_blend ( void )
     SDL_Surface* tmp = NULL;
     Uint32* dst = ( Uint32* ) sdl_surface_blend->pixels; //+ 16 + ( 352 << 4 );
     Uint32* src = ( Uint32* ) sdl_surface_buffer->pixels; // + 16 + ( 352 << 4 );
+    Sint32 dst_pitch = sdl_surface_blend->pitch >> 2;
+    Sint32 src_pitch = sdl_surface_buffer->pitch >> 2;
 
-    for ( Uint32 column = 0; column < sdl_surface_buffer->h; column++ )
+#ifdef ENABLE_PROFILER
+    profiler_start ( PROF_BLEND );
+#endif // ENABLE_PROFILER
+
+    for ( Sint32 line = 0; line < sdl_surface_buffer->h; line++ )
     {
-        for ( Uint32 row = 0; row < sdl_surface_buffer->w; row++ )
-        {
-            dst[column * sdl_surface_buffer->w + row] =
-                alpha_blend ( dst[column * sdl_surface_buffer->w + row],
-                              src[column * sdl_surface_buffer->w + row], 127 );
-        }
+        neo_video_simd_blend_row ( &dst[line * dst_pitch], &src[line * src_pitch], sdl_surface_buffer->w, 127 );
     }
 
+#ifdef ENABLE_PROFILER
+    profiler_stop ( PROF_BLEND );
+#endif // ENABLE_PROFILER
+
     /* Swap Buffers */
     tmp = sdl_surface_blend;
     sdl_surface_blend = sdl_surface_buffer;
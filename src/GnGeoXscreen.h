@@ -24,6 +24,7 @@ typedef struct
     SDL_bool ( *init ) ();
     SDL_bool ( *resize ) ( Sint32 w, Sint32 h );
     void ( *update ) ();
+    void ( *present ) ();
     void ( *fullscreen ) ();
     void ( *close ) ();
 } blitter_func;
@@ -41,6 +42,7 @@ extern Uint8 scale;
 extern Sint32 last_line;
 #else
 static void neo_screen_blend ( void );
+static SDL_bool neo_screen_unchanged ( void ) __attribute__ ( ( warn_unused_result ) );
 #endif // _GNGEOX_SCREEN_C_
 
 void print_blitter_list ( void );
@@ -214,6 +214,16 @@ void blitter_soft_update()
     }
 
     SDL_UpdateTexture ( sdl_texture, NULL, sdl_surface_screen->pixels, sdl_surface_screen->w * 4 );
+    blitter_soft_present();
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Presents again the last uploaded frame.
+*
+*/
+/* ******************************************************************************************************************/
+void blitter_soft_present()
+{
     SDL_RenderClear ( sdl_renderer );
     SDL_RenderCopy ( sdl_renderer, sdl_texture, NULL, NULL );
     SDL_RenderPresent ( sdl_renderer );
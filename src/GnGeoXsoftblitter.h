@@ -25,6 +25,7 @@ static void update_triple ( void );
 
 SDL_bool blitter_soft_init ( void ) __attribute__ ( ( warn_unused_result ) );
 void blitter_soft_update ( void );
+void blitter_soft_present ( void );
 void blitter_soft_fullscreen ( void );
 void blitter_soft_close ( void );
 
@@ -34,8 +34,10 @@
 #include "GnGeoXconfig.h"
 #include "GnGeoXz80.h"
 #include "GnGeoXym2610.h"
+#include "GnGeoXresampler.h"
 
 static Uint16 sound_buffer[BUFFER_LEN];
+static SDL_bool sound_resampling = SDL_FALSE;
 
 /* ******************************************************************************************************************/
 /*!
@@ -54,8 +56,15 @@ static void neo_sound_feed_callback ( void* userdata, Uint8* stream, Sint32 len
 #endif // ENABLE_PROFILER
 
     /* @note (Tmesys#1#13/04/2024): Well, YM2610 expects length in 32 bits words, 16 bits for each channel.  */
-    YM2610Update_stream ( len / 4, sound_buffer );
-    memcpy ( stream, ( Uint8* ) sound_buffer, len );
+    if ( sound_resampling )
+    {
+        neo_resampler_run ( ( Sint16* ) stream, len / 4 );
+    }
+    else
+    {
+        YM2610Update_stream ( len / 4, sound_buffer );
+        memcpy ( stream, ( Uint8* ) sound_buffer, len );
+    }
 
 #ifdef ENABLE_PROFILER
     profiler_stop ( PROF_SOUND );
@@ -74,6 +83,14 @@ SDL_bool neo_sound_init ( void )
     SDL_zero ( desired );
     SDL_zero ( obtain );
 
+    /* @note (Tmesys#1#18/10/2026): Without audio, YM2610 is only kept ticking by neo_ym2610_update. */
+    if ( gngeox_config.nosound )
+    {
+        neo_z80_init();
+
+        return ( neo_ym2610_init() );
+    }
+
     desired.freq = gngeox_config.samplerate;
     desired.samples = NB_SAMPLES;
 #if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
@@ -104,6 +121,17 @@ SDL_bool neo_sound_init ( void )
         return ( SDL_FALSE );
     }
 
+    /* @note (Tmesys#1#18/10/2026): YM2610 may run at its native rate, the device then gets a resampled stream. */
+    if ( neo_ym2610_rate() != gngeox_config.samplerate )
+    {
+        if ( neo_resampler_init ( neo_ym2610_rate(), gngeox_config.samplerate, obtain.samples, YM2610Update_stream ) == SDL_FALSE )
+        {
+            return ( SDL_FALSE );
+        }
+
+        sound_resampling = SDL_TRUE;
+    }
+
     SDL_PauseAudio ( 0 );
 
     return ( SDL_TRUE );
@@ -116,9 +144,168 @@ SDL_bool neo_sound_init ( void )
 /* ******************************************************************************************************************/
 void neo_sound_close ( void )
 {
-    SDL_PauseAudio ( 1 );
-    SDL_CloseAudio();
+    if ( gngeox_config.nosound == SDL_FALSE )
+    {
+        SDL_PauseAudio ( 1 );
+        SDL_CloseAudio();
+    }
+
     neo_ym2610_close ();
+    neo_resampler_close ();
+    sound_resampling = SDL_FALSE;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Timer handler used while benchmarking, timers are not needed.
+*
+* \param  timer_id 0 for A or 1 for B.
+* \param  count Number of step_time to target.
+* \param  step_time Step time in ms.
+*/
+/* ******************************************************************************************************************/
+static void neo_sound_benchmark_timer ( Sint32 timer_id, Sint32 count, double step_time )
+{
+    ( void ) timer_id;
+    ( void ) count;
+    ( void ) step_time;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  IRQ handler used while benchmarking, Z80 is not running.
+*
+* \param  irq IRQ line state.
+*/
+/* ******************************************************************************************************************/
+static void neo_sound_benchmark_irq ( Sint32 irq )
+{
+    ( void ) irq;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Writes one YM2610 register.
+*
+* \param  port 0 for port A or 2 for port B.
+* \param  reg Register address.
+* \param  value Register value.
+*/
+/* ******************************************************************************************************************/
+static void neo_sound_benchmark_write ( Sint32 port, Uint8 reg, Uint8 value )
+{
+    YM2610Write ( port, reg );
+    YM2610Write ( port + 1, value );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Keys on all FM channels and SSG tone A with a sustained patch.
+*
+*/
+/* ******************************************************************************************************************/
+static void neo_sound_benchmark_patch ( void )
+{
+    static const Uint8 key_on[4] = { 0xF1, 0xF2, 0xF5, 0xF6 };
+
+    for ( Sint32 port = 0; port <= 2; port += 2 )
+    {
+        for ( Uint8 channel = 1; channel <= 2; channel++ )
+        {
+            /* Feedback 7, algorithm 4, both speakers */
+            neo_sound_benchmark_write ( port, 0xB0 + channel, 0x3C );
+            neo_sound_benchmark_write ( port, 0xB4 + channel, 0xC0 );
+
+            for ( Uint8 slot = 0; slot < 4; slot++ )
+            {
+                Uint8 offset = ( slot * 4 ) + channel;
+
+                neo_sound_benchmark_write ( port, 0x30 + offset, 0x01 );
+                neo_sound_benchmark_write ( port, 0x40 + offset, 0x10 );
+                neo_sound_benchmark_write ( port, 0x50 + offset, 0x1F );
+                neo_sound_benchmark_write ( port, 0x60 + offset, 0x05 );
+                neo_sound_benchmark_write ( port, 0x70 + offset, 0x02 );
+                neo_sound_benchmark_write ( port, 0x80 + offset, 0x2F );
+            }
+
+            neo_sound_benchmark_write ( port, 0xA4 + channel, 0x22 + channel );
+            neo_sound_benchmark_write ( port, 0xA0 + channel, 0x69 );
+        }
+    }
+
+    for ( Sint32 loop = 0; loop < 4; loop++ )
+    {
+        neo_sound_benchmark_write ( 0, 0x28, key_on[loop] );
+    }
+
+    /* SSG tone A */
+    neo_sound_benchmark_write ( 0, 0x00, 0x40 );
+    neo_sound_benchmark_write ( 0, 0x01, 0x00 );
+    neo_sound_benchmark_write ( 0, 0x07, 0x3E );
+    neo_sound_benchmark_write ( 0, 0x08, 0x0F );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Measures YM2610 synthesis throughput for each internal rate mode.
+*
+* \note   Playback is paused and YM2610 state is lost, the caller is expected to exit afterwards.
+*/
+/* ******************************************************************************************************************/
+void neo_sound_benchmark ( void )
+{
+    const char* names[SOUND_BENCH_MODES] = { "direct", "native", "half native", "configured" };
+    Uint32 rates[SOUND_BENCH_MODES] = { gngeox_config.samplerate, YM2610_NATIVE_RATE, YM2610_NATIVE_RATE / 2, neo_ym2610_rate() };
+    Uint32 frames = gngeox_config.samplerate * SOUND_BENCH_SECONDS;
+
+    SDL_PauseAudio ( 1 );
+
+    for ( Sint32 mode = 0; mode < SOUND_BENCH_MODES; mode++ )
+    {
+        SDL_bool resampling = ( rates[mode] != gngeox_config.samplerate ) ? SDL_TRUE : SDL_FALSE;
+        Uint64 start = 0;
+        double elapsed = 0;
+
+        YM2610Init ( YM2610_CLOCK_FREQ_HZ,
+                     rates[mode],
+                     neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].p,
+                     neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].size,
+                     neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_2].p,
+                     neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_2].size,
+                     neo_sound_benchmark_timer,
+                     neo_sound_benchmark_irq );
+
+        neo_sound_benchmark_patch();
+
+        if ( resampling )
+        {
+            if ( neo_resampler_init ( rates[mode], gngeox_config.samplerate, NB_SAMPLES, YM2610Update_stream ) == SDL_FALSE )
+            {
+                continue;
+            }
+        }
+
+        start = SDL_GetPerformanceCounter();
+
+        for ( Uint32 done = 0; done < frames; done += NB_SAMPLES )
+        {
+            Uint32 count = SDL_min ( frames - done, ( Uint32 ) NB_SAMPLES );
+
+            if ( resampling )
+            {
+                neo_resampler_run ( ( Sint16* ) sound_buffer, count );
+            }
+            else
+            {
+                YM2610Update_stream ( count, sound_buffer );
+            }
+        }
+
+        elapsed = ( double ) ( SDL_GetPerformanceCounter() - start ) / ( double ) SDL_GetPerformanceFrequency();
+
+        if ( elapsed > 0 )
+        {
+            zlog_info ( gngeox_config.loggingCat, "YM2610 %-11s : %5u Hz -> %5u Hz : %10.0f samples/s (x%.1f real time)",
+                        names[mode], rates[mode], gngeox_config.samplerate, frames / elapsed, SOUND_BENCH_SECONDS / elapsed );
+        }
+
+        neo_resampler_close();
+    }
 }
 
 #ifdef _GNGEOX_SOUND_C_
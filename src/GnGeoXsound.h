@@ -23,7 +23,20 @@
 #define NB_SAMPLES 512
 #define BUFFER_LEN (NB_SAMPLES*NB_CHANNELS)
 
+/* Seconds of output produced by each benchmark mode */
+#define SOUND_BENCH_SECONDS 30
+#define SOUND_BENCH_MODES   4
+
+#ifdef _GNGEOX_SOUND_C_
+static void neo_sound_feed_callback ( void*, Uint8*, Sint32 );
+static void neo_sound_benchmark_timer ( Sint32, Sint32, double );
+static void neo_sound_benchmark_irq ( Sint32 );
+static void neo_sound_benchmark_write ( Sint32, Uint8, Uint8 );
+static void neo_sound_benchmark_patch ( void );
+#endif // _GNGEOX_SOUND_C_
+
 SDL_bool neo_sound_init ( void ) __attribute__ ( ( warn_unused_result ) );
 void neo_sound_close ( void );
+void neo_sound_benchmark ( void );
 
 #endif
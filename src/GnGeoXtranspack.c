@@ -37,6 +37,9 @@ sqlite3 * db_handle = NULL;
 sqlite3_stmt * db_stmt = NULL;
 struct_gngeoxtranspack_range *range_list = NULL;
 Uint32 range_list_size = 0;
+/* Pen usage when no range apply, merged copy otherwise */
+Uint32* transpack_usage = NULL;
+static Uint32* transpack_merged = NULL;
 /* ******************************************************************************************************************/
 /*!
 * \brief Loads a Nebula transparency pack.
@@ -151,6 +154,77 @@ SDL_bool neo_transpack_init ( void )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief Builds tile type lookup.
+*
+* \param spr_usage Sprites pen usage, 2 bits per tile.
+* \param nb_of_tiles Number of sprite tiles.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \note Ranges are expanded over a copy of pen usage, so that drawing does a single lookup per tile
+*       whatever the pack size. Ranges are sorted by begin, the first one holding a tile wins like in
+*       neo_transpack_find(), hence they are applied last to first.
+*/
+/* ******************************************************************************************************************/
+SDL_bool neo_transpack_usage_init ( Uint32* spr_usage, Uint32 nb_of_tiles )
+{
+    /* One spare word, like pen usage, tile numbers are not always wrapped before lookup */
+    Uint32 words = ( ( nb_of_tiles + 15 ) >> 4 ) + 1;
+
+    if ( transpack_merged != NULL )
+    {
+        qalloc_delete ( transpack_merged );
+        transpack_merged = NULL;
+    }
+
+    transpack_usage = spr_usage;
+
+    if ( ( gngeox_config.transpack == SDL_FALSE ) || ( range_list_size == 0 ) )
+    {
+        return ( SDL_TRUE );
+    }
+
+    transpack_merged = ( Uint32* ) qalloc ( words * sizeof ( Uint32 ) );
+    if ( transpack_merged == NULL )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Unable to allocate tile usage" );
+        return ( SDL_FALSE );
+    }
+
+    memcpy ( transpack_merged, spr_usage, ( ( nb_of_tiles + 15 ) >> 4 ) * sizeof ( Uint32 ) );
+
+    for ( Sint32 loop = range_list_size - 1; loop >= 0; loop-- )
+    {
+        Uint32 type = range_list[loop].type;
+
+        /* Other codes than the drawing ones are not drawn */
+        if ( type > TILE_TRANS_UNKNOWN )
+        {
+            type = TILE_INVISIBLE;
+        }
+
+        for ( Uint32 tile = range_list[loop].begin; ( tile <= range_list[loop].end ) && ( tile < ( words << 4 ) ); tile++ )
+        {
+            Uint32 shift = ( tile & 0xF ) * 2;
+            Uint32 tile_type = type;
+
+            /* Unknown falls back to pen usage */
+            if ( tile_type == TILE_TRANS_UNKNOWN )
+            {
+                tile_type = ( tile < nb_of_tiles ) ? ( ( spr_usage[tile >> 4] >> shift ) & 0x3 ) : TILE_NORMAL;
+            }
+
+            transpack_merged[tile >> 4] &= ~( 0x3u << shift );
+            transpack_merged[tile >> 4] |= tile_type << shift;
+        }
+    }
+
+    transpack_usage = transpack_merged;
+
+    zlog_info ( gngeox_config.loggingCat, "Transparency pack : %d ranges merged", range_list_size );
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief Finds transparency tweak for tile.
 *
 * \param tile Todo.
@@ -192,6 +266,14 @@ SDL_bool neo_transpack_close ( void )
         free ( range_list );
     }
 
+    if ( transpack_merged != NULL )
+    {
+        qalloc_delete ( transpack_merged );
+        transpack_merged = NULL;
+    }
+
+    transpack_usage = NULL;
+
     if ( db_stmt != NULL )
     {
         result_code = sqlite3_finalize ( db_stmt );
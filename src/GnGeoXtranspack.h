@@ -20,7 +20,15 @@ typedef struct
     Uint32 type;
 } struct_gngeoxtranspack_range;
 
+#ifndef _GNGEOX_TRANSPACK_C_
+extern Uint32* transpack_usage;
+#endif // _GNGEOX_TRANSPACK_C_
+
+/* Tile type, transparency pack ranges merged over pen usage, 2 bits per tile */
+#define TILE_USAGE(tileno) ((transpack_usage[(tileno)>>4]>>(((tileno)&0xF)*2))&0x3)
+
 SDL_bool neo_transpack_init ( void ) __attribute__ ( ( warn_unused_result ) );
+SDL_bool neo_transpack_usage_init ( Uint32*, Uint32 ) __attribute__ ( ( warn_unused_result ) );
 enum_gngeoxtranspack_tile_type neo_transpack_find ( Uint32 );
 SDL_bool neo_transpack_close ( void );
 
@@ -17,6 +17,11 @@
 #define _GNGEOX_VIDEO_C_
 #endif // _GNGEOX_VIDEO_C_
 
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include "zlog.h"
@@ -29,6 +34,9 @@
 #include "GnGeoXframecap.h"
 #include "GnGeoXtranspack.h"
 #include "GnGeoXconfig.h"
+#include "GnGeoXvideosimd.h"
+#include "GnGeoXworkers.h"
+#include "GnGeoXprofiler.h"
 
 static char ddaxskip[16][16] =
 {
@@ -59,46 +67,42 @@ Uint32 ddaxskip_i[16] =
 Uint32 neogeo_frame_counter = 0;
 Uint32 neogeo_frame_counter_speed = 8;
 Uint32 frame_counter = 0;
+/* Bumped on every write that can change the rendered picture (vram, palettes, fix and palette banks) */
+Uint32 neogeo_video_generation = 0;
+/* Bumped on every write that can change the current palette (palette rams and palette bank) */
+Uint32 neogeo_palette_generation = 0;
+/* Set by a blitter that looks palette indexes up itself */
+SDL_bool neogeo_video_palette_blitter = SDL_FALSE;
+/* The last frame is only in neogeo_video_index, its colors were left to the blitter */
+SDL_bool neogeo_video_index_only = SDL_FALSE;
+/* Palette indexes (palette * 16 + pen) of the last frame drawn in indexed mode */
+Uint16 neogeo_video_index[SPRITE_LINES * INDEX_BUFFER_WIDTH];
 
 static char* dda_x_skip = NULL;
-static char dda_y_skip[17];
+static const char* dda_y_skip = NULL;
 static char full_y_skip[16] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
-static Uint32 dda_y_skip_i = 0;
 static Uint16 fix_addr[40][32];
 static Uint8 fix_shift[40];
+/* Y zoom line skipping, for each zoom and DDA phase */
+static struct_gngeoxvideo_yzoom ddayskip[256][YZOOM_PHASES];
+/* Decoded SCB2/3/4 entries and, for each visible line, a bitmap of the strips crossing it */
+static struct_gngeoxvideo_sprite sprite_table[SPRITE_TABLE_SIZE];
+static Uint32 sprite_line_bins[SPRITE_LINES][SPRITE_LINE_WORDS];
+/* First entry to decode again, SPRITE_TABLE_SIZE when the table is up to date */
+static Sint32 sprite_table_dirty = 0;
+/* Rendered fix layer, opaque pixels have FIX_OPAQUE set */
+static Uint32 fix_plane[FIX_ROWS * 8][FIX_COLUMNS * 8];
+/* For each fix row, a bit per column : cells to render again and cells with opaque pixels */
+static Uint64 fix_dirty[FIX_ROWS];
+static Uint16 fix_index_plane[FIX_ROWS * 8][FIX_COLUMNS * 8];
+static Uint64 fix_used[FIX_ROWS];
+/* Tiles of the current frame, drawn by bands of lines on the worker threads */
+static struct_gngeoxvideo_tile_cmd draw_list[DRAW_LIST_SIZE];
+static Sint32 draw_list_count = 0;
+static SDL_bool draw_indexed = SDL_FALSE;
+static Sint32 draw_bands = 1;
+static Uint64 draw_band_ticks[WORKERS_MAX + 1];
 
-/* ******************************************************************************************************************/
-/*!
-* \brief  Applies alpha transparency.
-*
-* \param  dest Destination pixel in RGB24.
-* \param  src Source pixel in RGB24.
-* \param  alpha Alpha transparency value to apply.
-* \return Alpha blended pixel.
-*/
-/* ******************************************************************************************************************/
-Uint32 alpha_blend ( Uint32 dest, Uint32 src, Uint8 alpha )
-{
-    Uint32 or = 0, og = 0, ob = 0, dr = 0, dg = 0, db = 0, sr = 0, sg = 0, sb = 0;
-    Uint32 beta = ( 255 - alpha );
-    Uint32 blended_color = 0;
-
-    dr = COLOR_RGB24_R ( dest );
-    dg = COLOR_RGB24_G ( dest );
-    db = COLOR_RGB24_B ( dest );
-
-    sr = COLOR_RGB24_R ( src );
-    sg = COLOR_RGB24_G ( src );
-    sb = COLOR_RGB24_B ( src );
-
-    or = ( ( sr * alpha ) + ( dr * beta ) ) / 255;
-    og = ( ( sg * alpha ) + ( dg * beta ) ) / 255;
-    ob = ( ( sb * alpha ) + ( db * beta ) ) / 255;
-
-    blended_color = COLOR_RGB24_MAKE ( alpha, or, og, ob );
-
-    return ( blended_color );
-}
 /* ******************************************************************************************************************/
 /*!
 * \brief Initializes sprite cache.
@@ -151,11 +155,13 @@ void SDL_textout ( Sint32 x, Sint32 y, const char* string )
 * \param size Cache size.
 * \param bsize Block size.
 * \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \note   The gno file is mapped when possible, and a thread decompresses banks of the visible strips ahead.
 */
 /* ******************************************************************************************************************/
 SDL_bool init_sprite_cache ( Uint32 size, Uint32 bsize )
 {
     struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
+    struct stat gno_stat;
 
     if ( gcache->data != NULL ) /* We already have a cache, just reset it */
     {
@@ -164,6 +170,32 @@ SDL_bool init_sprite_cache ( Uint32 size, Uint32 bsize )
         for ( Sint32 i = 0; i < gcache->max_slot; i++ )
         {
             gcache->usage[i] = -1;
+            gcache->referenced[i] = 0;
+        }
+
+        gcache->hand = 0;
+
+        /* Banks being decompressed by the prefetch thread are let through before the entries are dropped */
+        if ( gcache->thread != NULL )
+        {
+            for ( Sint32 i = 0; i < SPRITE_PREFETCH_BANKS; i++ )
+            {
+                while ( SDL_AtomicGet ( &gcache->prefetch[i].state ) == PREFETCH_QUEUED )
+                {
+                    SDL_Delay ( 1 );
+                }
+
+                gcache->prefetch[i].bank = -1;
+                gcache->prefetch[i].stamp = 0;
+                SDL_AtomicSet ( &gcache->prefetch[i].state, PREFETCH_FREE );
+            }
+
+            for ( Uint32 i = 0; i < gcache->total_bank; i++ )
+            {
+                gcache->staged[i] = -1;
+            }
+
+            gcache->stamp = 0;
         }
 
         return ( SDL_FALSE );
@@ -199,20 +231,92 @@ SDL_bool init_sprite_cache ( Uint32 size, Uint32 bsize )
         return ( SDL_FALSE );
     }
 
+    gcache->referenced = ( Uint8* ) qalloc ( gcache->max_slot );
+    if ( gcache->referenced == NULL )
+    {
+        qalloc_delete ( gcache->ptr );
+        qalloc_delete ( gcache->data );
+        qalloc_delete ( gcache->usage );
+        return ( SDL_FALSE );
+    }
+
     for ( Sint32 i = 0; i < gcache->max_slot; i++ )
     {
         gcache->usage[i] = -1;
+        gcache->referenced[i] = 0;
     }
 
+    gcache->hand = 0;
+
     gcache->in_buf = ( Uint8* ) qalloc ( compressBound ( bsize ) );
     if ( gcache->in_buf == NULL )
     {
         qalloc_delete ( gcache->ptr );
         qalloc_delete ( gcache->data );
         qalloc_delete ( gcache->usage );
+        qalloc_delete ( gcache->referenced );
         return ( SDL_FALSE );
     }
 
+    /* Compressed banks are read from the mapped file, or with pread() when it can't be mapped */
+    gcache->map = NULL;
+    gcache->map_size = 0;
+
+    if ( fstat ( fileno ( gcache->gno ), &gno_stat ) == 0 )
+    {
+        gcache->map = mmap ( NULL, gno_stat.st_size, PROT_READ, MAP_PRIVATE, fileno ( gcache->gno ), 0 );
+
+        if ( gcache->map == MAP_FAILED )
+        {
+            zlog_warn ( gngeox_config.loggingCat, "Gno file not mapped : %s", strerror ( errno ) );
+            gcache->map = NULL;
+        }
+        else
+        {
+            gcache->map_size = gno_stat.st_size;
+        }
+    }
+
+    gcache->hits = 0;
+    gcache->misses = 0;
+    gcache->stalls = 0;
+    gcache->stamp = 0;
+    SDL_AtomicSet ( &gcache->quit, 0 );
+    gcache->thread = NULL;
+
+    /* Without prefetch, banks are only decompressed when drawn */
+    gcache->staged = ( Sint16* ) qalloc ( gcache->total_bank * sizeof ( Sint16 ) );
+    gcache->prefetch_in_buf = ( Uint8* ) qalloc ( compressBound ( bsize ) );
+    gcache->prefetch[0].data = ( Uint8* ) qalloc ( SPRITE_PREFETCH_BANKS * bsize );
+    gcache->wake = SDL_CreateSemaphore ( 0 );
+
+    if ( ( gcache->staged != NULL ) && ( gcache->prefetch_in_buf != NULL ) && ( gcache->prefetch[0].data != NULL )
+            && ( gcache->wake != NULL ) )
+    {
+        for ( Uint32 i = 0; i < gcache->total_bank; i++ )
+        {
+            gcache->staged[i] = -1;
+        }
+
+        for ( Sint32 i = 0; i < SPRITE_PREFETCH_BANKS; i++ )
+        {
+            gcache->prefetch[i].data = gcache->prefetch[0].data + i * bsize;
+            gcache->prefetch[i].bank = -1;
+            gcache->prefetch[i].stamp = 0;
+            SDL_AtomicSet ( &gcache->prefetch[i].state, PREFETCH_FREE );
+        }
+
+        gcache->thread = SDL_CreateThread ( prefetch_sprite_thread, "GnGeoXprefetch", NULL );
+    }
+
+    if ( gcache->thread == NULL )
+    {
+        zlog_warn ( gngeox_config.loggingCat, "Sprite cache prefetch not started" );
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Sprite cache : %d slots of %d bytes for %d banks%s", gcache->max_slot,
+                gcache->slot_size, gcache->total_bank, ( gcache->map != NULL ) ? ", gno file mapped" : "" );
+
     return ( SDL_TRUE );
 }
 /* ******************************************************************************************************************/
@@ -225,8 +329,18 @@ void free_sprite_cache ( void )
 {
     struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
 
+    if ( gcache->thread )
+    {
+        SDL_AtomicSet ( &gcache->quit, 1 );
+        SDL_SemPost ( gcache->wake );
+        SDL_WaitThread ( gcache->thread, NULL );
+        gcache->thread = NULL;
+    }
+
     if ( gcache->data )
     {
+        zlog_info ( gngeox_config.loggingCat, "Sprite cache : %u hits, %u misses, %u stalls", gcache->hits, gcache->misses,
+                    gcache->stalls );
         qalloc_delete ( gcache->data );
         gcache->data = NULL;
     }
@@ -243,278 +357,1352 @@ void free_sprite_cache ( void )
         gcache->usage = NULL;
     }
 
+    if ( gcache->referenced )
+    {
+        qalloc_delete ( gcache->referenced );
+        gcache->referenced = NULL;
+    }
+
     if ( gcache->in_buf )
     {
         qalloc_delete ( gcache->in_buf );
         gcache->in_buf = NULL;
     }
+
+    if ( gcache->map )
+    {
+        munmap ( gcache->map, gcache->map_size );
+        gcache->map = NULL;
+    }
+
+    if ( gcache->wake )
+    {
+        SDL_DestroySemaphore ( gcache->wake );
+        gcache->wake = NULL;
+    }
+
+    if ( gcache->staged )
+    {
+        qalloc_delete ( gcache->staged );
+        gcache->staged = NULL;
+    }
+
+    if ( gcache->prefetch_in_buf )
+    {
+        qalloc_delete ( gcache->prefetch_in_buf );
+        gcache->prefetch_in_buf = NULL;
+    }
+
+    if ( gcache->prefetch[0].data )
+    {
+        qalloc_delete ( gcache->prefetch[0].data );
+        gcache->prefetch[0].data = NULL;
+    }
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Initializes sprite cache.
+* \brief  Decompresses a sprite bank from the gno file.
 *
-* \param  tileno Tile number.
-* \return Pointer to cached sprite.
+* \param  bank Bank number.
+* \param  dst Destination, slot size bytes.
+* \param  in_buf Compressed data buffer, only used when the file is not mapped.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \note   Called by the prefetch thread too, so the file position is never used.
 */
 /* ******************************************************************************************************************/
-static Uint8* get_cached_sprite_ptr ( Uint32 tileno )
+static SDL_bool read_sprite_bank ( Sint32 bank, Uint8* dst, Uint8* in_buf )
 {
     struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
-    static Sint32 pos = 0;
-    Sint32 tile_sh = ~ ( ( gcache->slot_size >> 7 ) - 1 );
-    Sint32 bank = ( ( tileno & tile_sh ) / ( gcache->slot_size >> 7 ) );
-    Sint32 a = 0;
+    const Uint8* src = NULL;
     Uint32 cmp_size = 0;
-    Uint32 dst_size = 0;
+    uLongf dst_size = gcache->slot_size;
 
-    if ( gcache->ptr[bank] )
+    if ( gcache->map != NULL )
     {
-        /* The bank is present in the cache */
-        return gcache->ptr[bank];
-    }
+        /* Truncated or corrupt gno */
+        if ( gcache->offset[bank] + sizeof ( Uint32 ) > gcache->map_size )
+        {
+            return ( SDL_FALSE );
+        }
 
-    /* We have to find a slot for this bank */
-    a = pos;
-    pos++;
+        memcpy ( &cmp_size, gcache->map + gcache->offset[bank], sizeof ( Uint32 ) );
+        src = gcache->map + gcache->offset[bank] + sizeof ( Uint32 );
 
-    if ( pos >= gcache->max_slot )
-    {
-        pos = 0;
+        if ( gcache->offset[bank] + sizeof ( Uint32 ) + cmp_size > gcache->map_size )
+        {
+            return ( SDL_FALSE );
+        }
     }
+    else
+    {
+        if ( pread ( fileno ( gcache->gno ), &cmp_size, sizeof ( Uint32 ), gcache->offset[bank] ) != sizeof ( Uint32 ) )
+        {
+            return ( SDL_FALSE );
+        }
 
-    fseek ( gcache->gno, gcache->offset[bank], SEEK_SET );
-    fread ( &cmp_size, sizeof ( Uint32 ), 1, gcache->gno );
-    fread ( gcache->in_buf, cmp_size, 1, gcache->gno );
-    dst_size = gcache->slot_size;
-    uncompress ( gcache->data + a * gcache->slot_size, &dst_size, gcache->in_buf, cmp_size );
+        if ( ( cmp_size > compressBound ( gcache->slot_size ) )
+                || ( pread ( fileno ( gcache->gno ), in_buf, cmp_size, gcache->offset[bank] + sizeof ( Uint32 ) ) != ( ssize_t ) cmp_size ) )
+        {
+            return ( SDL_FALSE );
+        }
 
-    gcache->ptr[bank] = gcache->data + a * gcache->slot_size;
+        src = in_buf;
+    }
 
-    if ( gcache->usage[a] != -1 )
+    if ( uncompress ( dst, &dst_size, src, cmp_size ) != Z_OK )
     {
-        gcache->ptr[gcache->usage[a]] = 0;
+        return ( SDL_FALSE );
     }
 
-    gcache->usage[a] = bank;
-
-    return ( gcache->ptr[bank] );
+    return ( SDL_TRUE );
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief  Initializes sprite cache.
+* \brief  Prefetch thread main loop.
 *
+* \param  data Unused.
+* \return Thread exit code.
+* \note   Only queued entries are touched here, the drawing code owns the free and ready ones.
 */
 /* ******************************************************************************************************************/
-static void fix_value_init ( void )
+static int prefetch_sprite_thread ( void* data )
 {
-    for ( Sint32 x = 0; x < 40; x++ )
+    struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
+
+    ( void ) data;
+
+    while ( 1 )
     {
-        for ( Sint32 y = 0; y < 32; y++ )
+        SDL_SemWait ( gcache->wake );
+
+        if ( SDL_AtomicGet ( &gcache->quit ) != 0 )
         {
-            fix_addr[x][y] = 0xea00 + ( y << 1 ) + 64 * ( x / 6 );
+            break;
         }
 
-        fix_shift[x] = ( 5 - ( x % 6 ) );
+        for ( Sint32 i = 0; i < SPRITE_PREFETCH_BANKS; i++ )
+        {
+            struct_gngeoxvideo_gfx_prefetch* entry = &gcache->prefetch[i];
+
+            if ( SDL_AtomicGet ( &entry->state ) != PREFETCH_QUEUED )
+            {
+                continue;
+            }
+
+            if ( read_sprite_bank ( entry->bank, entry->data, gcache->prefetch_in_buf ) == SDL_TRUE )
+            {
+                SDL_AtomicSet ( &entry->state, PREFETCH_READY );
+            }
+            else
+            {
+                SDL_AtomicSet ( &entry->state, PREFETCH_FREE );
+            }
+        }
     }
+
+    return ( 0 );
 }
-/* @todo (Tmesys#1#12/17/2022): Drawing function generation : Should be refactored using maybe function pointers. */
-/* ******************************************************************************************************************/
-/*!
-* \brief  .
-*
-*/
-/* ******************************************************************************************************************/
-#define RENAME(name) name##_tile
-#define PUTPIXEL(dst,src) dst=src
-#include "GnGeoXvideotemplate.h"
-/* ******************************************************************************************************************/
-/*!
-* \brief  .
-*
-*/
-/* ******************************************************************************************************************/
-#define RENAME(name) name##_tile_50
-#define PUTPIXEL(dst,src) dst=BLEND16_50(src,dst)
-#include "GnGeoXvideotemplate.h"
-/* ******************************************************************************************************************/
-/*!
-* \brief  .
-*
-*/
-/* ******************************************************************************************************************/
-#define RENAME(name) name##_tile_25
-#define PUTPIXEL(dst,src) dst=BLEND16_25(src,dst)
-#include "GnGeoXvideotemplate.h"
 /* ******************************************************************************************************************/
 /*!
-* \brief  Draws fix char.
+* \brief  Queues the banks of the visible strips that are not in the cache yet.
 *
-* \param  buf Tile number.
-* \param  start Tile number.
-* \param  end Tile number.
+* \note   The next frame mostly shows the same tiles, so they are ready before it is drawn. When every prefetch
+*         entry is in use, entries asked for by an older pass are taken back first.
 */
 /* ******************************************************************************************************************/
-static void draw_fix_char ( Uint8* buf, Sint32 start, Sint32 end )
+static void prefetch_sprite_banks ( void )
 {
-    Uint32* gfxdata = NULL, myword = 0;
-    Sint32 y = 0;
-    Uint32* brp = NULL;
-    Uint32* paldata = NULL;
-    Uint32 byte1 = 0, byte2 = 0;
-    Sint32 banked = 0, garouoffsets[32];
-    SDL_Rect clip;
-    Sint32 ystart = 1, yend = 32;
+    struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
+    Uint8* vidram = neogeo_memory.vid.ram;
+    Sint32 tiles_per_slot = gcache->slot_size >> 7;
+    Sint32 next_entry = 0;
+    Sint32 queued = 0;
 
-    banked = ( current_fix == neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].p && neo_rom_fix_bank_type && neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].size > 0x1000 ) ? 1 : 0;
-    if ( banked && neo_rom_fix_bank_type == 1 )
+    if ( gcache->thread == NULL )
     {
-        Sint32 garoubank = 0;
-        Sint32 k = 0;
-        y = 0;
+        return;
+    }
 
-        while ( y < 32 )
-        {
-            if ( READ_WORD ( &neogeo_memory.vid.ram[0xea00 + ( k << 1 )] ) == 0x0200 &&
-                    ( READ_WORD ( &neogeo_memory.vid.ram[0xeb00 + ( k << 1 )] ) & 0xff00 ) == 0xff00 )
-            {
+    gcache->stamp++;
 
-                garoubank = READ_WORD ( &neogeo_memory.vid.ram[0xeb00 + ( k << 1 )] ) & 3;
-                garouoffsets[y++] = garoubank;
-            }
+    /* Ready banks loaded meanwhile by the drawing code are useless now */
+    for ( Sint32 i = 0; i < SPRITE_PREFETCH_BANKS; i++ )
+    {
+        struct_gngeoxvideo_gfx_prefetch* entry = &gcache->prefetch[i];
 
-            garouoffsets[y++] = garoubank;
-            k += 2;
+        if ( ( SDL_AtomicGet ( &entry->state ) == PREFETCH_READY ) && ( gcache->ptr[entry->bank] != NULL ) )
+        {
+            gcache->staged[entry->bank] = -1;
+            entry->bank = -1;
+            SDL_AtomicSet ( &entry->state, PREFETCH_FREE );
         }
     }
 
-    if ( start != 0 && end != 0 )
+    update_sprite_table();
+
+    for ( Sint32 index = 0; index < SPRITE_TABLE_SIZE; index++ )
     {
-        ystart = start >> 3;
-        yend = ( end >> 3 ) + 1;
+        Uint32 offs = index << 7;
 
-        if ( ystart < 1 )
+        if ( !sprite_table[index].visible )
         {
-            ystart = 1;
+            continue;
         }
 
-        clip.x = 0;
-        clip.y = start + 16;
-        clip.w = sdl_surface_buffer->w;
-        clip.h = ( end - start ) + 16;
-        SDL_SetClipRect ( sdl_surface_buffer, &clip );
-    }
-
-    for ( y = ystart; y < yend; y++ )
-    {
-        for ( Sint32 x = 1; x < 39; x++ )
+        for ( Sint32 y = 0; y < sprite_table[index].my; y++ )
         {
-            byte1 = ( READ_WORD ( &neogeo_memory.vid.ram[0xE000 + ( ( y + ( x << 5 ) ) << 1 )] ) );
-            byte2 = byte1 >> 12;
-            byte1 = byte1 & 0xfff;
+            Uint32 tileno = READ_WORD ( &vidram[offs] );
+            Uint32 tileatr = READ_WORD ( &vidram[offs + 2] );
+            Sint32 bank = 0;
 
-            if ( banked )
+            offs += 4;
+
+            /* Same tile number as draw_screen(), auto animation stays in the bank */
+            for ( Uint32 bit = 0x10; bit <= 0x40; bit <<= 1 )
             {
-                switch ( neo_rom_fix_bank_type )
+                if ( ( neogeo_memory.nb_of_tiles > ( bit << 12 ) ) && ( tileatr & bit ) )
                 {
-                /* Garou, MSlug 3 */
-                case ( 1 ) :
-                    {
-                        byte1 += 0x1000 * ( garouoffsets[ ( y - 2 ) & 31] ^ 3 );
-                    }
-                    break;
-                case ( 2 ) :
-                    {
-                        byte1 += 0x1000 * fix_add ( x, y );
-                    }
-                    break;
-                default :
-                    {
-                        zlog_error ( gngeox_config.loggingCat, "Unknown fix bank type %d", neo_rom_fix_bank_type );
-                    }
-                    break;
+                    tileno += ( bit << 12 );
                 }
             }
 
-            if ( ( byte1 >= ( neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].size >> 5 ) ) || ( fix_usage[byte1] == 0x00 ) )
+            bank = sprite_tile_index ( tileno ) / tiles_per_slot;
+
+            if ( gcache->ptr[bank] != NULL )
             {
                 continue;
             }
 
-            brp = ( Uint32* ) buf + ( ( y << 3 ) ) * sdl_surface_buffer->w + ( x << 3 ) + 16;
-
-            paldata = ( Uint32* ) &current_pc_pal[16 * byte2];
-            gfxdata = ( Uint32* ) &current_fix[ byte1 << 5];
-
-            for ( Sint32 yy = 0; yy < 8; yy++ )
+            if ( ( gcache->staged[bank] >= 0 )
+                    && ( SDL_AtomicGet ( &gcache->prefetch[gcache->staged[bank]].state ) != PREFETCH_FREE ) )
             {
-                Uint8 col = 0;
+                gcache->prefetch[gcache->staged[bank]].stamp = gcache->stamp;
+                continue;
+            }
 
-                myword = gfxdata[yy];
-                col = ( myword >> 28 ) & 0xf;
+            /* Free entry, or ready one that this pass didn't ask for */
+            while ( next_entry < SPRITE_PREFETCH_BANKS )
+            {
+                struct_gngeoxvideo_gfx_prefetch* entry = &gcache->prefetch[next_entry];
+                Sint32 state = SDL_AtomicGet ( &entry->state );
 
-                if ( col )
+                if ( ( state == PREFETCH_FREE ) || ( ( state == PREFETCH_READY ) && ( entry->stamp != gcache->stamp ) ) )
                 {
-                    brp[7] = paldata[col];
+                    break;
                 }
 
-                col = ( myword >> 24 ) & 0xf;
+                next_entry++;
+            }
+
+            if ( next_entry >= SPRITE_PREFETCH_BANKS )
+            {
+                break;
+            }
+
+            if ( ( gcache->prefetch[next_entry].bank >= 0 )
+                    && ( gcache->staged[gcache->prefetch[next_entry].bank] == next_entry ) )
+            {
+                gcache->staged[gcache->prefetch[next_entry].bank] = -1;
+            }
+
+            gcache->prefetch[next_entry].bank = bank;
+            gcache->prefetch[next_entry].stamp = gcache->stamp;
+            gcache->staged[bank] = next_entry;
+            SDL_AtomicSet ( &gcache->prefetch[next_entry].state, PREFETCH_QUEUED );
+            next_entry++;
+            queued++;
+        }
+    }
+
+    if ( queued > 0 )
+    {
+        SDL_SemPost ( gcache->wake );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Finds a slot for a new bank, CLOCK order.
+*
+* \return Slot index.
+* \note   Slots used since the hand last passed get a second chance, so banks drawn every frame stay in.
+*/
+/* ******************************************************************************************************************/
+static Sint32 get_sprite_cache_slot ( void )
+{
+    struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
+    Sint32 slot = 0;
+
+    while ( 1 )
+    {
+        slot = gcache->hand;
+        gcache->hand = ( gcache->hand + 1 ) % gcache->max_slot;
+
+        if ( ( gcache->usage[slot] == -1 ) || ( gcache->referenced[slot] == 0 ) )
+        {
+            break;
+        }
+
+        gcache->referenced[slot] = 0;
+    }
+
+    if ( gcache->usage[slot] != -1 )
+    {
+        gcache->ptr[gcache->usage[slot]] = NULL;
+    }
+
+    return ( slot );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gets a cached sprite bank.
+*
+* \param  tileno Tile number.
+* \return Pointer to cached bank.
+* \note   A missing bank is taken from the prefetch entries when ready, decompressed here otherwise (stall).
+*/
+/* ******************************************************************************************************************/
+static Uint8* get_cached_sprite_ptr ( Uint32 tileno )
+{
+    struct_gngeoxvideo_gfx_cache* gcache = &neogeo_memory.vid.spr_cache;
+    Sint32 bank = tileno / ( gcache->slot_size >> 7 );
+    Sint32 slot = 0;
+    Uint8* dst = NULL;
+
+    if ( gcache->ptr[bank] )
+    {
+        /* The bank is present in the cache */
+        gcache->referenced[ ( gcache->ptr[bank] - gcache->data ) / gcache->slot_size] = 1;
+        gcache->hits++;
+
+        return gcache->ptr[bank];
+    }
+
+    gcache->misses++;
+
+    /* We have to find a slot for this bank */
+    slot = get_sprite_cache_slot();
+    dst = gcache->data + slot * gcache->slot_size;
+
+    if ( ( gcache->staged != NULL ) && ( gcache->staged[bank] >= 0 )
+            && ( SDL_AtomicGet ( &gcache->prefetch[gcache->staged[bank]].state ) == PREFETCH_READY ) )
+    {
+        struct_gngeoxvideo_gfx_prefetch* entry = &gcache->prefetch[gcache->staged[bank]];
+
+        memcpy ( dst, entry->data, gcache->slot_size );
+        entry->bank = -1;
+        SDL_AtomicSet ( &entry->state, PREFETCH_FREE );
+        gcache->staged[bank] = -1;
+    }
+    else
+    {
+        gcache->stalls++;
+
+        if ( read_sprite_bank ( bank, dst, gcache->in_buf ) == SDL_FALSE )
+        {
+            memset ( dst, 0, gcache->slot_size );
+        }
+    }
+
+    gcache->ptr[bank] = dst;
+    gcache->usage[slot] = bank;
+    gcache->referenced[slot] = 1;
+
+    return ( gcache->ptr[bank] );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gets where a sprite tile is stored.
+*
+* \param  tileno Tile number.
+* \return Tile index in the sprites region.
+* \note   Identical tiles share the same index once deduplicated.
+*/
+/* ******************************************************************************************************************/
+static Uint32 sprite_tile_index ( Uint32 tileno )
+{
+    tileno = tileno % neogeo_memory.nb_of_tiles;
+
+    if ( neogeo_memory.rom.spr_remap.p != NULL )
+    {
+        return ( ( ( const Uint32* ) neogeo_memory.rom.spr_remap.p ) [tileno] );
+    }
+
+    return ( tileno );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gets a sprite tile data.
+*
+* \param  tileno Tile number.
+* \return Pointer to the tile 128 bytes.
+*/
+/* ******************************************************************************************************************/
+static const Uint8* sprite_tile_data ( Uint32 tileno )
+{
+    tileno = sprite_tile_index ( tileno );
+
+    if ( neogeo_memory.vid.spr_cache.data != NULL )
+    {
+        return ( get_cached_sprite_ptr ( tileno ) + ( ( tileno & ( ( neogeo_memory.vid.spr_cache.slot_size >> 7 ) - 1 ) ) << 7 ) );
+    }
+
+    return ( &neogeo_memory.rom.rom_region[REGION_SPRITES].p[tileno << 7] );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Initializes sprite cache.
+*
+*/
+/* ******************************************************************************************************************/
+static void fix_value_init ( void )
+{
+    for ( Sint32 x = 0; x < 40; x++ )
+    {
+        for ( Sint32 y = 0; y < 32; y++ )
+        {
+            fix_addr[x][y] = 0xea00 + ( y << 1 ) + 64 * ( x / 6 );
+        }
+
+        fix_shift[x] = ( 5 - ( x % 6 ) );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Marks decoded sprite table as out of date.
+*
+* \param  vptr Video ram word address just written.
+* \note   Only SCB2, SCB3 and SCB4 writes matter, a strip change also affects every following chained strip
+*         so decoding restarts from the lowest written entry.
+*/
+/* ******************************************************************************************************************/
+void invalidate_sprite_table ( Uint32 vptr )
+{
+    Sint32 index = vptr & 0x1ff;
+
+    if ( ( vptr < 0x8000 ) || ( vptr >= 0x8600 ) || ( index >= SPRITE_TABLE_SIZE ) )
+    {
+        return;
+    }
+
+    if ( index < sprite_table_dirty )
+    {
+        sprite_table_dirty = index;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Marks fix layer cells as out of date.
+*
+* \param  vptr Video ram word address just written.
+* \note   Fix map is 0x7000 - 0x74FF, column major. Bank switched fix roms also read their bank registers
+*         in 0x7500 - 0x75FF.
+*/
+/* ******************************************************************************************************************/
+void invalidate_fix_cell ( Uint32 vptr )
+{
+    if ( ( vptr >= 0x7000 ) && ( vptr < 0x7500 ) )
+    {
+        fix_dirty[vptr & 0x1F] |= ( Uint64 ) 1 << ( ( vptr - 0x7000 ) >> 5 );
+    }
+    else if ( ( vptr >= 0x7500 ) && ( vptr < 0x7600 ) && ( neo_rom_fix_bank_type != 0 ) )
+    {
+        if ( neo_rom_fix_bank_type == 2 )
+        {
+            /* One word holds the banks of 6 columns, see fix_add() */
+            fix_dirty[ ( vptr + 1 ) & 0x1F] |= ( Uint64 ) 0x3F << ( ( ( vptr - 0x7500 ) >> 5 ) * 6 );
+        }
+        else
+        {
+            /* Garou, MSlug 3 : a bank applies to all the following rows */
+            invalidate_fix_layer();
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Marks the whole fix layer as out of date.
+*
+* \note   Needed on fix rom, palette bank and fix palettes (0 - 15) changes.
+*/
+/* ******************************************************************************************************************/
+void invalidate_fix_layer ( void )
+{
+    for ( Sint32 y = 0; y < FIX_ROWS; y++ )
+    {
+        fix_dirty[y] = FIX_DRAWN_COLUMNS;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Decodes sprite control blocks and sorts strips per line.
+*
+* \note   Mirrors the block / chain logic of draw_screen_scanline(), including the sx wrap that chained strips inherit.
+*/
+/* ******************************************************************************************************************/
+static void update_sprite_table ( void )
+{
+    Sint32 sx = 0, sy = 0, my = 0, zx = 1, zy = 1;
+    Sint32 first = sprite_table_dirty;
+    Uint16 scb2 = 0, scb3 = 0, scb4 = 0;
+    Uint8* vidram = neogeo_memory.vid.ram;
+    Uint32 keep_mask = 0;
+    Sint32 keep_word = 0;
+
+    if ( first >= SPRITE_TABLE_SIZE )
+    {
+        return;
+    }
+
+    /* Restart from previous strip state */
+    if ( first > 0 )
+    {
+        sx = sprite_table[first - 1].sx;
+        sy = sprite_table[first - 1].sy;
+        zx = sprite_table[first - 1].zx;
+        zy = sprite_table[first - 1].zy;
+        my = sprite_table[first - 1].my;
+    }
+
+    /* Drop bins of the entries decoded again */
+    keep_word = first >> 5;
+    keep_mask = ( 1u << ( first & 31 ) ) - 1;
+
+    for ( Sint32 line = 0; line < SPRITE_LINES; line++ )
+    {
+        sprite_line_bins[line][keep_word] &= keep_mask;
+
+        for ( Sint32 word = keep_word + 1; word < SPRITE_LINE_WORDS; word++ )
+        {
+            sprite_line_bins[line][word] = 0;
+        }
+    }
+
+    for ( Sint32 index = first; index < SPRITE_TABLE_SIZE; index++ )
+    {
+        struct_gngeoxvideo_sprite* sprite = &sprite_table[index];
+        Sint32 start = 0, end = 0;
+
+        scb2 = READ_WORD ( &vidram[0x10000 + ( index << 1 )] );
+        scb3 = READ_WORD ( &vidram[0x10400 + ( index << 1 )] );
+        scb4 = READ_WORD ( &vidram[0x10800 + ( index << 1 )] );
+
+        if ( scb3 & 0x40 )
+        {
+            sx += zx + 1;
+            zx = ( scb2 >> 8 ) & 0x0f;
+        }
+        else
+        {
+            zx = ( scb2 >> 8 ) & 0x0f;
+            zy = scb2 & 0xff;
+            sx = ( scb4 >> 7 );
+            my = SDL_min ( scb3 & 0x3f, 0x20 );
+            sy = 512 - ( scb3 >> 7 );
+        }
+
+        sprite->visible = 0;
+
+        if ( my != 0 )
+        {
+            if ( sx >= 496 )
+            {
+                sx -= 512;
+            }
+
+            sprite->visible = ( ( sx <= 320 ) && ( sx >= -16 ) );
+        }
+
+        sprite->sx = sx;
+        sprite->sy = sy;
+        sprite->zx = zx;
+        sprite->zy = zy;
+        sprite->my = my;
+
+        /* Strips out of the screen horizontally are binned too, they count in the per line sprite limit */
+        if ( my == 0 )
+        {
+            continue;
+        }
+
+        /* Lines where ( line - sy ) mod 512 < my * 16 */
+        start = sy & 0x1ff;
+        end = start + ( my << 4 );
+
+        for ( Sint32 line = start; line < SDL_min ( end, SPRITE_LINES ); line++ )
+        {
+            sprite_line_bins[line][index >> 5] |= 1u << ( index & 31 );
+        }
+
+        for ( Sint32 line = 0; line < SDL_min ( end - 512, SPRITE_LINES ); line++ )
+        {
+            sprite_line_bins[line][index >> 5] |= 1u << ( index & 31 );
+        }
+    }
+
+    sprite_table_dirty = SPRITE_TABLE_SIZE;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Initializes y zoom line skipping tables.
+*
+* \note   The DDA accumulator carries over from one tile to the next one in a strip, each table also gives the
+*         phase the following tile starts with. Phase 0 is the strip start.
+*/
+/* ******************************************************************************************************************/
+static void yzoom_value_init ( void )
+{
+    for ( Sint32 rzy = 0; rzy < 256; rzy++ )
+    {
+        for ( Sint32 phase = 0; phase < YZOOM_PHASES; phase++ )
+        {
+            struct_gngeoxvideo_yzoom* yzoom = &ddayskip[rzy][phase];
+            Sint32 dday = phase << 4, yskip = 0;
+
+            memset ( yzoom->skip, 0, sizeof ( yzoom->skip ) );
+
+            for ( Uint32 i = 0; i < 16; i++ )
+            {
+                dday -= ( rzy + 1 );
+
+                if ( dday <= 0 )
+                {
+                    dday += 256;
+                    yskip++;
+                }
+
+                yzoom->skip[yskip]++;
+            }
+
+            yzoom->rows = yskip;
+            yzoom->next = dday >> 4;
+        }
+    }
+}
+/* @todo (Tmesys#1#12/17/2022): Drawing function generation : Should be refactored using maybe function pointers. */
+/* ******************************************************************************************************************/
+/*!
+* \brief  .
+*
+*/
+/* ******************************************************************************************************************/
+#define RENAME(name) name##_tile
+#define ROWSMODE TILE_ROWS_OPAQUE
+#define PUTPIXEL(dst,src) dst=src
+#include "GnGeoXvideotemplate.h"
+/* ******************************************************************************************************************/
+/*!
+* \brief  .
+*
+*/
+/* ******************************************************************************************************************/
+#define RENAME(name) name##_tile_50
+#define ROWSMODE TILE_ROWS_BLEND50
+#define PUTPIXEL(dst,src) dst=BLEND16_50(src,dst)
+#include "GnGeoXvideotemplate.h"
+/* ******************************************************************************************************************/
+/*!
+* \brief  .
+*
+*/
+/* ******************************************************************************************************************/
+#define RENAME(name) name##_tile_25
+#define ROWSMODE TILE_ROWS_BLEND25
+#define PUTPIXEL(dst,src) dst=BLEND16_25(src,dst)
+#include "GnGeoXvideotemplate.h"
+/* ******************************************************************************************************************/
+/*!
+* \brief  Renders again the fix layer cells that changed.
+*
+* \param  ystart First fix row.
+* \param  yend Last fix row + 1.
+* \note   Each cell is rendered both in colors and in palette indexes.
+*/
+/* ******************************************************************************************************************/
+static void update_fix_plane ( Sint32 ystart, Sint32 yend )
+{
+    Uint32* gfxdata = NULL, myword = 0;
+    Sint32 y = 0;
+    Uint32* brp = NULL;
+    Uint16* index = NULL;
+    Uint32* paldata = NULL;
+    Uint32 byte1 = 0, byte2 = 0;
+    Sint32 banked = 0, garouoffsets[32];
+    Uint64 dirty = 0;
+
+    for ( y = ystart; y < yend; y++ )
+    {
+        dirty |= fix_dirty[y];
+    }
+
+    banked = ( current_fix == neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].p && neo_rom_fix_bank_type && neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].size > 0x1000 ) ? 1 : 0;
+    if ( dirty && banked && neo_rom_fix_bank_type == 1 )
+    {
+        Sint32 garoubank = 0;
+        Sint32 k = 0;
+        y = 0;
+
+        while ( y < 32 )
+        {
+            if ( READ_WORD ( &neogeo_memory.vid.ram[0xea00 + ( k << 1 )] ) == 0x0200 &&
+                    ( READ_WORD ( &neogeo_memory.vid.ram[0xeb00 + ( k << 1 )] ) & 0xff00 ) == 0xff00 )
+            {
+
+                garoubank = READ_WORD ( &neogeo_memory.vid.ram[0xeb00 + ( k << 1 )] ) & 3;
+                garouoffsets[y++] = garoubank;
+            }
+
+            garouoffsets[y++] = garoubank;
+            k += 2;
+        }
+    }
+
+    /* Render again the cells that changed */
+    for ( y = ystart; y < yend; y++ )
+    {
+        Uint64 cells = fix_dirty[y] & FIX_DRAWN_COLUMNS;
+
+        fix_dirty[y] &= ~cells;
+
+        while ( cells )
+        {
+            Sint32 x = __builtin_ctzll ( cells );
+
+            cells &= cells - 1;
+            brp = &fix_plane[y << 3][x << 3];
+            index = &fix_index_plane[y << 3][x << 3];
+
+            byte1 = ( READ_WORD ( &neogeo_memory.vid.ram[0xE000 + ( ( y + ( x << 5 ) ) << 1 )] ) );
+            byte2 = byte1 >> 12;
+            byte1 = byte1 & 0xfff;
+
+            if ( banked )
+            {
+                switch ( neo_rom_fix_bank_type )
+                {
+                /* Garou, MSlug 3 */
+                case ( 1 ) :
+                    {
+                        byte1 += 0x1000 * ( garouoffsets[ ( y - 2 ) & 31] ^ 3 );
+                    }
+                    break;
+                case ( 2 ) :
+                    {
+                        byte1 += 0x1000 * fix_add ( x, y );
+                    }
+                    break;
+                default :
+                    {
+                        zlog_error ( gngeox_config.loggingCat, "Unknown fix bank type %d", neo_rom_fix_bank_type );
+                    }
+                    break;
+                }
+            }
+
+            if ( ( byte1 >= ( neogeo_memory.rom.rom_region[REGION_FIXED_LAYER_CARTRIDGE].size >> 5 ) ) || ( fix_usage[byte1] == 0x00 ) )
+            {
+                fix_used[y] &= ~( ( Uint64 ) 1 << x );
+
+                for ( Sint32 yy = 0; yy < 8; yy++ )
+                {
+                    memset ( &brp[yy * FIX_COLUMNS * 8], 0, 8 * sizeof ( Uint32 ) );
+                    memset ( &index[yy * FIX_COLUMNS * 8], 0, 8 * sizeof ( Uint16 ) );
+                }
+
+                continue;
+            }
+
+            fix_used[y] |= ( Uint64 ) 1 << x;
+
+            paldata = ( Uint32* ) &current_pc_pal[16 * byte2];
+            gfxdata = ( Uint32* ) &current_fix[ byte1 << 5];
+
+            for ( Sint32 yy = 0; yy < 8; yy++ )
+            {
+                myword = gfxdata[yy];
+
+                for ( Sint32 pixel = 0; pixel < 8; pixel++ )
+                {
+                    Uint8 col = ( myword >> ( pixel << 2 ) ) & 0xf;
+
+                    brp[pixel] = col ? ( paldata[col] | FIX_OPAQUE ) : 0;
+                    index[pixel] = col ? ( ( byte2 << 4 ) | col ) : 0;
+                }
+
+                brp += FIX_COLUMNS * 8;
+                index += FIX_COLUMNS * 8;
+            }
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws fix char.
+*
+* \param  buf Tile number.
+* \param  start Tile number.
+* \param  end Tile number.
+*/
+/* ******************************************************************************************************************/
+static void draw_fix_char ( Uint8* buf, Sint32 start, Sint32 end )
+{
+    Sint32 y = 0;
+    Uint32* brp = NULL;
+    SDL_Rect clip;
+    Sint32 ystart = 1, yend = 32;
+
+    if ( start != 0 && end != 0 )
+    {
+        ystart = start >> 3;
+        yend = ( end >> 3 ) + 1;
+
+        if ( ystart < 1 )
+        {
+            ystart = 1;
+        }
+
+        clip.x = 0;
+        clip.y = start + 16;
+        clip.w = sdl_surface_buffer->w;
+        clip.h = ( end - start ) + 16;
+        SDL_SetClipRect ( sdl_surface_buffer, &clip );
+    }
+
+    update_fix_plane ( ystart, yend );
+
+    /* Copy the opaque pixels of each run of non empty cells */
+    for ( y = ystart; y < yend; y++ )
+    {
+        Uint64 cells = fix_used[y];
+
+        while ( cells )
+        {
+            Sint32 first = __builtin_ctzll ( cells );
+            Sint32 count = __builtin_ctzll ( ~ ( cells >> first ) );
+
+            cells &= ~ ( ( ( ( Uint64 ) 1 << count ) - 1 ) << first );
+            brp = ( Uint32* ) buf + ( ( y << 3 ) ) * sdl_surface_buffer->w + ( first << 3 ) + 16;
+
+            for ( Sint32 yy = 0; yy < 8; yy++ )
+            {
+                neo_video_simd_mask_row ( brp, &fix_plane[ ( y << 3 ) + yy][first << 3], count << 3 );
+                brp += sdl_surface_buffer->w;
+            }
+        }
+    }
+
+    if ( start != 0 && end != 0 )
+    {
+        SDL_SetClipRect ( sdl_surface_buffer, NULL );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Checks if sprites can be drawn by bands on the worker threads.
+*
+* \return SDL_TRUE when band rendering is possible, SDL_FALSE otherwise.
+* \note   Bands need the vectorized kernels, the scalar code uses the shared dda_x_skip, and the whole sprite rom
+*         since the .gno cache can evict a tile while it is still queued.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool draw_bands_available ( void )
+{
+    if ( ( neo_workers_count() < 2 ) || ( neo_video_simd_rows[TILE_ROWS_OPAQUE] == NULL )
+            || ( neogeo_memory.vid.spr_cache.data != NULL ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Checks if the frame can be drawn as palette indexes.
+*
+* \return SDL_TRUE when indexed rendering is enabled and possible, SDL_FALSE otherwise.
+* \note   Translucent tiles only come from a transparency pack, they need the colors below them.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool draw_indexed_available ( void )
+{
+    if ( ( gngeox_config.indexed == SDL_FALSE ) || ( neogeo_memory.vid.spr_cache.data != NULL )
+            || ( transpack_usage != ( Uint32* ) neogeo_memory.rom.spr_usage.p )
+            || ( sdl_surface_buffer->w > INDEX_BUFFER_WIDTH ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque fix layer indexes of some lines.
+*
+* \param  top First line.
+* \param  bottom Last line + 1.
+*/
+/* ******************************************************************************************************************/
+static void draw_fix_index_lines ( Sint32 top, Sint32 bottom )
+{
+    for ( Sint32 line = SDL_max ( top, 8 ); line < bottom; line++ )
+    {
+        Uint64 cells = fix_used[line >> 3];
+
+        while ( cells )
+        {
+            Sint32 first = __builtin_ctzll ( cells );
+            Sint32 count = __builtin_ctzll ( ~ ( cells >> first ) );
+            const Uint16* src = &fix_index_plane[line][first << 3];
+            Uint16* dst = &neogeo_video_index[line * INDEX_BUFFER_WIDTH + ( first << 3 ) + 16];
+
+            cells &= ~ ( ( ( ( Uint64 ) 1 << count ) - 1 ) << first );
+
+            for ( Sint32 pixel = 0; pixel < ( count << 3 ); pixel++ )
+            {
+                if ( src[pixel] & 0xF )
+                {
+                    dst[pixel] = src[pixel];
+                }
+            }
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Queues a tile for band rendering, same parameters as draw_tile().
+*
+* \param  tileno Tile number.
+* \param  sx Buffer x position.
+* \param  sy Buffer y position.
+* \param  zx Drawn width.
+* \param  zy Drawn rows.
+* \param  color Palette.
+* \param  xflip Horizontal flip.
+* \param  yflip Vertical flip.
+* \param  penusage Tile usage (TILE_NORMAL, TILE_TRANSPARENT25 or TILE_TRANSPARENT50).
+*/
+/* ******************************************************************************************************************/
+static void draw_list_add ( Uint32 tileno, Sint32 sx, Sint32 sy, Sint32 zx, Sint32 zy, Sint32 color, Sint32 xflip,
+                            Sint32 yflip, Uint8 penusage )
+{
+    struct_gngeoxvideo_tile_cmd* cmd = &draw_list[draw_list_count++];
+
+    cmd->gfxdata = ( const Uint32* ) sprite_tile_data ( tileno );
+    cmd->paldata = ( Uint32* ) &current_pc_pal[16 * color];
+    cmd->pen_base = 16 * color;
+    cmd->y_skip = ( zy == 16 ) ? full_y_skip : dda_y_skip;
+    cmd->masks = TILE_ROWS ( tileno );
+    cmd->sx = sx;
+    cmd->sy = sy;
+    cmd->rows = zy;
+    cmd->zoom = zx - 1;
+    cmd->xflip = xflip;
+    cmd->yflip = yflip;
+
+    switch ( penusage )
+    {
+    case ( TILE_TRANSPARENT25 ) :
+        {
+            cmd->mode = TILE_ROWS_BLEND25;
+        }
+        break;
+    case ( TILE_TRANSPARENT50 ) :
+        {
+            cmd->mode = TILE_ROWS_BLEND50;
+        }
+        break;
+    default :
+        {
+            cmd->mode = TILE_ROWS_OPAQUE;
+        }
+        break;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws a band of lines as palette indexes, then converts it to colors.
+*
+* \param  top First line.
+* \param  bottom Last line + 1.
+* \note   The conversion is skipped when the blitter looks colors up itself.
+*/
+/* ******************************************************************************************************************/
+static void draw_band_indexed ( Sint32 top, Sint32 bottom )
+{
+    Sint32 width = sdl_surface_buffer->w;
+
+    for ( Sint32 line = top; line < bottom; line++ )
+    {
+        Uint16* row = &neogeo_video_index[line * INDEX_BUFFER_WIDTH];
+
+        for ( Sint32 pixel = 0; pixel < INDEX_BUFFER_WIDTH; pixel++ )
+        {
+            row[pixel] = 4095;
+        }
+    }
+
+    for ( Sint32 i = 0; i < draw_list_count; i++ )
+    {
+        const struct_gngeoxvideo_tile_cmd* cmd = &draw_list[i];
+        Uint16* br = NULL;
+        Sint32 first = 0, last = 0, step = 0, skipped = 0;
+
+        if ( ( cmd->sy >= bottom ) || ( cmd->sy + cmd->rows <= top ) )
+        {
+            continue;
+        }
+
+        if ( cmd->yflip )
+        {
+            first = SDL_max ( 0, cmd->sy + cmd->rows - bottom );
+            last = SDL_min ( cmd->rows, cmd->sy + cmd->rows - top );
+            br = &neogeo_video_index[ ( cmd->sy + cmd->rows - 1 - first ) * INDEX_BUFFER_WIDTH + cmd->sx];
+            step = -INDEX_BUFFER_WIDTH;
+        }
+        else
+        {
+            first = SDL_max ( 0, top - cmd->sy );
+            last = SDL_min ( cmd->rows, bottom - cmd->sy );
+            br = &neogeo_video_index[ ( cmd->sy + first ) * INDEX_BUFFER_WIDTH + cmd->sx];
+            step = INDEX_BUFFER_WIDTH;
+        }
+
+        for ( Sint32 row = 0; row < first; row++ )
+        {
+            skipped += cmd->y_skip[row];
+        }
+
+        neo_video_simd_index_rows ( br, step, cmd->gfxdata + ( skipped << 1 ), cmd->y_skip + first, last - first,
+                                    cmd->pen_base, cmd->xflip, cmd->zoom, TILE_ROWS_FROM ( cmd->masks, skipped ) );
+    }
+
+    draw_fix_index_lines ( top, bottom );
+
+    if ( neogeo_video_index_only == SDL_TRUE )
+    {
+        return;
+    }
+
+    for ( Sint32 line = top; line < bottom; line++ )
+    {
+        neo_video_simd_index_row ( ( Uint32* ) sdl_surface_buffer->pixels + line * PIXEL_PITCH,
+                                   &neogeo_video_index[line * INDEX_BUFFER_WIDTH], width, current_pc_pal );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws queued tiles rows that fall in a band of lines.
+*
+* \param  data Unused.
+* \param  band Band index.
+* \note   Tiles are replayed in queue order, so the strips priority is the same as draw_screen().
+*/
+/* ******************************************************************************************************************/
+static void draw_band ( void* data, Sint32 band )
+{
+    Sint32 top = ( band * SPRITE_LINES ) / draw_bands;
+    Sint32 bottom = ( ( band + 1 ) * SPRITE_LINES ) / draw_bands;
+    Sint32 pixel_pitch = PIXEL_PITCH;
+    Uint64 ticks = SDL_GetPerformanceCounter();
+
+    ( void ) data;
+
+    if ( draw_indexed == SDL_TRUE )
+    {
+        draw_band_indexed ( top, bottom );
+        draw_band_ticks[band] = SDL_GetPerformanceCounter() - ticks;
+        return;
+    }
+
+    for ( Sint32 i = 0; i < draw_list_count; i++ )
+    {
+        const struct_gngeoxvideo_tile_cmd* cmd = &draw_list[i];
+        Uint32* br = NULL;
+        Sint32 first = 0, last = 0, step = 0, skipped = 0;
+
+        if ( ( cmd->sy >= bottom ) || ( cmd->sy + cmd->rows <= top ) )
+        {
+            continue;
+        }
+
+        /* Tile rows first and last + 1 land in the band */
+        if ( cmd->yflip )
+        {
+            first = SDL_max ( 0, cmd->sy + cmd->rows - bottom );
+            last = SDL_min ( cmd->rows, cmd->sy + cmd->rows - top );
+            br = ( Uint32* ) sdl_surface_buffer->pixels + ( cmd->sy + cmd->rows - 1 - first ) * pixel_pitch + cmd->sx;
+            step = -pixel_pitch;
+        }
+        else
+        {
+            first = SDL_max ( 0, top - cmd->sy );
+            last = SDL_min ( cmd->rows, bottom - cmd->sy );
+            br = ( Uint32* ) sdl_surface_buffer->pixels + ( cmd->sy + first ) * pixel_pitch + cmd->sx;
+            step = pixel_pitch;
+        }
+
+        for ( Sint32 row = 0; row < first; row++ )
+        {
+            skipped += cmd->y_skip[row];
+        }
+
+        neo_video_simd_rows[cmd->mode] ( br, step, cmd->gfxdata + ( skipped << 1 ), cmd->y_skip + first, last - first,
+                                         cmd->paldata, cmd->xflip, cmd->zoom, TILE_ROWS_FROM ( cmd->masks, skipped ) );
+    }
+
+    draw_band_ticks[band] = SDL_GetPerformanceCounter() - ticks;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Checks if colors of a frame drawn as palette indexes can be left to the blitter.
+*
+* \return SDL_TRUE when the blitter looks colors up itself, SDL_FALSE otherwise.
+* \note   Blending and the fps counter work on colors, so they still need the conversion.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool draw_index_only_available ( void )
+{
+    if ( ( neogeo_video_palette_blitter == SDL_FALSE ) || ( gngeox_config.blending == SDL_TRUE )
+            || ( gngeox_config.showfps == SDL_TRUE ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gets the tile of a strip crossing a line.
+*
+* \param  sprite Decoded strip.
+* \param  index Strip index.
+* \param  line Buffer line.
+* \param  yoffs Tile row drawn on the line.
+* \param  tileatr Tile attributes.
+* \return Tile number.
+* \note   Uses the y zoom rom, like the hardware does.
+*/
+/* ******************************************************************************************************************/
+static Sint32 sprite_line_tile ( const struct_gngeoxvideo_sprite* sprite, Sint32 index, Sint32 line, Sint32* yoffs,
+                                 Sint32* tileatr )
+{
+    Uint8* vidram = neogeo_memory.vid.ram;
+    Uint8* zoomy_rom = neogeo_memory.ng_lo + ( sprite->zy << 8 );
+    Sint32 offs = index << 7;
+    Sint32 y = ( line - sprite->sy ) & 0x1ff; /* y: 0 -> my*16 */
+    Sint32 zoom_line = y & 0xff;
+    Sint32 invert = 0;
+    Sint32 tile = 0, tileno = 0;
+
+    if ( y & 0x100 )
+    {
+        zoom_line ^= 0xff; /* zoom_line = 255 - zoom_line */
+        invert = 1;
+    }
+
+    if ( sprite->my == 0x20 ) /* fix for joyjoy, trally... */
+    {
+        if ( sprite->zy )
+        {
+            zoom_line %= ( sprite->zy << 1 );
+
+            if ( zoom_line >= sprite->zy )
+            {
+                zoom_line = ( sprite->zy << 1 ) - 1 - zoom_line;
+                invert ^= 1;
+            }
+        }
+    }
+
+    *yoffs = zoomy_rom[zoom_line] & 0x0f;
+    tile = zoomy_rom[zoom_line] >> 4;
+
+    if ( invert )
+    {
+        tile ^= 0x1f; // tile=31 - tile;
+        *yoffs ^= 0x0f; // yoffs= 15 - yoffs;
+    }
+
+    tileno = READ_WORD ( &vidram[offs + ( tile << 2 )] );
+    *tileatr = READ_WORD ( &vidram[offs + ( tile << 2 ) + 2] );
+
+    if ( neogeo_memory.nb_of_tiles > 0x10000 && ( *tileatr & 0x10 ) )
+    {
+        tileno += 0x10000;
+    }
+
+    if ( neogeo_memory.nb_of_tiles > 0x20000 && ( *tileatr & 0x20 ) )
+    {
+        tileno += 0x20000;
+    }
+
+    if ( neogeo_memory.nb_of_tiles > 0x40000 && ( *tileatr & 0x40 ) )
+    {
+        tileno += 0x40000;
+    }
+
+    /* animation automatique */
+    if ( *tileatr & 0x8 )
+    {
+        tileno = ( tileno & ~7 ) + ( ( tileno + neogeo_frame_counter ) & 7 );
+    }
+    else
+    {
+        if ( *tileatr & 0x4 )
+        {
+            tileno = ( tileno & ~3 ) + ( ( tileno + neogeo_frame_counter ) & 3 );
+        }
+    }
+
+    if ( *tileatr & 0x02 )
+    {
+        *yoffs ^= 0x0f;    /* flip y */
+    }
+
+    return ( tileno );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Checks if frames can be drawn line by line in a line buffer.
+*
+* \return SDL_TRUE when possible, SDL_FALSE otherwise.
+* \note   Transparency packs need colors while drawing, so they keep the other renderers.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool draw_lines_available ( void )
+{
+    if ( ( gngeox_config.linebuffer == SDL_FALSE )
+            || ( transpack_usage != ( Uint32* ) neogeo_memory.rom.spr_usage.p )
+            || ( sdl_surface_buffer->w > INDEX_BUFFER_WIDTH ) )
+    {
+        return ( SDL_FALSE );
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws a line like the LSPC does.
+*
+* \param  line Buffer line.
+* \note   Strips crossing the line are taken in SCB order and only the first SPRITES_PER_LINE ones are drawn, the
+*         following ones disappear as on the hardware. Their 16 pixels slivers go as palette indexes in the line
+*         buffer, which is the line row of neogeo_video_index, then the fix layer goes on top and the whole line
+*         is converted to colors at once.
+*/
+/* ******************************************************************************************************************/
+static void draw_line ( Sint32 line )
+{
+    Uint16* line_buffer = &neogeo_video_index[line * INDEX_BUFFER_WIDTH];
+    Sint32 sprites = 0;
+
+    for ( Sint32 pixel = 0; pixel < INDEX_BUFFER_WIDTH; pixel++ )
+    {
+        line_buffer[pixel] = 4095;
+    }
+
+    for ( Sint32 word = 0; ( word < SPRITE_LINE_WORDS ) && ( sprites < SPRITES_PER_LINE ); word++ )
+    {
+        Uint32 bits = sprite_line_bins[line][word];
 
-                if ( col )
-                {
-                    brp[6] = paldata[col];
-                }
+        while ( bits && ( sprites < SPRITES_PER_LINE ) )
+        {
+            Sint32 index = ( word << 5 ) + __builtin_ctz ( bits );
+            const struct_gngeoxvideo_sprite* sprite = &sprite_table[index];
+            Sint32 tileno = 0, tileatr = 0, yoffs = 0;
 
-                col = ( myword >> 20 ) & 0xf;
+            bits &= bits - 1;
+            sprites++;
 
-                if ( col )
-                {
-                    brp[5] = paldata[col];
-                }
+            if ( !sprite->visible )
+            {
+                continue;
+            }
 
-                col = ( myword >> 16 ) & 0xf;
+            tileno = sprite_line_tile ( sprite, index, line, &yoffs, &tileatr );
 
-                if ( col )
-                {
-                    brp[4] = paldata[col];
-                }
+            if ( ( Uint32 ) tileno >= neogeo_memory.nb_of_tiles )
+            {
+                continue;
+            }
 
-                col = ( myword >> 12 ) & 0xf;
+            if ( TILE_USAGE ( tileno ) == TILE_INVISIBLE )
+            {
+                continue;
+            }
 
-                if ( col )
-                {
-                    brp[3] = paldata[col];
-                }
+            neo_video_simd_index_rows ( &line_buffer[sprite->sx + 16], 0,
+                                        ( const Uint32* ) sprite_tile_data ( tileno ) + ( yoffs << 1 ),
+                                        neo_video_simd_no_skip, 1, ( tileatr >> 8 ) << 4, tileatr & 0x01, sprite->zx,
+                                        TILE_ROWS_FROM ( TILE_ROWS ( tileno ), yoffs ) );
+        }
+    }
 
-                col = ( myword >> 8 ) & 0xf;
+    draw_fix_index_lines ( line, line + 1 );
 
-                if ( col )
-                {
-                    brp[2] = paldata[col];
-                }
+    if ( neogeo_video_index_only == SDL_FALSE )
+    {
+        neo_video_simd_index_row ( ( Uint32* ) sdl_surface_buffer->pixels + line * PIXEL_PITCH, line_buffer,
+                                   sdl_surface_buffer->w, current_pc_pal );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws a band of lines with the line renderer.
+*
+* \param  data Lines range, first and last + 1.
+* \param  band Band index.
+*/
+/* ******************************************************************************************************************/
+static void draw_lines_band ( void* data, Sint32 band )
+{
+    const Sint32* range = ( const Sint32* ) data;
+    Sint32 lines = range[1] - range[0];
+    Sint32 top = range[0] + ( band * lines ) / draw_bands;
+    Sint32 bottom = range[0] + ( ( band + 1 ) * lines ) / draw_bands;
 
-                col = ( myword >> 4 ) & 0xf;
+    for ( Sint32 line = top; line < bottom; line++ )
+    {
+        draw_line ( line );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws some lines with the line renderer.
+*
+* \param  top First line.
+* \param  bottom Last line + 1.
+* \note   Lines don't depend on each other, so they are shared between the worker threads, except with the sprite
+*         cache that may load banks while drawing.
+*/
+/* ******************************************************************************************************************/
+static void draw_lines ( Sint32 top, Sint32 bottom )
+{
+    Sint32 range[2] = { top, bottom };
 
-                if ( col )
-                {
-                    brp[1] = paldata[col];
-                }
+    if ( top >= bottom )
+    {
+        return;
+    }
 
-                col = ( myword >> 0 ) & 0xf;
+    update_sprite_table();
+    update_fix_plane ( SDL_max ( top >> 3, 1 ), SDL_min ( ( bottom + 7 ) >> 3, FIX_ROWS ) );
 
-                if ( col )
-                {
-                    brp[0] = paldata[col];
-                }
+    SDL_LockSurface ( sdl_surface_buffer );
 
-                brp += sdl_surface_buffer->w;
-            }
-        }
+    if ( ( neo_workers_count() > 1 ) && ( neogeo_memory.vid.spr_cache.data == NULL ) && ( bottom - top >= 16 ) )
+    {
+        draw_bands = SDL_min ( neo_workers_count(), WORKERS_MAX + 1 );
+        neo_workers_run ( draw_lines_band, range, draw_bands );
     }
-
-    if ( start != 0 && end != 0 )
+    else
     {
-        SDL_SetClipRect ( sdl_surface_buffer, NULL );
+        for ( Sint32 line = top; line < bottom; line++ )
+        {
+            draw_line ( line );
+        }
     }
+
+    SDL_UnlockSurface ( sdl_surface_buffer );
 }
 /* ******************************************************************************************************************/
 /*!
@@ -532,9 +1720,36 @@ void draw_screen ( void )
     Uint8* vidram = neogeo_memory.vid.ram;
     Uint8 penusage;
 
-    SDL_FillRect ( sdl_surface_buffer, NULL, current_pc_pal[4095] );
+    SDL_bool bands = SDL_FALSE;
+
+    if ( draw_lines_available() == SDL_TRUE )
+    {
+        neogeo_video_index_only = draw_index_only_available();
+        draw_lines ( visible_area.y, visible_area.y + visible_area.h );
+
+        if ( neogeo_memory.vid.spr_cache.data != NULL )
+        {
+            prefetch_sprite_banks();
+        }
+
+        neo_screen_efects_apply();
+
+        return;
+    }
+
+    draw_indexed = draw_indexed_available();
+    neogeo_video_index_only = ( draw_indexed == SDL_TRUE ) ? draw_index_only_available() : SDL_FALSE;
+    bands = ( draw_indexed == SDL_TRUE ) ? SDL_TRUE : draw_bands_available();
+
+    if ( draw_indexed == SDL_FALSE )
+    {
+        SDL_FillRect ( sdl_surface_buffer, NULL, current_pc_pal[4095] );
+    }
+
     SDL_LockSurface ( sdl_surface_buffer );
 
+    draw_list_count = 0;
+
     /* Draw sprites */
     for ( Uint32 count = 0; count < 768; count += 2 )
     {
@@ -665,7 +1880,7 @@ void draw_screen ( void )
         }
         else
         {
-            dday = 0;    /* =256; NS990105 mslug fix */
+            dday = 0;    /* =256; NS990105 mslug fix, DDA phase from here */
         }
 
         offs = count << 6;
@@ -738,78 +1953,59 @@ void draw_screen ( void )
 
             if ( rzy != 255 )
             {
-                yskip = 0;
-                dda_y_skip_i = 0;
-                dda_y_skip[0] = 0;
-
-                for ( Uint32 i = 0; i < 16; i++ )
-                {
-                    dda_y_skip[i + 1] = 0;
-                    dday -= ( rzy + 1 );
-
-                    if ( dday <= 0 )
-                    {
-                        dday += 256;
-                        yskip++;
-                        dda_y_skip[yskip]++;
-                    }
-                    else
-                    {
-                        dda_y_skip[yskip]++;
-                    }
-
-                    //if (dda_y_skip[i])
-                    //       dda_y_skip_i=dda_y_skip_i|(1<<i);
-                }
+                dda_y_skip = ddayskip[rzy][dday].skip;
+                yskip = ddayskip[rzy][dday].rows;
+                dday = ddayskip[rzy][dday].next;
             }
 
             if ( sx >= -16 && sx + 15 < 336 && sy >= 0 && sy + 15 < 256 )
             {
-                penusage = neo_transpack_find ( tileno );
-                if ( penusage == TILE_TRANS_UNKNOWN )
-                {
-                    penusage = PEN_USAGE ( tileno );
-                }
-
-                if ( neogeo_memory.vid.spr_cache.data )
-                {
-                    neogeo_memory.rom.rom_region[REGION_SPRITES].p = get_cached_sprite_ptr ( tileno );
-                    tileno = ( tileno & ( ( neogeo_memory.vid.spr_cache.slot_size >> 7 ) - 1 ) );
-                }
+                penusage = TILE_USAGE ( tileno );
 
-                switch ( penusage )
+                if ( bands == SDL_TRUE )
                 {
-                case ( TILE_NORMAL ) :
-                    {
-                        draw_tile ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
-                                    tileatr & 0x01, tileatr & 0x02,
-                                    ( Uint8* ) sdl_surface_buffer->pixels );
-                    }
-                    break;
-                case ( TILE_TRANSPARENT25 ) :
+                    if ( penusage != TILE_INVISIBLE )
                     {
-                        draw_tile_25 ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
-                                       tileatr & 0x01, tileatr & 0x02,
-                                       ( Uint8* ) sdl_surface_buffer->pixels );
+                        draw_list_add ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8, tileatr & 0x01, tileatr & 0x02,
+                                        penusage );
                     }
-                    break;
-                case ( TILE_TRANSPARENT50 ) :
+                }
+                else
+                {
+                    switch ( penusage )
                     {
-                        draw_tile_50 ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
-                                       tileatr & 0x01, tileatr & 0x02,
-                                       ( Uint8* ) sdl_surface_buffer->pixels );
+                    case ( TILE_NORMAL ) :
+                        {
+                            draw_tile ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+                                        tileatr & 0x01, tileatr & 0x02,
+                                        ( Uint8* ) sdl_surface_buffer->pixels );
+                        }
+                        break;
+                    case ( TILE_TRANSPARENT25 ) :
+                        {
+                            draw_tile_25 ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+                                           tileatr & 0x01, tileatr & 0x02,
+                                           ( Uint8* ) sdl_surface_buffer->pixels );
+                        }
+                        break;
+                    case ( TILE_TRANSPARENT50 ) :
+                        {
+                            draw_tile_50 ( tileno, sx + 16, sy, rzx, yskip, tileatr >> 8,
+                                           tileatr & 0x01, tileatr & 0x02,
+                                           ( Uint8* ) sdl_surface_buffer->pixels );
+                        }
+                        break;
+                        /*
+                          default:
+                              {
+                                  SDL_Rect r={sx+16,sy,rzx,yskip};
+                                  SDL_FillRect(sdl_surface_buffer,&r,0xFFAA);
+                              }
+                              //((Uint16*)(sdl_surface_buffer->pixels))[sx+16+sy*356]=0xFFFF;
+
+                              break;
+                         */
                     }
-                    break;
-                    /*
-                      default:
-                          {
-                              SDL_Rect r={sx+16,sy,rzx,yskip};
-                              SDL_FillRect(sdl_surface_buffer,&r,0xFFAA);
-                          }
-                          //((Uint16*)(sdl_surface_buffer->pixels))[sx+16+sy*356]=0xFFFF;
-
-                          break;
-                     */
                 }
             }
 
@@ -817,9 +2013,32 @@ void draw_screen ( void )
         } /* for y */
     } /* for count */
 
-    draw_fix_char ( sdl_surface_buffer->pixels, 0, 0 );
+    if ( draw_indexed == SDL_TRUE )
+    {
+        update_fix_plane ( 1, 32 );
+    }
+
+    if ( bands == SDL_TRUE )
+    {
+        draw_bands = SDL_min ( neo_workers_count(), WORKERS_MAX + 1 );
+        neo_workers_run ( draw_band, NULL, draw_bands );
+
+#ifdef ENABLE_PROFILER
+        profiler_bands ( draw_band_ticks, draw_bands );
+#endif // ENABLE_PROFILER
+    }
+
+    if ( draw_indexed == SDL_FALSE )
+    {
+        draw_fix_char ( sdl_surface_buffer->pixels, 0, 0 );
+    }
     SDL_UnlockSurface ( sdl_surface_buffer );
 
+    if ( neogeo_memory.vid.spr_cache.data != NULL )
+    {
+        prefetch_sprite_banks();
+    }
+
     neo_screen_efects_apply();
 }
 /* ******************************************************************************************************************/
@@ -833,17 +2052,11 @@ void draw_screen ( void )
 /* ******************************************************************************************************************/
 void draw_screen_scanline ( Sint32 start_line, Sint32 end_line, SDL_bool refresh )
 {
-    Sint32 sx = 0, sy = 0, my = 0, zx = 1, zy = 1;
-    Sint32 offs = 0, y = 0;
+    Sint32 sx = 0, zx = 1;
     Sint32 tileno = 0, tileatr = 0;
-    Uint16 scb2 = 0, scb3 = 0, scb4 = 0;
-    Uint8* vidram = neogeo_memory.vid.ram;
     static SDL_Rect clear_rect;
     Sint32 yy = 0;
-    Sint32 tile = 0, yoffs = 0;
-    Sint32 zoom_line = 0;
-    Sint32 invert = 0;
-    Uint8* zoomy_rom = NULL;
+    Sint32 yoffs = 0;
     Uint8 penusage = 0;
 
     if ( start_line > 255 )
@@ -856,213 +2069,98 @@ void draw_screen_scanline ( Sint32 start_line, Sint32 end_line, SDL_bool refresh
         end_line = 255;
     }
 
-    clear_rect.x = visible_area.x;
-    clear_rect.w = visible_area.w;
-    clear_rect.y = start_line;
-    clear_rect.h = end_line - start_line + 1;
-
-    SDL_FillRect ( sdl_surface_buffer, &clear_rect, current_pc_pal[4095] );
-
-    /* Draw sprites */
-    for ( Sint32 count = 0; count < 0x300; count += 2 )
+    if ( draw_lines_available() == SDL_TRUE )
     {
-        scb2 = READ_WORD ( &vidram[0x10000 + count] );
-        scb3 = READ_WORD ( &vidram[0x10400 + count] );
-        scb4 = READ_WORD ( &vidram[0x10800 + count] );
+        /* Raster frames keep the CPU conversion, palette writes between lines would be lost otherwise */
+        neogeo_video_index_only = SDL_FALSE;
+        draw_lines ( SDL_max ( start_line, 0 ), end_line + 1 );
 
-        /* If this bit is set this new column is placed next to last one */
-        if ( scb3 & 0x40 )
+        if ( refresh == SDL_TRUE )
         {
-            /* new x */
-            sx += zx + 1;
-            /* Get new zoom for this column */
-            zx = ( scb2 >> 8 ) & 0x0f;
-        }
-        /* nope it is a new block */
-        else
-        {
-            /* Sprite scaling */
-            zx = ( scb2 >> 8 ) & 0x0f; /* zomm x */
-            zy = scb2 & 0xff; /* zoom y */
-
-            /* x pos 0 - 512  */
-            sx = ( scb4 >> 7 );
-
-            /* Number of tiles in this strip */
-            my = scb3 & 0x3f;
-
-            /* y pos 512 - 0 */
-            sy = 512 - ( scb3 >> 7 );
-
-            if ( my > 0x20 )
+            if ( neogeo_memory.vid.spr_cache.data != NULL )
             {
-                my = 0x20;
+                prefetch_sprite_banks();
             }
-        }
-
-        /* No point doing anything if tile strip is 0 */
-        if ( my == 0 )
-        {
-            continue;
-        }
 
-        if ( sx >= 496 ) /* after 496, we consider sx negative */
-        {
-            sx -= 512;
-            //continue;
+            neo_screen_efects_apply();
         }
 
-        if ( sx > 320 )
-        {
-            continue;
-            //sx-=16;
-        }
+        return;
+    }
 
-        if ( sx < -16 )
-        {
-            continue;
-        }
+    neogeo_video_index_only = SDL_FALSE;
 
-        //sx&=0x1ff;
+    clear_rect.x = visible_area.x;
+    clear_rect.w = visible_area.w;
+    clear_rect.y = start_line;
+    clear_rect.h = end_line - start_line + 1;
 
-        /* Process x zoom */
-        if ( zx != 16 )
-        {
-            dda_x_skip = ddaxskip[zx];
-        }
-        else
-        {
-            zx = 16;
-        }
+    SDL_FillRect ( sdl_surface_buffer, &clear_rect, current_pc_pal[4095] );
 
-        offs = count << 6;
-        zoomy_rom = neogeo_memory.ng_lo + ( zy << 8 );
+    update_sprite_table();
 
-        for ( yy = start_line; yy <= end_line; yy++ )
+    /* Draw sprites, line by line, only strips crossing the line in SCB order */
+    for ( yy = SDL_max ( start_line, 0 ); yy <= end_line; yy++ )
+    {
+        for ( Sint32 word = 0; word < SPRITE_LINE_WORDS; word++ )
         {
-            y = yy - sy; /* y: 0 -> my*16 */
-
-            if ( y < 0 )
-            {
-                y += 512;
-            }
-
-            if ( y >= ( my << 4 ) )
-            {
-                continue;
-            }
-
-            invert = 0;
-
-            zoom_line = y & 0xff;
-
-            if ( y & 0x100 )
-            {
-                zoom_line ^= 0xff; /* zoom_line = 255 - zoom_line */
-                invert = 1;
-            }
-
-            if ( my == 0x20 ) /* fix for joyjoy, trally... */
-            {
-                if ( zy )
-                {
-                    zoom_line %= ( zy << 1 );
-
-                    if ( zoom_line >= zy )
-                    {
-                        zoom_line = ( zy << 1 ) - 1 - zoom_line;
-                        invert ^= 1;
-                    }
-                }
-            }
-
-            yoffs = zoomy_rom[zoom_line] & 0x0f;
-            tile = zoomy_rom[zoom_line] >> 4;
-
-            if ( invert )
-            {
-                tile ^= 0x1f; // tile=31 - tile;
-                yoffs ^= 0x0f; // yoffs= 15 - yoffs;
-            }
+            Uint32 bits = sprite_line_bins[yy][word];
 
-            tileno = READ_WORD ( &vidram[offs + ( tile << 2 )] );
-            tileatr = READ_WORD ( &vidram[offs + ( tile << 2 ) + 2] );
-
-            if ( neogeo_memory.nb_of_tiles > 0x10000 && ( tileatr & 0x10 ) )
-            {
-                tileno += 0x10000;
-            }
-
-            if ( neogeo_memory.nb_of_tiles > 0x20000 && ( tileatr & 0x20 ) )
+            while ( bits )
             {
-                tileno += 0x20000;
-            }
+                Sint32 index = ( word << 5 ) + __builtin_ctz ( bits );
+                const struct_gngeoxvideo_sprite* sprite = &sprite_table[index];
 
-            if ( neogeo_memory.nb_of_tiles > 0x40000 && ( tileatr & 0x40 ) )
-            {
-                tileno += 0x40000;
-            }
+                bits &= bits - 1;
 
-            /* animation automatique */
-            if ( tileatr & 0x8 )
-            {
-                tileno = ( tileno & ~7 ) + ( ( tileno + neogeo_frame_counter ) & 7 );
-            }
-            else
-            {
-                if ( tileatr & 0x4 )
+                if ( !sprite->visible )
                 {
-                    tileno = ( tileno & ~3 ) + ( ( tileno + neogeo_frame_counter ) & 3 );
+                    continue;
                 }
-            }
-
-            if ( tileatr & 0x02 )
-            {
-                yoffs ^= 0x0f;    /* flip y */
-            }
 
-            penusage = neo_transpack_find ( tileno );
-            if ( penusage == TILE_TRANS_UNKNOWN )
-            {
-                penusage = PEN_USAGE ( tileno );
-            }
+                sx = sprite->sx;
+                zx = sprite->zx;
+                dda_x_skip = ddaxskip[zx];
+                tileno = sprite_line_tile ( sprite, index, yy, &yoffs, &tileatr );
 
-            if ( neogeo_memory.vid.spr_cache.data )
-            {
-                neogeo_memory.rom.rom_region[REGION_SPRITES].p = get_cached_sprite_ptr ( tileno );
-                tileno = ( tileno & ( ( neogeo_memory.vid.spr_cache.slot_size >> 7 ) - 1 ) );
-            }
+                penusage = TILE_USAGE ( tileno );
 
-            switch ( penusage )
-            {
-            case ( TILE_NORMAL ) :
+                switch ( penusage )
                 {
-                    draw_scanline_tile ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
-                                         tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
-                }
-                break;
+                case ( TILE_NORMAL ) :
+                    {
+                        draw_scanline_tile ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
+                                             tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
+                    }
+                    break;
 
-            case ( TILE_TRANSPARENT50 ) :
-                {
-                    draw_scanline_tile_50 ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
-                                            tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
-                }
-                break;
+                case ( TILE_TRANSPARENT50 ) :
+                    {
+                        draw_scanline_tile_50 ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
+                                                tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
+                    }
+                    break;
 
-            case ( TILE_TRANSPARENT25 ) :
-                {
-                    draw_scanline_tile_25 ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
-                                            tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
+                case ( TILE_TRANSPARENT25 ) :
+                    {
+                        draw_scanline_tile_25 ( tileno, yoffs, sx + 16, yy, zx, tileatr >> 8,
+                                                tileatr & 0x01, ( Uint8* ) sdl_surface_buffer->pixels );
+                    }
+                    break;
                 }
-                break;
             }
         }
-    } /* for count */
+    }
 
     if ( refresh == SDL_TRUE )
     {
         draw_fix_char ( sdl_surface_buffer->pixels, 0, 0 );
 
+        if ( neogeo_memory.vid.spr_cache.data != NULL )
+        {
+            prefetch_sprite_banks();
+        }
+
         neo_screen_efects_apply();
     }
 }
@@ -1074,8 +2172,13 @@ void draw_screen_scanline ( Sint32 start_line, Sint32 end_line, SDL_bool refresh
 /* ******************************************************************************************************************/
 void init_video ( void )
 {
+    neo_pal_table_init ( PAL_FORMAT_RGB24, gngeox_config.gamma );
     fix_value_init();
+    yzoom_value_init();
+    neo_video_simd_init ( ( const char ( * ) [16] ) ddaxskip );
     neogeo_memory.vid.modulo = 1;
+    sprite_table_dirty = 0;
+    invalidate_fix_layer();
 }
 
 #ifdef _GNGEOX_VIDEO_C_
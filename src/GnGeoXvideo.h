@@ -19,17 +19,57 @@
 #define PIXEL_PITCH (sdl_surface_buffer->pitch >> 2)
 #define RASTER_LINES 261
 #define PEN_USAGE(tileno) ((((Uint32*) neogeo_memory.rom.spr_usage.p)[tileno>>4]>>((tileno&0xF)*2))&0x3)
+/* Tile rows masks, empty rows in the low half and opaque rows in the high half, none known without the table */
+#define TILE_ROWS(tileno) ( neogeo_memory.rom.spr_rows.p ? ((Uint32*) neogeo_memory.rom.spr_rows.p)[(tileno) % neogeo_memory.nb_of_tiles] : 0 )
 
 #define COLOR_RGB24_B(_X_) (_X_ & 0xFF)
 #define COLOR_RGB24_G(_X_) ((_X_>>8) & 0xFF)
 #define COLOR_RGB24_R(_X_) ((_X_>>16) & 0xFF)
 #define COLOR_RGB24_MAKE(_A_,_R_,_G_,_B_) ((Uint32)( _A_ << 24 ) | (Uint32)( _R_ << 16 ) | (Uint32)( _G_ << 8 ) | (Uint32)(_B_) )
 
+/* x / 255 without division, exact for x up to 255 * 255 */
+#define DIV255(_X_) ((( _X_ ) + 1 + (( _X_ ) >> 8 )) >> 8)
+
 #define BLEND16_50(a,b) alpha_blend(a,b,127)
 #define BLEND16_25(a,b) alpha_blend(a,b,63)
 
+/* Sprite control blocks (SCB2/3/4) entries used by the scanline renderer */
+#define SPRITE_TABLE_SIZE 384
+#define SPRITE_LINE_WORDS ( SPRITE_TABLE_SIZE / 32 )
+#define SPRITE_LINES 256
+/* Y zoom DDA accumulator at a tile start is a multiple of 16 in 0 - 256 */
+#define YZOOM_PHASES 17
+/* Fix layer : 40 x 32 cells of 8 x 8 pixels, columns 1 - 38 and rows 1 - 31 are drawn */
+#define FIX_COLUMNS 40
+#define FIX_ROWS 32
+#define FIX_DRAWN_COLUMNS 0x7FFFFFFFFEULL
+#define FIX_OPAQUE 0xFF000000
+/* Palette indexes buffer width, same as the colors buffer */
+#define INDEX_BUFFER_WIDTH 352
+/* Tiles queued for band rendering, at most 32 per strip */
+#define DRAW_LIST_SIZE ( SPRITE_TABLE_SIZE * 32 )
+/* Strips the LSPC can draw on a line, the following ones are dropped */
+#define SPRITES_PER_LINE 96
+/* Sprite cache banks the prefetch thread can hold ready */
+#define SPRITE_PREFETCH_BANKS 128
+
 #define fix_add(x, y) ((((READ_WORD(neogeo_memory.vid.ram + 0xEA00 + (((y-1)&31)*2 + 64 * (x/6))) >> (5-(x%6))*2) & 3) ^ 3))
 
+typedef enum
+{
+    PREFETCH_FREE = 0,
+    PREFETCH_QUEUED,
+    PREFETCH_READY,
+} enum_gngeoxvideo_prefetch_state;
+
+typedef struct
+{
+    Sint32 bank;  /* Bank to decompress */
+    SDL_atomic_t state;  /* enum_gngeoxvideo_prefetch_state */
+    Uint32 stamp;  /* Last prefetch pass that asked for the bank */
+    Uint8* data;  /* Decompressed bank */
+} struct_gngeoxvideo_gfx_prefetch;
+
 typedef struct
 {
     Uint8* data;  /* The cache */
@@ -39,11 +79,60 @@ typedef struct
     Sint32 max_slot; /* Maximal number of bank that can be cached (depend on cache size) */
     Sint32 slot_size;
     Sint32* usage;   /* contain index to the banks in used order */
+    Uint8* referenced;  /* CLOCK reference bit of each slot */
+    Sint32 hand;  /* CLOCK hand, next slot to look at */
     FILE* gno;
     Uint32* offset;
     Uint8* in_buf;
+    Uint8* map;  /* The gno file, mapped */
+    size_t map_size;
+    /* Prefetch thread, decompresses banks of the visible strips ahead of the next frame */
+    SDL_Thread* thread;
+    SDL_sem* wake;
+    SDL_atomic_t quit;  /* Set by the main thread, the prefetch thread stops */
+    Uint8* prefetch_in_buf;
+    Sint16* staged;  /* Prefetch entry of each bank, -1 when none */
+    Uint32 stamp;
+    struct_gngeoxvideo_gfx_prefetch prefetch[SPRITE_PREFETCH_BANKS];
+    /* Bank in the cache, bank not in the cache, bank decompressed while drawing */
+    Uint32 hits;
+    Uint32 misses;
+    Uint32 stalls;
 } struct_gngeoxvideo_gfx_cache;
 
+typedef struct
+{
+    Sint16 sx;  /* x position, already wrapped after 496 */
+    Sint16 sy;  /* y position 512 - 0 */
+    Uint8 zx;   /* x zoom */
+    Uint8 zy;   /* y zoom */
+    Uint8 my;   /* number of tiles in the strip */
+    Uint8 visible;
+} struct_gngeoxvideo_sprite;
+
+typedef struct
+{
+    char skip[17]; /* Source rows to skip before each drawn row */
+    Uint8 rows;    /* Drawn rows */
+    Uint8 next;    /* DDA phase of the following tile */
+} struct_gngeoxvideo_yzoom;
+
+typedef struct
+{
+    const Uint32* gfxdata;  /* Tile first row */
+    const Uint32* paldata;  /* Tile palette */
+    Uint16 pen_base;  /* Tile palette first index */
+    const char* y_skip;  /* Y zoom line skipping */
+    Uint32 masks;  /* Tile rows masks */
+    Sint16 sx;  /* Buffer x position */
+    Sint16 sy;  /* Buffer y position */
+    Uint8 rows;  /* Drawn rows */
+    Uint8 zoom;  /* X zoom pattern */
+    Uint8 xflip;
+    Uint8 yflip;
+    Uint8 mode;  /* enum_gngeoxvideosimd_mode */
+} struct_gngeoxvideo_tile_cmd;
+
 typedef struct
 {
     /* Video Ram&Pal */
@@ -71,14 +160,39 @@ typedef struct
 } struct_gngeoxvideo_video;
 
 #ifdef _GNGEOX_VIDEO_C_
-//static Uint32 alpha_blend ( Uint32, Uint32, Uint8 ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool read_sprite_bank ( Sint32, Uint8*, Uint8* ) __attribute__ ( ( warn_unused_result ) );
+static int prefetch_sprite_thread ( void* );
+static void prefetch_sprite_banks ( void );
+static Sint32 get_sprite_cache_slot ( void ) __attribute__ ( ( warn_unused_result ) );
 static Uint8* get_cached_sprite_ptr ( Uint32 ) __attribute__ ( ( warn_unused_result ) );
+static Uint32 sprite_tile_index ( Uint32 ) __attribute__ ( ( warn_unused_result ) );
+static const Uint8* sprite_tile_data ( Uint32 ) __attribute__ ( ( warn_unused_result ) );
 static void fix_value_init ( void );
+static void yzoom_value_init ( void );
+static void update_fix_plane ( Sint32, Sint32 );
 static void draw_fix_char ( Uint8*, Sint32, Sint32 );
+static void draw_fix_index_lines ( Sint32, Sint32 );
+static void update_sprite_table ( void );
+static SDL_bool draw_bands_available ( void ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool draw_indexed_available ( void ) __attribute__ ( ( warn_unused_result ) );
+static void draw_band_indexed ( Sint32, Sint32 );
+static void draw_list_add ( Uint32, Sint32, Sint32, Sint32, Sint32, Sint32, Sint32, Sint32, Uint8 );
+static void draw_band ( void*, Sint32 );
+static SDL_bool draw_index_only_available ( void ) __attribute__ ( ( warn_unused_result ) );
+static Sint32 sprite_line_tile ( const struct_gngeoxvideo_sprite*, Sint32, Sint32, Sint32*, Sint32* ) __attribute__ ( ( warn_unused_result ) );
+static SDL_bool draw_lines_available ( void ) __attribute__ ( ( warn_unused_result ) );
+static void draw_line ( Sint32 );
+static void draw_lines_band ( void*, Sint32 );
+static void draw_lines ( Sint32, Sint32 );
 #else
 extern Uint32 neogeo_frame_counter;
 extern Uint32 neogeo_frame_counter_speed;
 extern Uint32 frame_counter;
+extern Uint32 neogeo_video_generation;
+extern Uint32 neogeo_palette_generation;
+extern SDL_bool neogeo_video_palette_blitter;
+extern SDL_bool neogeo_video_index_only;
+extern Uint16 neogeo_video_index[];
 #endif // _GNGEOX_VIDEO_C_
 
 void init_video ( void );
@@ -86,7 +200,28 @@ SDL_bool init_sprite_cache ( Uint32, Uint32 ) __attribute__ ( ( warn_unused_resu
 void free_sprite_cache ( void );
 void draw_screen ( void );
 void draw_screen_scanline ( Sint32, Sint32, SDL_bool );
+void invalidate_sprite_table ( Uint32 );
+void invalidate_fix_cell ( Uint32 );
+void invalidate_fix_layer ( void );
 void SDL_textout ( Sint32, Sint32, const char* );
-Uint32 alpha_blend ( Uint32 dest, Uint32 src, Uint8 alpha );
+/* ******************************************************************************************************************/
+/*!
+* \brief  Applies alpha transparency.
+*
+* \param  dest Destination pixel in RGB24.
+* \param  src Source pixel in RGB24.
+* \param  alpha Alpha transparency value to apply.
+* \return Alpha blended pixel.
+*/
+/* ******************************************************************************************************************/
+static inline Uint32 alpha_blend ( Uint32 dest, Uint32 src, Uint8 alpha )
+{
+    Uint32 beta = ( 255 - alpha );
+    Uint32 or = ( COLOR_RGB24_R ( src ) * alpha ) + ( COLOR_RGB24_R ( dest ) * beta );
+    Uint32 og = ( COLOR_RGB24_G ( src ) * alpha ) + ( COLOR_RGB24_G ( dest ) * beta );
+    Uint32 ob = ( COLOR_RGB24_B ( src ) * alpha ) + ( COLOR_RGB24_B ( dest ) * beta );
+
+    return ( COLOR_RGB24_MAKE ( alpha, DIV255 ( or ), DIV255 ( og ), DIV255 ( ob ) ) );
+}
 
 #endif
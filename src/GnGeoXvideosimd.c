@@ -0,0 +1,998 @@
+/*!
+*
+*   \file    GnGeoXvideosimd.c
+*   \brief   Vectorized sprite tile rows.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    A sprite row is 8 bytes holding 16 pens of 4 bits. Each kernel unpacks the 16 pens at once,
+*            compacts them following the x zoom pattern, looks them up in the 16 colors palette and
+*            only stores the pixels whose pen is not zero. Output is bit identical to the scalar template.
+*            Rows the tile masks give as empty are skipped, opaque ones are stored without any pen test.
+*/
+#ifndef _GNGEOX_VIDEOSIMD_C_
+#define _GNGEOX_VIDEOSIMD_C_
+#endif // _GNGEOX_VIDEOSIMD_C_
+
+#include <SDL2/SDL.h>
+#include "zlog.h"
+#include "qlibc.h"
+
+#include "GnGeoXvideosimd.h"
+#include "GnGeoXvideo.h"
+#include "GnGeoXconfig.h"
+
+#if defined ( __x86_64__ ) || defined ( __i386__ )
+#include <immintrin.h>
+#define VIDEO_SIMD_X86 1
+#define TARGET_SSE41 __attribute__ ( ( target ( "sse4.1" ) ) )
+#define TARGET_AVX2 __attribute__ ( ( target ( "avx2" ) ) )
+#elif defined ( __aarch64__ ) && defined ( __ARM_NEON )
+#include <arm_neon.h>
+#define VIDEO_SIMD_NEON 1
+#endif
+
+/* Kernel in use for each drawing mode, NULL when the scalar template must be used */
+tile_rows_kernel neo_video_simd_rows[TILE_ROWS_MAX] = { NULL, NULL, NULL };
+/* Y skip table of a single row, used by the scanline renderer */
+const char neo_video_simd_no_skip[1] = { 0 };
+/* Palette indexes kernel, never NULL once initialized */
+index_rows_kernel neo_video_simd_index_rows = NULL;
+
+/* For each x zoom pattern, source pen of each output pixel, 0x80 past the zoomed width */
+static Uint8 tile_compact[16][16];
+/* Whole row blending kernel, NULL when alpha_blend() must be used */
+static blend_row_kernel blend_row = NULL;
+static mask_row_kernel mask_row = NULL;
+static index_row_kernel index_row = NULL;
+
+#ifdef VIDEO_SIMD_X86
+/* ******************************************************************************************************************/
+/*!
+* \brief  Unpacks one sprite row in drawing order.
+*
+* \param  gfxdata Sprite row.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \return One pen per byte, zero past the zoomed width.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static inline __m128i tile_row_pens_sse41 ( const Uint32* gfxdata, Sint32 xflip, Sint32 zoom )
+{
+    __m128i bytes = _mm_loadl_epi64 ( ( const __m128i* ) gfxdata );
+    __m128i nibble = _mm_set1_epi8 ( 0x0f );
+    __m128i pens;
+
+    if ( xflip )
+    {
+        /* Pixels 0 - 7 are gfxdata[1] pens 0 - 7, then gfxdata[0] pens 0 - 7 */
+        bytes = _mm_shuffle_epi8 ( bytes, _mm_setr_epi8 ( 4, 5, 6, 7, 0, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1 ) );
+        pens = _mm_unpacklo_epi8 ( _mm_and_si128 ( bytes, nibble ), _mm_and_si128 ( _mm_srli_epi16 ( bytes, 4 ), nibble ) );
+    }
+    else
+    {
+        /* Pixels 0 - 7 are gfxdata[0] pens 7 - 0, then gfxdata[1] pens 7 - 0 */
+        bytes = _mm_shuffle_epi8 ( bytes, _mm_setr_epi8 ( 3, 2, 1, 0, 7, 6, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1 ) );
+        pens = _mm_unpacklo_epi8 ( _mm_and_si128 ( _mm_srli_epi16 ( bytes, 4 ), nibble ), _mm_and_si128 ( bytes, nibble ) );
+    }
+
+    return ( _mm_shuffle_epi8 ( pens, _mm_loadu_si128 ( ( const __m128i* ) tile_compact[zoom] ) ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends four sprite pixels over four screen pixels, like alpha_blend().
+*
+* \param  screen Screen pixels.
+* \param  sprite Sprite pixels.
+* \param  alpha Screen pixels weight.
+* \return Blended pixels.
+* \note   x / 255 is computed as ( x + 1 + ( x >> 8 ) ) >> 8, exact for every x up to 255 * 255.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static inline __m128i tile_blend_sse41 ( __m128i screen, __m128i sprite, Sint32 alpha )
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i weight_screen = _mm_set1_epi16 ( alpha );
+    __m128i weight_sprite = _mm_set1_epi16 ( 255 - alpha );
+    __m128i one = _mm_set1_epi16 ( 1 );
+    __m128i low, high;
+
+    low = _mm_add_epi16 ( _mm_mullo_epi16 ( _mm_unpacklo_epi8 ( screen, zero ), weight_screen ),
+                          _mm_mullo_epi16 ( _mm_unpacklo_epi8 ( sprite, zero ), weight_sprite ) );
+    high = _mm_add_epi16 ( _mm_mullo_epi16 ( _mm_unpackhi_epi8 ( screen, zero ), weight_screen ),
+                           _mm_mullo_epi16 ( _mm_unpackhi_epi8 ( sprite, zero ), weight_sprite ) );
+
+    low = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( low, one ), _mm_srli_epi16 ( low, 8 ) ), 8 );
+    high = _mm_srli_epi16 ( _mm_add_epi16 ( _mm_add_epi16 ( high, one ), _mm_srli_epi16 ( high, 8 ) ), 8 );
+
+    return ( _mm_or_si128 ( _mm_and_si128 ( _mm_packus_epi16 ( low, high ), _mm_set1_epi32 ( 0x00ffffff ) ),
+                            _mm_set1_epi32 ( alpha << 24 ) ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Stores four pixels where pens are not zero.
+*
+* \param  br Destination.
+* \param  pixels Sprite pixels.
+* \param  transparent Zero pens mask, one byte per pixel in the low 4 bytes.
+* \param  alpha Screen pixels weight, zero when opaque.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static inline void tile_store_sse41 ( Uint32* br, __m128i pixels, __m128i transparent, Sint32 alpha )
+{
+    __m128i screen = _mm_loadu_si128 ( ( const __m128i* ) br );
+
+    if ( alpha )
+    {
+        pixels = tile_blend_sse41 ( screen, pixels, alpha );
+    }
+
+    _mm_storeu_si128 ( ( __m128i* ) br, _mm_blendv_epi8 ( pixels, screen, _mm_cvtepi8_epi32 ( transparent ) ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws sprite rows, SSE4.1 version.
+*
+* \param  br Destination of the first row.
+* \param  step Destination step between rows.
+* \param  gfxdata Sprite data.
+* \param  y_skip Rows to skip before drawing each row.
+* \param  rows Number of rows.
+* \param  paldata Palette.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \param  masks Tile rows masks.
+* \param  alpha Screen pixels weight, zero when opaque.
+* \note   The palette is split in four byte planes once, so the palette lookup is four byte shuffles.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static inline __attribute__ ( ( always_inline ) ) void tile_rows_sse41 ( Uint32* br, Sint32 step, const Uint32* gfxdata,
+        const char* y_skip, Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks, Sint32 alpha )
+{
+    __m128i planes_order = _mm_setr_epi8 ( 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 );
+    __m128i q0 = _mm_shuffle_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) &paldata[0] ), planes_order );
+    __m128i q1 = _mm_shuffle_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) &paldata[4] ), planes_order );
+    __m128i q2 = _mm_shuffle_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) &paldata[8] ), planes_order );
+    __m128i q3 = _mm_shuffle_epi8 ( _mm_loadu_si128 ( ( const __m128i* ) &paldata[12] ), planes_order );
+    __m128i t0 = _mm_unpacklo_epi32 ( q0, q1 ), t1 = _mm_unpacklo_epi32 ( q2, q3 );
+    __m128i t2 = _mm_unpackhi_epi32 ( q0, q1 ), t3 = _mm_unpackhi_epi32 ( q2, q3 );
+    __m128i plane0 = _mm_unpacklo_epi64 ( t0, t1 ), plane1 = _mm_unpackhi_epi64 ( t0, t1 );
+    __m128i plane2 = _mm_unpacklo_epi64 ( t2, t3 ), plane3 = _mm_unpackhi_epi64 ( t2, t3 );
+
+    Sint32 row = 0;
+
+    for ( Sint32 y = 0; y < rows; y++, br += step )
+    {
+        __m128i pens, transparent, b0, b1, b2, b3, low01, high01, low23, high23;
+        Sint32 opaque = 0;
+
+        gfxdata += y_skip[y] << 1;
+        row += y_skip[y];
+
+        if ( ( ( masks >> row ) & TILE_ROW_EMPTY ) || ( ( gfxdata[0] | gfxdata[1] ) == 0 ) )
+        {
+            continue;
+        }
+
+        pens = tile_row_pens_sse41 ( gfxdata, xflip, zoom );
+        b0 = _mm_shuffle_epi8 ( plane0, pens );
+        b1 = _mm_shuffle_epi8 ( plane1, pens );
+        b2 = _mm_shuffle_epi8 ( plane2, pens );
+        b3 = _mm_shuffle_epi8 ( plane3, pens );
+        low01 = _mm_unpacklo_epi8 ( b0, b1 );
+        high01 = _mm_unpackhi_epi8 ( b0, b1 );
+        low23 = _mm_unpacklo_epi8 ( b2, b3 );
+        high23 = _mm_unpackhi_epi8 ( b2, b3 );
+
+        /* Opaque row drawn full width, no pen to test */
+        if ( ( zoom == 15 ) && ( ( masks >> row ) & TILE_ROW_OPAQUE ) )
+        {
+            __m128i pixels[4] = { _mm_unpacklo_epi16 ( low01, low23 ), _mm_unpackhi_epi16 ( low01, low23 ),
+                                  _mm_unpacklo_epi16 ( high01, high23 ), _mm_unpackhi_epi16 ( high01, high23 )
+                                };
+
+            for ( Sint32 quad = 0; quad < 4; quad++ )
+            {
+                if ( alpha )
+                {
+                    pixels[quad] = tile_blend_sse41 ( _mm_loadu_si128 ( ( const __m128i* ) ( br + ( quad << 2 ) ) ), pixels[quad], alpha );
+                }
+
+                _mm_storeu_si128 ( ( __m128i* ) ( br + ( quad << 2 ) ), pixels[quad] );
+            }
+
+            continue;
+        }
+
+        transparent = _mm_cmpeq_epi8 ( pens, _mm_setzero_si128() );
+        opaque = ~_mm_movemask_epi8 ( transparent ) & 0xffff;
+
+        if ( !opaque )
+        {
+            continue;
+        }
+
+        if ( opaque & 0x000f )
+        {
+            tile_store_sse41 ( br, _mm_unpacklo_epi16 ( low01, low23 ), transparent, alpha );
+        }
+
+        if ( opaque & 0x00f0 )
+        {
+            tile_store_sse41 ( br + 4, _mm_unpackhi_epi16 ( low01, low23 ), _mm_srli_si128 ( transparent, 4 ), alpha );
+        }
+
+        if ( opaque & 0x0f00 )
+        {
+            tile_store_sse41 ( br + 8, _mm_unpacklo_epi16 ( high01, high23 ), _mm_srli_si128 ( transparent, 8 ), alpha );
+        }
+
+        if ( opaque & 0xf000 )
+        {
+            tile_store_sse41 ( br + 12, _mm_unpackhi_epi16 ( high01, high23 ), _mm_srli_si128 ( transparent, 12 ), alpha );
+        }
+    }
+}
+
+TARGET_SSE41 static void tile_rows_sse41_opaque ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_sse41 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 0 );
+}
+
+TARGET_SSE41 static void tile_rows_sse41_blend50 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_sse41 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 127 );
+}
+
+TARGET_SSE41 static void tile_rows_sse41_blend25 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_sse41 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 63 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends a row of pixels over another one, SSE4.1 version.
+*
+* \param  dst Destination row, also blended.
+* \param  src Source row.
+* \param  width Number of pixels.
+* \param  alpha Source pixels weight.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static void blend_row_sse41 ( Uint32* dst, const Uint32* src, Uint32 width, Sint32 alpha )
+{
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 4 <= width; pixel += 4 )
+    {
+        _mm_storeu_si128 ( ( __m128i* ) &dst[pixel], tile_blend_sse41 ( _mm_loadu_si128 ( ( const __m128i* ) &src[pixel] ),
+                           _mm_loadu_si128 ( ( const __m128i* ) &dst[pixel] ), alpha ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        dst[pixel] = alpha_blend ( dst[pixel], src[pixel], alpha );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque pixels of a row, SSE4.1 version.
+*
+* \param  dst Destination row.
+* \param  src Source row, pixels with the top bit set are opaque.
+* \param  width Number of pixels.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static void mask_row_sse41 ( Uint32* dst, const Uint32* src, Uint32 width )
+{
+    const __m128i color = _mm_set1_epi32 ( 0x00FFFFFF );
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 4 <= width; pixel += 4 )
+    {
+        __m128i source = _mm_loadu_si128 ( ( const __m128i* ) &src[pixel] );
+        __m128i screen = _mm_loadu_si128 ( ( const __m128i* ) &dst[pixel] );
+
+        _mm_storeu_si128 ( ( __m128i* ) &dst[pixel], _mm_blendv_epi8 ( screen, _mm_and_si128 ( source, color ),
+                           _mm_srai_epi32 ( source, 31 ) ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        if ( src[pixel] & 0x80000000 )
+        {
+            dst[pixel] = src[pixel] & 0x00FFFFFF;
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws sprite rows as palette indexes, SSE4.1 version.
+*
+* \param  br Destination of the first row.
+* \param  step Destination step between rows.
+* \param  gfxdata Sprite data.
+* \param  y_skip Rows to skip before drawing each row.
+* \param  rows Number of rows.
+* \param  base Palette first index.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \param  masks Tile rows masks.
+*/
+/* ******************************************************************************************************************/
+TARGET_SSE41 static void index_rows_sse41 ( Uint16* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, Uint16 base, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    __m128i offset = _mm_set1_epi16 ( base );
+    Sint32 row = 0;
+
+    for ( Sint32 y = 0; y < rows; y++, br += step )
+    {
+        __m128i pens, transparent;
+
+        gfxdata += y_skip[y] << 1;
+        row += y_skip[y];
+
+        if ( ( ( masks >> row ) & TILE_ROW_EMPTY ) || ( ( gfxdata[0] | gfxdata[1] ) == 0 ) )
+        {
+            continue;
+        }
+
+        pens = tile_row_pens_sse41 ( gfxdata, xflip, zoom );
+
+        /* Opaque row drawn full width, no pen to test */
+        if ( ( zoom == 15 ) && ( ( masks >> row ) & TILE_ROW_OPAQUE ) )
+        {
+            _mm_storeu_si128 ( ( __m128i* ) br, _mm_add_epi16 ( _mm_cvtepu8_epi16 ( pens ), offset ) );
+            _mm_storeu_si128 ( ( __m128i* ) ( br + 8 ), _mm_add_epi16 ( _mm_cvtepu8_epi16 ( _mm_srli_si128 ( pens, 8 ) ), offset ) );
+            continue;
+        }
+
+        transparent = _mm_cmpeq_epi8 ( pens, _mm_setzero_si128() );
+
+        if ( _mm_movemask_epi8 ( transparent ) == 0xffff )
+        {
+            continue;
+        }
+
+        _mm_storeu_si128 ( ( __m128i* ) br, _mm_blendv_epi8 ( _mm_add_epi16 ( _mm_cvtepu8_epi16 ( pens ), offset ),
+                           _mm_loadu_si128 ( ( const __m128i* ) br ), _mm_cvtepi8_epi16 ( transparent ) ) );
+        _mm_storeu_si128 ( ( __m128i* ) ( br + 8 ), _mm_blendv_epi8 ( _mm_add_epi16 ( _mm_cvtepu8_epi16 ( _mm_srli_si128 ( pens, 8 ) ), offset ),
+                           _mm_loadu_si128 ( ( const __m128i* ) ( br + 8 ) ), _mm_cvtepi8_epi16 ( _mm_srli_si128 ( transparent, 8 ) ) ) );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends eight sprite pixels over eight screen pixels, like alpha_blend().
+*
+* \param  screen Screen pixels.
+* \param  sprite Sprite pixels.
+* \param  alpha Screen pixels weight.
+* \return Blended pixels.
+*/
+/* ******************************************************************************************************************/
+TARGET_AVX2 static inline __m256i tile_blend_avx2 ( __m256i screen, __m256i sprite, Sint32 alpha )
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m256i weight_screen = _mm256_set1_epi16 ( alpha );
+    __m256i weight_sprite = _mm256_set1_epi16 ( 255 - alpha );
+    __m256i one = _mm256_set1_epi16 ( 1 );
+    __m256i low, high;
+
+    low = _mm256_add_epi16 ( _mm256_mullo_epi16 ( _mm256_unpacklo_epi8 ( screen, zero ), weight_screen ),
+                             _mm256_mullo_epi16 ( _mm256_unpacklo_epi8 ( sprite, zero ), weight_sprite ) );
+    high = _mm256_add_epi16 ( _mm256_mullo_epi16 ( _mm256_unpackhi_epi8 ( screen, zero ), weight_screen ),
+                              _mm256_mullo_epi16 ( _mm256_unpackhi_epi8 ( sprite, zero ), weight_sprite ) );
+
+    low = _mm256_srli_epi16 ( _mm256_add_epi16 ( _mm256_add_epi16 ( low, one ), _mm256_srli_epi16 ( low, 8 ) ), 8 );
+    high = _mm256_srli_epi16 ( _mm256_add_epi16 ( _mm256_add_epi16 ( high, one ), _mm256_srli_epi16 ( high, 8 ) ), 8 );
+
+    return ( _mm256_or_si256 ( _mm256_and_si256 ( _mm256_packus_epi16 ( low, high ), _mm256_set1_epi32 ( 0x00ffffff ) ),
+                               _mm256_set1_epi32 ( alpha << 24 ) ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws sprite rows, AVX2 version.
+*
+* \param  br Destination of the first row.
+* \param  step Destination step between rows.
+* \param  gfxdata Sprite data.
+* \param  y_skip Rows to skip before drawing each row.
+* \param  rows Number of rows.
+* \param  paldata Palette.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \param  masks Tile rows masks.
+* \param  alpha Screen pixels weight, zero when opaque.
+* \note   Eight pixels at once, gathered from the palette and written with a masked store.
+*/
+/* ******************************************************************************************************************/
+TARGET_AVX2 static inline __attribute__ ( ( always_inline ) ) void tile_rows_avx2 ( Uint32* br, Sint32 step, const Uint32* gfxdata,
+        const char* y_skip, Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks, Sint32 alpha )
+{
+    Sint32 row = 0;
+
+    for ( Sint32 y = 0; y < rows; y++, br += step )
+    {
+        __m128i pens;
+
+        gfxdata += y_skip[y] << 1;
+        row += y_skip[y];
+
+        if ( ( ( masks >> row ) & TILE_ROW_EMPTY ) || ( ( gfxdata[0] | gfxdata[1] ) == 0 ) )
+        {
+            continue;
+        }
+
+        pens = tile_row_pens_sse41 ( gfxdata, xflip, zoom );
+
+        /* Opaque row drawn full width, no pen to test */
+        if ( ( zoom == 15 ) && ( ( masks >> row ) & TILE_ROW_OPAQUE ) )
+        {
+            for ( Sint32 half = 0; half < 2; half++ )
+            {
+                __m256i pixels = _mm256_i32gather_epi32 ( ( const int* ) paldata,
+                                 _mm256_cvtepu8_epi32 ( half ? _mm_srli_si128 ( pens, 8 ) : pens ), 4 );
+
+                if ( alpha )
+                {
+                    pixels = tile_blend_avx2 ( _mm256_loadu_si256 ( ( const __m256i* ) ( br + ( half << 3 ) ) ), pixels, alpha );
+                }
+
+                _mm256_storeu_si256 ( ( __m256i* ) ( br + ( half << 3 ) ), pixels );
+            }
+
+            continue;
+        }
+
+        for ( Sint32 half = 0; half < 2; half++ )
+        {
+            __m256i index = _mm256_cvtepu8_epi32 ( half ? _mm_srli_si128 ( pens, 8 ) : pens );
+            __m256i opaque = _mm256_xor_si256 ( _mm256_cmpeq_epi32 ( index, _mm256_setzero_si256() ), _mm256_set1_epi32 ( -1 ) );
+            __m256i pixels;
+
+            if ( _mm256_testz_si256 ( opaque, opaque ) )
+            {
+                continue;
+            }
+
+            pixels = _mm256_i32gather_epi32 ( ( const int* ) paldata, index, 4 );
+
+            if ( alpha )
+            {
+                pixels = tile_blend_avx2 ( _mm256_loadu_si256 ( ( const __m256i* ) ( br + ( half << 3 ) ) ), pixels, alpha );
+            }
+
+            _mm256_maskstore_epi32 ( ( int* ) ( br + ( half << 3 ) ), opaque, pixels );
+        }
+    }
+}
+
+TARGET_AVX2 static void tile_rows_avx2_opaque ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_avx2 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 0 );
+}
+
+TARGET_AVX2 static void tile_rows_avx2_blend50 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_avx2 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 127 );
+}
+
+TARGET_AVX2 static void tile_rows_avx2_blend25 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+        Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_avx2 ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 63 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends a row of pixels over another one, AVX2 version.
+*
+* \param  dst Destination row, also blended.
+* \param  src Source row.
+* \param  width Number of pixels.
+* \param  alpha Source pixels weight.
+*/
+/* ******************************************************************************************************************/
+TARGET_AVX2 static void blend_row_avx2 ( Uint32* dst, const Uint32* src, Uint32 width, Sint32 alpha )
+{
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 8 <= width; pixel += 8 )
+    {
+        _mm256_storeu_si256 ( ( __m256i* ) &dst[pixel], tile_blend_avx2 ( _mm256_loadu_si256 ( ( const __m256i* ) &src[pixel] ),
+                              _mm256_loadu_si256 ( ( const __m256i* ) &dst[pixel] ), alpha ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        dst[pixel] = alpha_blend ( dst[pixel], src[pixel], alpha );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque pixels of a row, AVX2 version.
+*
+* \param  dst Destination row.
+* \param  src Source row, pixels with the top bit set are opaque.
+* \param  width Number of pixels.
+*/
+/* ******************************************************************************************************************/
+TARGET_AVX2 static void mask_row_avx2 ( Uint32* dst, const Uint32* src, Uint32 width )
+{
+    const __m256i color = _mm256_set1_epi32 ( 0x00FFFFFF );
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 8 <= width; pixel += 8 )
+    {
+        __m256i source = _mm256_loadu_si256 ( ( const __m256i* ) &src[pixel] );
+        __m256i screen = _mm256_loadu_si256 ( ( const __m256i* ) &dst[pixel] );
+
+        _mm256_storeu_si256 ( ( __m256i* ) &dst[pixel], _mm256_blendv_epi8 ( screen, _mm256_and_si256 ( source, color ),
+                              _mm256_srai_epi32 ( source, 31 ) ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        if ( src[pixel] & 0x80000000 )
+        {
+            dst[pixel] = src[pixel] & 0x00FFFFFF;
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts a row of palette indexes to colors, AVX2 version.
+*
+* \param  dst Destination row.
+* \param  src Palette indexes.
+* \param  width Number of pixels.
+* \param  palette Palette colors.
+*/
+/* ******************************************************************************************************************/
+TARGET_AVX2 static void index_row_avx2 ( Uint32* dst, const Uint16* src, Uint32 width, const Uint32* palette )
+{
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 8 <= width; pixel += 8 )
+    {
+        __m256i index = _mm256_cvtepu16_epi32 ( _mm_loadu_si128 ( ( const __m128i* ) &src[pixel] ) );
+
+        _mm256_storeu_si256 ( ( __m256i* ) &dst[pixel], _mm256_i32gather_epi32 ( ( const int* ) palette, index, 4 ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        dst[pixel] = palette[src[pixel]];
+    }
+}
+#endif // VIDEO_SIMD_X86
+
+#ifdef VIDEO_SIMD_NEON
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends sprite pixels over screen pixels for one color plane, like alpha_blend().
+*
+* \param  screen Screen plane.
+* \param  sprite Sprite plane.
+* \param  alpha Screen pixels weight.
+* \return Blended plane.
+*/
+/* ******************************************************************************************************************/
+static inline uint8x16_t tile_blend_neon ( uint8x16_t screen, uint8x16_t sprite, Sint32 alpha )
+{
+    uint8x8_t weight_screen = vdup_n_u8 ( alpha );
+    uint8x8_t weight_sprite = vdup_n_u8 ( 255 - alpha );
+    uint16x8_t low = vmlal_u8 ( vmull_u8 ( vget_low_u8 ( screen ), weight_screen ), vget_low_u8 ( sprite ), weight_sprite );
+    uint16x8_t high = vmlal_u8 ( vmull_u8 ( vget_high_u8 ( screen ), weight_screen ), vget_high_u8 ( sprite ), weight_sprite );
+
+    low = vaddq_u16 ( vaddq_u16 ( low, vdupq_n_u16 ( 1 ) ), vshrq_n_u16 ( low, 8 ) );
+    high = vaddq_u16 ( vaddq_u16 ( high, vdupq_n_u16 ( 1 ) ), vshrq_n_u16 ( high, 8 ) );
+
+    return ( vcombine_u8 ( vshrn_n_u16 ( low, 8 ), vshrn_n_u16 ( high, 8 ) ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws sprite rows, NEON version.
+*
+* \param  br Destination of the first row.
+* \param  step Destination step between rows.
+* \param  gfxdata Sprite data.
+* \param  y_skip Rows to skip before drawing each row.
+* \param  rows Number of rows.
+* \param  paldata Palette.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \param  masks Tile rows masks.
+* \param  alpha Screen pixels weight, zero when opaque.
+* \note   Pixels are handled as four byte planes, the palette lookup is one table lookup per plane.
+*/
+/* ******************************************************************************************************************/
+static inline __attribute__ ( ( always_inline ) ) void tile_rows_neon ( Uint32* br, Sint32 step, const Uint32* gfxdata,
+        const char* y_skip, Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks, Sint32 alpha )
+{
+    static const Uint8 order_xflip[8] = { 4, 5, 6, 7, 0, 1, 2, 3 };
+    static const Uint8 order_normal[8] = { 3, 2, 1, 0, 7, 6, 5, 4 };
+    uint8x16x4_t planes = vld4q_u8 ( ( const uint8_t* ) paldata );
+    uint8x8_t order = vld1_u8 ( xflip ? order_xflip : order_normal );
+    uint8x16_t compact = vld1q_u8 ( tile_compact[zoom] );
+    Sint32 row = 0;
+
+    for ( Sint32 y = 0; y < rows; y++, br += step )
+    {
+        uint8x8_t bytes, low, high;
+        uint8x16_t pens, opaque;
+        uint8x16x4_t screen, sprite;
+        Sint32 full = 0;
+
+        gfxdata += y_skip[y] << 1;
+        row += y_skip[y];
+
+        if ( ( ( masks >> row ) & TILE_ROW_EMPTY ) || ( ( gfxdata[0] | gfxdata[1] ) == 0 ) )
+        {
+            continue;
+        }
+
+        /* Opaque row drawn full width, no pen to test */
+        full = ( zoom == 15 ) && ( ( masks >> row ) & TILE_ROW_OPAQUE );
+
+        bytes = vtbl1_u8 ( vld1_u8 ( ( const uint8_t* ) gfxdata ), order );
+        low = vand_u8 ( bytes, vdup_n_u8 ( 0x0f ) );
+        high = vshr_n_u8 ( bytes, 4 );
+
+        if ( xflip )
+        {
+            pens = vcombine_u8 ( vzip1_u8 ( low, high ), vzip2_u8 ( low, high ) );
+        }
+        else
+        {
+            pens = vcombine_u8 ( vzip1_u8 ( high, low ), vzip2_u8 ( high, low ) );
+        }
+
+        pens = vqtbl1q_u8 ( pens, compact );
+        opaque = vtstq_u8 ( pens, pens );
+
+        if ( !full && ( vmaxvq_u8 ( opaque ) == 0 ) )
+        {
+            continue;
+        }
+
+        for ( Sint32 plane = 0; plane < 4; plane++ )
+        {
+            sprite.val[plane] = vqtbl1q_u8 ( planes.val[plane], pens );
+        }
+
+        if ( full && !alpha )
+        {
+            vst4q_u8 ( ( uint8_t* ) br, sprite );
+            continue;
+        }
+
+        screen = vld4q_u8 ( ( const uint8_t* ) br );
+
+        if ( alpha )
+        {
+            sprite.val[0] = tile_blend_neon ( screen.val[0], sprite.val[0], alpha );
+            sprite.val[1] = tile_blend_neon ( screen.val[1], sprite.val[1], alpha );
+            sprite.val[2] = tile_blend_neon ( screen.val[2], sprite.val[2], alpha );
+            sprite.val[3] = vdupq_n_u8 ( alpha );
+        }
+
+        for ( Sint32 plane = 0; plane < 4; plane++ )
+        {
+            screen.val[plane] = vbslq_u8 ( opaque, sprite.val[plane], screen.val[plane] );
+        }
+
+        vst4q_u8 ( ( uint8_t* ) br, screen );
+    }
+}
+
+static void tile_rows_neon_opaque ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+                                    Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_neon ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 0 );
+}
+
+static void tile_rows_neon_blend50 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+                                     Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_neon ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 127 );
+}
+
+static void tile_rows_neon_blend25 ( Uint32* br, Sint32 step, const Uint32* gfxdata, const char* y_skip,
+                                     Sint32 rows, const Uint32* paldata, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    tile_rows_neon ( br, step, gfxdata, y_skip, rows, paldata, xflip, zoom, masks, 63 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends a row of pixels over another one, NEON version.
+*
+* \param  dst Destination row, also blended.
+* \param  src Source row.
+* \param  width Number of pixels.
+* \param  alpha Source pixels weight.
+*/
+/* ******************************************************************************************************************/
+static void blend_row_neon ( Uint32* dst, const Uint32* src, Uint32 width, Sint32 alpha )
+{
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 16 <= width; pixel += 16 )
+    {
+        uint8x16x4_t source = vld4q_u8 ( ( const uint8_t* ) &src[pixel] );
+        uint8x16x4_t blended = vld4q_u8 ( ( const uint8_t* ) &dst[pixel] );
+
+        blended.val[0] = tile_blend_neon ( source.val[0], blended.val[0], alpha );
+        blended.val[1] = tile_blend_neon ( source.val[1], blended.val[1], alpha );
+        blended.val[2] = tile_blend_neon ( source.val[2], blended.val[2], alpha );
+        blended.val[3] = vdupq_n_u8 ( alpha );
+
+        vst4q_u8 ( ( uint8_t* ) &dst[pixel], blended );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        dst[pixel] = alpha_blend ( dst[pixel], src[pixel], alpha );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque pixels of a row, NEON version.
+*
+* \param  dst Destination row.
+* \param  src Source row, pixels with the top bit set are opaque.
+* \param  width Number of pixels.
+*/
+/* ******************************************************************************************************************/
+static void mask_row_neon ( Uint32* dst, const Uint32* src, Uint32 width )
+{
+    const uint32x4_t color = vdupq_n_u32 ( 0x00FFFFFF );
+    Uint32 pixel = 0;
+
+    for ( ; pixel + 4 <= width; pixel += 4 )
+    {
+        uint32x4_t source = vld1q_u32 ( &src[pixel] );
+        uint32x4_t opaque = vreinterpretq_u32_s32 ( vshrq_n_s32 ( vreinterpretq_s32_u32 ( source ), 31 ) );
+
+        vst1q_u32 ( &dst[pixel], vbslq_u32 ( opaque, vandq_u32 ( source, color ), vld1q_u32 ( &dst[pixel] ) ) );
+    }
+
+    for ( ; pixel < width; pixel++ )
+    {
+        if ( src[pixel] & 0x80000000 )
+        {
+            dst[pixel] = src[pixel] & 0x00FFFFFF;
+        }
+    }
+}
+#endif // VIDEO_SIMD_NEON
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws sprite rows as palette indexes.
+*
+* \param  br Destination of the first row.
+* \param  step Destination step between rows.
+* \param  gfxdata Sprite data.
+* \param  y_skip Rows to skip before drawing each row.
+* \param  rows Number of rows.
+* \param  base Palette first index.
+* \param  xflip Horizontal flip.
+* \param  zoom X zoom pattern.
+* \param  masks Tile rows masks.
+*/
+/* ******************************************************************************************************************/
+static void index_rows_scalar ( Uint16* br, Sint32 step, const Uint32* gfxdata, const char* y_skip, Sint32 rows,
+                                Uint16 base, Sint32 xflip, Sint32 zoom, Uint32 masks )
+{
+    Sint32 row = 0;
+
+    for ( Sint32 y = 0; y < rows; y++, br += step )
+    {
+        Uint8 pens[16];
+
+        gfxdata += y_skip[y] << 1;
+        row += y_skip[y];
+
+        if ( ( ( masks >> row ) & TILE_ROW_EMPTY ) || ( ( gfxdata[0] | gfxdata[1] ) == 0 ) )
+        {
+            continue;
+        }
+
+        for ( Sint32 pixel = 0; pixel < 8; pixel++ )
+        {
+            if ( xflip )
+            {
+                pens[pixel] = ( gfxdata[1] >> ( pixel << 2 ) ) & 0xf;
+                pens[pixel + 8] = ( gfxdata[0] >> ( pixel << 2 ) ) & 0xf;
+            }
+            else
+            {
+                pens[pixel] = ( gfxdata[0] >> ( 28 - ( pixel << 2 ) ) ) & 0xf;
+                pens[pixel + 8] = ( gfxdata[1] >> ( 28 - ( pixel << 2 ) ) ) & 0xf;
+            }
+        }
+
+        /* Opaque row drawn full width, no pen to test */
+        if ( ( zoom == 15 ) && ( ( masks >> row ) & TILE_ROW_OPAQUE ) )
+        {
+            for ( Sint32 pixel = 0; pixel < 16; pixel++ )
+            {
+                br[pixel] = base + pens[pixel];
+            }
+
+            continue;
+        }
+
+        for ( Sint32 pixel = 0; ( pixel < 16 ) && ( tile_compact[zoom][pixel] < 16 ); pixel++ )
+        {
+            Uint8 pen = pens[tile_compact[zoom][pixel]];
+
+            if ( pen )
+            {
+                br[pixel] = base + pen;
+            }
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Selects sprite rows kernels.
+*
+* \param  ddaxskip X zoom patterns, one per zoom value, 1 when the source pixel is drawn.
+* \note   Pattern 15 draws the 16 pixels.
+*/
+/* ******************************************************************************************************************/
+void neo_video_simd_init ( const char ddaxskip[16][16] )
+{
+    for ( Sint32 zoom = 0; zoom < 16; zoom++ )
+    {
+        Sint32 width = 0;
+
+        memset ( tile_compact[zoom], 0x80, sizeof ( tile_compact[zoom] ) );
+
+        for ( Sint32 pixel = 0; pixel < 16; pixel++ )
+        {
+            if ( ddaxskip[zoom][pixel] )
+            {
+                tile_compact[zoom][width++] = pixel;
+            }
+        }
+    }
+
+    for ( Sint32 mode = 0; mode < TILE_ROWS_MAX; mode++ )
+    {
+        neo_video_simd_rows[mode] = NULL;
+    }
+
+    blend_row = NULL;
+    mask_row = NULL;
+    index_row = NULL;
+    neo_video_simd_index_rows = index_rows_scalar;
+
+#ifdef VIDEO_SIMD_X86
+    __builtin_cpu_init();
+
+    if ( __builtin_cpu_supports ( "avx2" ) )
+    {
+        neo_video_simd_rows[TILE_ROWS_OPAQUE] = tile_rows_avx2_opaque;
+        neo_video_simd_rows[TILE_ROWS_BLEND50] = tile_rows_avx2_blend50;
+        neo_video_simd_rows[TILE_ROWS_BLEND25] = tile_rows_avx2_blend25;
+        blend_row = blend_row_avx2;
+        mask_row = mask_row_avx2;
+        index_row = index_row_avx2;
+        neo_video_simd_index_rows = index_rows_sse41;
+        zlog_info ( gngeox_config.loggingCat, "Sprite rows : AVX2" );
+    }
+    else if ( __builtin_cpu_supports ( "sse4.1" ) )
+    {
+        neo_video_simd_rows[TILE_ROWS_OPAQUE] = tile_rows_sse41_opaque;
+        neo_video_simd_rows[TILE_ROWS_BLEND50] = tile_rows_sse41_blend50;
+        neo_video_simd_rows[TILE_ROWS_BLEND25] = tile_rows_sse41_blend25;
+        blend_row = blend_row_sse41;
+        mask_row = mask_row_sse41;
+        neo_video_simd_index_rows = index_rows_sse41;
+        zlog_info ( gngeox_config.loggingCat, "Sprite rows : SSE4.1" );
+    }
+#endif // VIDEO_SIMD_X86
+
+#ifdef VIDEO_SIMD_NEON
+    neo_video_simd_rows[TILE_ROWS_OPAQUE] = tile_rows_neon_opaque;
+    neo_video_simd_rows[TILE_ROWS_BLEND50] = tile_rows_neon_blend50;
+    neo_video_simd_rows[TILE_ROWS_BLEND25] = tile_rows_neon_blend25;
+    blend_row = blend_row_neon;
+    mask_row = mask_row_neon;
+    zlog_info ( gngeox_config.loggingCat, "Sprite rows : NEON" );
+#endif // VIDEO_SIMD_NEON
+
+    if ( neo_video_simd_rows[TILE_ROWS_OPAQUE] == NULL )
+    {
+        zlog_info ( gngeox_config.loggingCat, "Sprite rows : scalar" );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends a row of pixels over another one.
+*
+* \param  dst Destination row, also blended.
+* \param  src Source row.
+* \param  width Number of pixels.
+* \param  alpha Source pixels weight.
+* \note   Same result as alpha_blend() on each pixel.
+*/
+/* ******************************************************************************************************************/
+void neo_video_simd_blend_row ( Uint32* dst, const Uint32* src, Uint32 width, Sint32 alpha )
+{
+    if ( blend_row != NULL )
+    {
+        blend_row ( dst, src, width, alpha );
+        return;
+    }
+
+    for ( Uint32 pixel = 0; pixel < width; pixel++ )
+    {
+        dst[pixel] = alpha_blend ( dst[pixel], src[pixel], alpha );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque pixels of a row.
+*
+* \param  dst Destination row.
+* \param  src Source row, pixels with the top bit set are opaque.
+* \param  width Number of pixels.
+* \note   The top byte of copied pixels is cleared, like palette colors.
+*/
+/* ******************************************************************************************************************/
+void neo_video_simd_mask_row ( Uint32* dst, const Uint32* src, Uint32 width )
+{
+    if ( mask_row != NULL )
+    {
+        mask_row ( dst, src, width );
+        return;
+    }
+
+    for ( Uint32 pixel = 0; pixel < width; pixel++ )
+    {
+        if ( src[pixel] & 0x80000000 )
+        {
+            dst[pixel] = src[pixel] & 0x00FFFFFF;
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts a row of palette indexes to colors.
+*
+* \param  dst Destination row.
+* \param  src Palette indexes.
+* \param  width Number of pixels.
+* \param  palette Palette colors.
+*/
+/* ******************************************************************************************************************/
+void neo_video_simd_index_row ( Uint32* dst, const Uint16* src, Uint32 width, const Uint32* palette )
+{
+    if ( index_row != NULL )
+    {
+        index_row ( dst, src, width, palette );
+        return;
+    }
+
+    for ( Uint32 pixel = 0; pixel < width; pixel++ )
+    {
+        dst[pixel] = palette[src[pixel]];
+    }
+}
+
+#ifdef _GNGEOX_VIDEOSIMD_C_
+#undef _GNGEOX_VIDEOSIMD_C_
+#endif // _GNGEOX_VIDEOSIMD_C_
@@ -0,0 +1,63 @@
+/*!
+*
+*   \file    GnGeoXvideosimd.h
+*   \brief   Vectorized sprite tile rows header.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Draws 16 pixels sprite rows at once (colors or palette indexes), blends, masks and converts whole
+*            screen rows, the kernels are picked at runtime (AVX2, SSE4.1 or NEON). When none is available, the scalar code is used.
+*/
+#ifndef _GNGEOX_VIDEOSIMD_H_
+#define _GNGEOX_VIDEOSIMD_H_
+
+#include <SDL2/SDL.h>
+
+typedef enum
+{
+    TILE_ROWS_OPAQUE = 0,
+    TILE_ROWS_BLEND50,
+    TILE_ROWS_BLEND25,
+    TILE_ROWS_MAX,
+} enum_gngeoxvideosimd_mode;
+
+/* Tile rows masks (see TILE_ROWS()), row y is empty when bit y is set and opaque when bit y + 16 is set */
+#define TILE_ROW_EMPTY 0x00000001
+#define TILE_ROW_OPAQUE 0x00010000
+/* Masks of the rows that follow the first skipped ones */
+#define TILE_ROWS_FROM(masks, skipped) ( ( ( ( ( masks ) & 0xFFFF0000 ) >> ( skipped ) ) & 0xFFFF0000 ) | ( ( ( masks ) & 0xFFFF ) >> ( skipped ) ) )
+
+/* Destination, destination step per row, tile data, y skip table, rows, palette, x flip, x zoom pattern, rows masks */
+typedef void ( *tile_rows_kernel ) ( Uint32*, Sint32, const Uint32*, const char*, Sint32, const Uint32*, Sint32, Sint32, Uint32 );
+
+/* Destination and source rows, number of pixels, source weight */
+typedef void ( *blend_row_kernel ) ( Uint32*, const Uint32*, Uint32, Sint32 );
+
+/* Destination and source rows, number of pixels */
+typedef void ( *mask_row_kernel ) ( Uint32*, const Uint32*, Uint32 );
+
+/* Destination, destination step per row, tile data, y skip table, rows, palette first index, x flip, x zoom pattern,
+   rows masks */
+typedef void ( *index_rows_kernel ) ( Uint16*, Sint32, const Uint32*, const char*, Sint32, Uint16, Sint32, Sint32, Uint32 );
+
+/* Destination and source rows, number of pixels, palette */
+typedef void ( *index_row_kernel ) ( Uint32*, const Uint16*, Uint32, const Uint32* );
+
+#ifndef _GNGEOX_VIDEOSIMD_C_
+extern tile_rows_kernel neo_video_simd_rows[TILE_ROWS_MAX];
+extern const char neo_video_simd_no_skip[1];
+extern index_rows_kernel neo_video_simd_index_rows;
+#endif // _GNGEOX_VIDEOSIMD_C_
+
+void neo_video_simd_init ( const char[16][16] );
+void neo_video_simd_blend_row ( Uint32*, const Uint32*, Uint32, Sint32 );
+void neo_video_simd_mask_row ( Uint32*, const Uint32*, Uint32 );
+void neo_video_simd_index_row ( Uint32*, const Uint16*, Uint32, const Uint32* );
+
+#endif
@@ -1,6 +1,7 @@
 /* Tile drawing template
    use RENAME to set the name of the function
    use PUTPIXEL(dest,src) to set the putpixel function/macro
+   use ROWSMODE to set the matching vectorized kernel (enum_gngeoxvideosimd_mode)
 */
 
 
@@ -12,15 +13,13 @@ static void RENAME ( draw ) ( Uint32 tileno, Sint32 sx, Sint32 sy, Sint32 zx, Si
     Uint8 col;
     Uint32* br;
     Uint32* paldata = ( Uint32* ) &current_pc_pal[16 * color];
-    char* l_y_skip;
+    const char* l_y_skip;
     Sint32 l; // Line skipping counter
     Sint32 pixel_pitch = PIXEL_PITCH;
     Sint32 buf_w = pixel_pitch - zx;
     Sint32 buf_w_yflip = pixel_pitch + zx;
 
-    tileno = tileno % neogeo_memory.nb_of_tiles;
-
-    gfxdata = ( Uint32* ) &neogeo_memory.rom.rom_region[REGION_SPRITES].p[ tileno << 7];
+    gfxdata = ( Uint32* ) sprite_tile_data ( tileno );
 
     /* y zoom table */
     if ( zy == 16 )
@@ -33,6 +32,25 @@ static void RENAME ( draw ) ( Uint32 tileno, Sint32 sx, Sint32 sy, Sint32 zx, Si
         l_y_skip = dda_y_skip;
     }
 
+    /* Vectorized kernel, zoom pattern zx - 1 is the one set in dda_x_skip */
+    if ( neo_video_simd_rows[ROWSMODE] != NULL )
+    {
+        if ( yflip )
+        {
+            br = ( Uint32* ) bmp + ( ( zy - 1 ) + sy ) * pixel_pitch + sx;
+            neo_video_simd_rows[ROWSMODE] ( br, -pixel_pitch, gfxdata, l_y_skip, zy, paldata, xflip, zx - 1,
+                                            TILE_ROWS ( tileno ) );
+        }
+        else
+        {
+            br = ( Uint32* ) bmp + ( sy ) * pixel_pitch + sx;
+            neo_video_simd_rows[ROWSMODE] ( br, pixel_pitch, gfxdata, l_y_skip, zy, paldata, xflip, zx - 1,
+                                            TILE_ROWS ( tileno ) );
+        }
+
+        return;
+    }
+
     if ( zx == 16 )
     {
         if ( xflip )
@@ -1290,8 +1308,7 @@ static void RENAME ( draw_scanline ) ( Uint32 tileno, Sint32 yoffs, Sint32 sx, S
     Uint32* paldata = ( Uint32* ) &current_pc_pal[16 * color];
     Sint32 pixel_pitch = PIXEL_PITCH;
 
-    tileno = tileno % neogeo_memory.nb_of_tiles;
-    gfxdata = ( Uint32* ) &neogeo_memory.rom.rom_region[REGION_SPRITES].p[ ( tileno << 7 )];
+    gfxdata = ( Uint32* ) sprite_tile_data ( tileno );
     gfxdata += ( yoffs << 1 );
 
     if ( gfxdata[1] + gfxdata[0] == 0 )
@@ -1299,6 +1316,16 @@ static void RENAME ( draw_scanline ) ( Uint32 tileno, Sint32 yoffs, Sint32 sx, S
         return;
     }
 
+    /* Vectorized kernel, zoom pattern zx is the one set in dda_x_skip */
+    if ( neo_video_simd_rows[ROWSMODE] != NULL )
+    {
+        br = ( Uint32* ) bmp + ( line ) * pixel_pitch + sx;
+        neo_video_simd_rows[ROWSMODE] ( br, 0, gfxdata, neo_video_simd_no_skip, 1, paldata, xflip, SDL_min ( zx, 15 ),
+                                        TILE_ROWS_FROM ( TILE_ROWS ( tileno ), yoffs ) );
+
+        return;
+    }
+
     if ( zx == 16 )
     {
         if ( xflip )
@@ -1917,3 +1944,4 @@ static void RENAME ( draw_scanline ) ( Uint32 tileno, Sint32 yoffs, Sint32 sx, S
 
 #undef RENAME
 #undef PUTPIXEL
+#undef ROWSMODE
@@ -0,0 +1,194 @@
+/*!
+*
+*   \file    GnGeoXworkers.c
+*   \brief   Worker threads pool routines.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Runs the parts of a job on a small pool of threads, one per core, the calling thread included.
+*/
+#ifndef _GNGEOX_WORKERS_C_
+#define _GNGEOX_WORKERS_C_
+#endif // _GNGEOX_WORKERS_C_
+
+#include <SDL2/SDL.h>
+#include "zlog.h"
+
+#include "GnGeoXworkers.h"
+#include "GnGeoXconfig.h"
+
+static struct_gngeoxworkers_pool pool;
+
+/* ******************************************************************************************************************/
+/*!
+* \brief  Runs job parts until none is left.
+*
+*/
+/* ******************************************************************************************************************/
+static void neo_workers_parts ( void )
+{
+    Sint32 part = 0;
+
+    while ( ( part = SDL_AtomicAdd ( &pool.next, 1 ) ) < pool.nb_parts )
+    {
+        pool.job ( pool.data, part );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Worker thread main loop.
+*
+* \param  data Unused.
+* \return Thread exit code.
+*/
+/* ******************************************************************************************************************/
+static int neo_workers_thread ( void* data )
+{
+    ( void ) data;
+
+    while ( 1 )
+    {
+        SDL_SemWait ( pool.start );
+
+        if ( pool.quit == SDL_TRUE )
+        {
+            break;
+        }
+
+        neo_workers_parts();
+
+        SDL_SemPost ( pool.done );
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Starts worker threads, one less than the number of cores.
+*
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+* \note   When threads can't be created, jobs simply run on the calling thread.
+*/
+/* ******************************************************************************************************************/
+SDL_bool neo_workers_init ( void )
+{
+    Sint32 wanted = SDL_min ( SDL_GetCPUCount() - 1, WORKERS_MAX );
+
+    SDL_zero ( pool );
+
+    if ( wanted <= 0 )
+    {
+        zlog_info ( gngeox_config.loggingCat, "Workers : none, single core" );
+        return ( SDL_TRUE );
+    }
+
+    pool.start = SDL_CreateSemaphore ( 0 );
+    pool.done = SDL_CreateSemaphore ( 0 );
+
+    if ( ( pool.start == NULL ) || ( pool.done == NULL ) )
+    {
+        zlog_error ( gngeox_config.loggingCat, "%s", SDL_GetError() );
+        return ( SDL_FALSE );
+    }
+
+    for ( Sint32 i = 0; i < wanted; i++ )
+    {
+        pool.thread[i] = SDL_CreateThread ( neo_workers_thread, "GnGeoXworker", NULL );
+
+        if ( pool.thread[i] == NULL )
+        {
+            zlog_warn ( gngeox_config.loggingCat, "Worker %d not started : %s", i, SDL_GetError() );
+            break;
+        }
+
+        pool.nb_threads++;
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Workers : %d threads", pool.nb_threads );
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gets how many parts can run at the same time.
+*
+* \return Number of worker threads plus the calling one.
+*/
+/* ******************************************************************************************************************/
+Sint32 neo_workers_count ( void )
+{
+    return ( pool.nb_threads + 1 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Runs all parts of a job and waits for them.
+*
+* \param  job Job to run, called once per part.
+* \param  data Job data.
+* \param  nb_parts Number of parts.
+* \note   Parts run in any order. Only one job runs at a time and a job can't start another one.
+*/
+/* ******************************************************************************************************************/
+void neo_workers_run ( worker_job job, void* data, Sint32 nb_parts )
+{
+    Sint32 woken = SDL_min ( pool.nb_threads, nb_parts - 1 );
+
+    pool.job = job;
+    pool.data = data;
+    pool.nb_parts = nb_parts;
+    SDL_AtomicSet ( &pool.next, 0 );
+
+    for ( Sint32 i = 0; i < woken; i++ )
+    {
+        SDL_SemPost ( pool.start );
+    }
+
+    neo_workers_parts();
+
+    for ( Sint32 i = 0; i < woken; i++ )
+    {
+        SDL_SemWait ( pool.done );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Stops worker threads.
+*
+*/
+/* ******************************************************************************************************************/
+void neo_workers_close ( void )
+{
+    pool.quit = SDL_TRUE;
+
+    for ( Sint32 i = 0; i < pool.nb_threads; i++ )
+    {
+        SDL_SemPost ( pool.start );
+    }
+
+    for ( Sint32 i = 0; i < pool.nb_threads; i++ )
+    {
+        SDL_WaitThread ( pool.thread[i], NULL );
+    }
+
+    if ( pool.start != NULL )
+    {
+        SDL_DestroySemaphore ( pool.start );
+    }
+
+    if ( pool.done != NULL )
+    {
+        SDL_DestroySemaphore ( pool.done );
+    }
+
+    SDL_zero ( pool );
+}
+
+#ifdef _GNGEOX_WORKERS_C_
+#undef _GNGEOX_WORKERS_C_
+#endif // _GNGEOX_WORKERS_C_
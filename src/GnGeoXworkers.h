@@ -0,0 +1,47 @@
+/*!
+*
+*   \file    GnGeoXworkers.h
+*   \brief   Worker threads pool header.
+*   \author  Mathieu Peponas, Espinetes, Ugenn (Original version)
+*   \author  James Ponder (68K emulation) / Juergen Buchmueller (Z80 emulation) / Marat Fayzullin (Z80 disassembler).
+*   \author  Tatsuyuki Satoh, Jarek Burczynski, NJ pspmvs, ElSemi (YM2610 emulation).
+*   \author  Andrea Mazzoleni, Maxim Stepin (Scale/HQ2X/XBR2X effect).
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Runs the parts of a job on a small pool of threads, one per core, the calling thread included.
+*/
+#ifndef _GNGEOX_WORKERS_H_
+#define _GNGEOX_WORKERS_H_
+
+#define WORKERS_MAX 16
+
+/* Job data, part index */
+typedef void ( *worker_job ) ( void*, Sint32 );
+
+typedef struct
+{
+    SDL_Thread* thread[WORKERS_MAX];
+    Sint32 nb_threads;
+    SDL_sem* start;
+    SDL_sem* done;
+    SDL_atomic_t next;
+    SDL_bool quit;
+    worker_job job;
+    void* data;
+    Sint32 nb_parts;
+} struct_gngeoxworkers_pool;
+
+#ifdef _GNGEOX_WORKERS_C_
+static int neo_workers_thread ( void* );
+static void neo_workers_parts ( void );
+#endif // _GNGEOX_WORKERS_C_
+
+SDL_bool neo_workers_init ( void ) __attribute__ ( ( warn_unused_result ) );
+Sint32 neo_workers_count ( void ) __attribute__ ( ( warn_unused_result ) );
+void neo_workers_run ( worker_job, void*, Sint32 );
+void neo_workers_close ( void );
+
+#endif
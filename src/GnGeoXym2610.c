@@ -22,10 +22,12 @@
 #endif // _GNGEOX_YM2610_C_
 
 #include <stdio.h>
+#include <string.h>
 
 #include <SDL2/SDL.h>
 #include "zlog.h"
 #include "qlibc.h"
+#include "bstrlib.h"
 
 #include "3rdParty/Z80/Z80.h"
 #include "GnGeoXym2610.h"
@@ -40,6 +42,13 @@
 static qlist_t * ym2610_timers[2];
 static double timer_count = 0;
 static double timer_increment = 0;
+static double silent_increment = 0;
+static double silent_samples = 0;
+
+static FILE* log_file = NULL;
+static Uint64 log_start = 0;
+static Uint64 log_samples = 0;
+static Uint8 log_address[2] = { 0, 0 };
 
 /* ******************************************************************************************************************/
 /*!
@@ -93,6 +102,212 @@ double neo_ym2610_count ( void )
 }
 /* ******************************************************************************************************************/
 /*!
+* \brief  Writes a little endian 32 bits value to register log.
+*
+* \param  value Value to write.
+*/
+/* ******************************************************************************************************************/
+static void neo_ym2610_log_u32 ( Uint32 value )
+{
+    fputc ( value & 0xFF, log_file );
+    fputc ( ( value >> 8 ) & 0xFF, log_file );
+    fputc ( ( value >> 16 ) & 0xFF, log_file );
+    fputc ( ( value >> 24 ) & 0xFF, log_file );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Writes an ADPCM ROM data block to register log.
+*
+* \param  type YM2610_LOG_ROM_ADPCM_A or YM2610_LOG_ROM_ADPCM_B.
+* \param  rom ROM data.
+* \param  size ROM size.
+*/
+/* ******************************************************************************************************************/
+static void neo_ym2610_log_rom ( Uint8 type, const Uint8* rom, Uint32 size )
+{
+    if ( ( rom == NULL ) || ( size == 0 ) )
+    {
+        return;
+    }
+
+    fputc ( YM2610_LOG_CMD_BLOCK, log_file );
+    fputc ( YM2610_LOG_CMD_END, log_file );
+    fputc ( type, log_file );
+    /* Block size, then whole ROM size and start address of this block */
+    neo_ym2610_log_u32 ( size + 8 );
+    neo_ym2610_log_u32 ( size );
+    neo_ym2610_log_u32 ( 0 );
+    fwrite ( rom, 1, size, log_file );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Opens register log and dumps ADPCM ROMs into it.
+*
+* \note   The file is named after the game and stored with saves.
+*/
+/* ******************************************************************************************************************/
+static void neo_ym2610_log_open ( void )
+{
+    bstring fpath = NULL;
+    Uint8 header[YM2610_LOG_HEADER_SIZE];
+
+    fpath = bfromcstr ( gngeox_config.savespath );
+    bcatcstr ( fpath, "/" );
+    bcatcstr ( fpath, gngeox_config.gamename );
+    bcatcstr ( fpath, ".vgm" );
+
+    log_file = fopen ( ( const char* ) fpath->data, "wb" );
+    if ( log_file == NULL )
+    {
+        zlog_error ( gngeox_config.loggingCat, "Can not create sound log %s", fpath->data );
+        bdestroy ( fpath );
+        return;
+    }
+
+    zlog_info ( gngeox_config.loggingCat, "Logging YM2610 writes to %s", fpath->data );
+    bdestroy ( fpath );
+
+    /* Offsets and sample count are patched when closing */
+    SDL_zero ( header );
+    memcpy ( header, "Vgm ", 4 );
+    fwrite ( header, 1, sizeof ( header ), log_file );
+
+    fseek ( log_file, 8, SEEK_SET );
+    neo_ym2610_log_u32 ( YM2610_LOG_VERSION );
+    fseek ( log_file, YM2610_LOG_DATA_OFFSET, SEEK_SET );
+    neo_ym2610_log_u32 ( YM2610_LOG_HEADER_SIZE - YM2610_LOG_DATA_OFFSET );
+    fseek ( log_file, YM2610_LOG_CLOCK, SEEK_SET );
+    neo_ym2610_log_u32 ( YM2610_CLOCK_FREQ_HZ );
+    fseek ( log_file, YM2610_LOG_HEADER_SIZE, SEEK_SET );
+
+    neo_ym2610_log_rom ( YM2610_LOG_ROM_ADPCM_A,
+                         neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].p,
+                         neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].size );
+    neo_ym2610_log_rom ( YM2610_LOG_ROM_ADPCM_B,
+                         neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_2].p,
+                         neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_2].size );
+
+    log_start = ( Uint64 ) ( timer_count * YM2610_LOG_RATE );
+    log_samples = log_start;
+    log_address[0] = log_address[1] = 0;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Writes wait commands up to present time in register log.
+*
+*/
+/* ******************************************************************************************************************/
+static void neo_ym2610_log_wait ( void )
+{
+    Uint64 now = ( Uint64 ) ( timer_count * YM2610_LOG_RATE );
+
+    while ( now > log_samples )
+    {
+        Uint32 wait = ( Uint32 ) SDL_min ( now - log_samples, ( Uint64 ) 0xFFFF );
+
+        fputc ( YM2610_LOG_CMD_WAIT, log_file );
+        fputc ( wait & 0xFF, log_file );
+        fputc ( wait >> 8, log_file );
+        log_samples += wait;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Terminates register log and patches its header.
+*
+*/
+/* ******************************************************************************************************************/
+static void neo_ym2610_log_close ( void )
+{
+    long size = 0;
+
+    if ( log_file == NULL )
+    {
+        return;
+    }
+
+    neo_ym2610_log_wait();
+    fputc ( YM2610_LOG_CMD_END, log_file );
+    size = ftell ( log_file );
+
+    fseek ( log_file, YM2610_LOG_EOF_OFFSET, SEEK_SET );
+    neo_ym2610_log_u32 ( ( Uint32 ) size - YM2610_LOG_EOF_OFFSET );
+    fseek ( log_file, YM2610_LOG_SAMPLES, SEEK_SET );
+    neo_ym2610_log_u32 ( ( Uint32 ) ( log_samples - log_start ) );
+
+    fclose ( log_file );
+    log_file = NULL;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Writes to YM2610, logging register writes if asked.
+*
+* \param  port 0 / 2 for address A / B, 1 / 3 for data A / B.
+* \param  value Address or data.
+* \note   Timestamps come from timer_count, so they are as precise as Z80 interlacing.
+*/
+/* ******************************************************************************************************************/
+void neo_ym2610_write ( Sint32 port, Uint8 value )
+{
+    if ( log_file != NULL )
+    {
+        if ( port & 1 )
+        {
+            neo_ym2610_log_wait();
+
+            fputc ( ( port & 2 ) ? YM2610_LOG_CMD_PORT_B : YM2610_LOG_CMD_PORT_A, log_file );
+            fputc ( log_address[port >> 1], log_file );
+            fputc ( value, log_file );
+        }
+        else
+        {
+            log_address[port >> 1] = value;
+        }
+    }
+
+    YM2610Write ( port, value );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Rate at which the YM2610 emulation produces samples.
+*
+* \return Internal synthesis rate in Hz.
+* \note   Anything other than the output sample rate is resampled by the sound module.
+*/
+/* ******************************************************************************************************************/
+Uint32 neo_ym2610_rate ( void )
+{
+    switch ( gngeox_config.ym2610rate )
+    {
+    case ( 0 ) :
+        {
+            return ( gngeox_config.samplerate );
+        }
+        break;
+    case ( 1 ) :
+        {
+            return ( YM2610_NATIVE_RATE );
+        }
+        break;
+    default:
+        {
+            if ( gngeox_config.ym2610rate < YM2610_MIN_RATE )
+            {
+                return ( YM2610_MIN_RATE );
+            }
+
+            if ( gngeox_config.ym2610rate > YM2610_NATIVE_RATE )
+            {
+                return ( YM2610_NATIVE_RATE );
+            }
+
+            return ( gngeox_config.ym2610rate );
+        }
+        break;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
 * \brief  Initializes YM2610 and timers.
 *
 */
@@ -101,7 +316,7 @@ SDL_bool neo_ym2610_init ( void )
 {
     /* initialize YM2610 */
     YM2610Init ( YM2610_CLOCK_FREQ_HZ,
-                 gngeox_config.samplerate,
+                 neo_ym2610_rate(),
                  neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].p,
                  neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_1].size,
                  neogeo_memory.rom.rom_region[REGION_AUDIO_DATA_2].p,
@@ -130,6 +345,15 @@ SDL_bool neo_ym2610_init ( void )
         timer_increment = ( ( double ) ( 0.01666 ) / EMU_NB_INTERLACE );
     }
 
+    /* Without audio output, chip is advanced from emulation loop at its own rate */
+    silent_increment = neo_ym2610_rate() * timer_increment;
+    silent_samples = 0;
+
+    if ( gngeox_config.soundlog )
+    {
+        neo_ym2610_log_open();
+    }
+
     return ( SDL_TRUE );
 }
 /* ******************************************************************************************************************/
@@ -143,6 +367,17 @@ void neo_ym2610_update ( void )
     /* 16ms par frame */
     timer_count += timer_increment;
 
+    if ( gngeox_config.nosound )
+    {
+        Sint32 length = 0;
+
+        silent_samples += silent_increment;
+        length = ( Sint32 ) silent_samples;
+        silent_samples -= length;
+
+        YM2610Update_silent ( length );
+    }
+
     for ( Uint32 loop1 = 0; loop1 < YM2610_MAX_TIMERS ; loop1++ )
     {
         for ( Uint32 loop2 = 0; loop2 < ym2610_timers[loop1]->num ; loop2++ )
@@ -168,6 +403,8 @@ void neo_ym2610_update ( void )
 /* ******************************************************************************************************************/
 void neo_ym2610_close ( void )
 {
+    neo_ym2610_log_close();
+
     for ( Sint32 loop = 0; loop < YM2610_MAX_TIMERS ; loop++ )
     {
         qlist_free ( ym2610_timers[loop] );
@@ -22,6 +22,25 @@
 
 #define YM2610_CLOCK_FREQ_HZ 8000000
 #define YM2610_MAX_TIMERS    2
+/* FM output rate of the real chip, one sample every 144 clocks */
+#define YM2610_NATIVE_RATE   ( YM2610_CLOCK_FREQ_HZ / 144 )
+#define YM2610_MIN_RATE      8000
+
+/* Register log, laid out as a VGM 1.51 file */
+#define YM2610_LOG_RATE        44100
+#define YM2610_LOG_VERSION     0x00000151
+#define YM2610_LOG_HEADER_SIZE 0x100
+#define YM2610_LOG_EOF_OFFSET  0x04
+#define YM2610_LOG_SAMPLES     0x18
+#define YM2610_LOG_DATA_OFFSET 0x34
+#define YM2610_LOG_CLOCK       0x4C
+#define YM2610_LOG_CMD_PORT_A  0x58
+#define YM2610_LOG_CMD_PORT_B  0x59
+#define YM2610_LOG_CMD_WAIT    0x61
+#define YM2610_LOG_CMD_END     0x66
+#define YM2610_LOG_CMD_BLOCK   0x67
+#define YM2610_LOG_ROM_ADPCM_A 0x82
+#define YM2610_LOG_ROM_ADPCM_B 0x83
 
 typedef struct struct_gngeoxtimer_timer struct_gngeoxtimer_timer;
 struct struct_gngeoxtimer_timer
@@ -31,10 +50,17 @@ struct struct_gngeoxtimer_timer
 
 #ifdef _GNGEOX_YM2610_C_
 static void neo_ym2610_callback ( Sint32, Sint32, double );
+static void neo_ym2610_log_u32 ( Uint32 );
+static void neo_ym2610_log_rom ( Uint8, const Uint8*, Uint32 );
+static void neo_ym2610_log_open ( void );
+static void neo_ym2610_log_wait ( void );
+static void neo_ym2610_log_close ( void );
 #endif // _GNGEOX_YM2610_INTERF_C_
 
 SDL_bool neo_ym2610_init ( void ) __attribute__ ( ( warn_unused_result ) );
+Uint32 neo_ym2610_rate ( void );
 double neo_ym2610_count ( void );
+void neo_ym2610_write ( Sint32, Uint8 );
 void neo_ym2610_update ( void );
 void neo_ym2610_close ( void );
 
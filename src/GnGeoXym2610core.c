@@ -29,6 +29,14 @@
 #include "GnGeoXym2610.h"
 #include "GnGeoXym2610core.h"
 
+/* @note (Tmesys#1#18/10/2026): Define YM2610_FM_SCALAR to force the scalar reference FM path. */
+#if defined ( __SSE2__ ) && !defined ( YM2610_FM_SCALAR )
+#define YM2610_FM_SIMD 1
+#include <immintrin.h>
+#else
+#define YM2610_FM_SIMD 0
+#endif
+
 /*  TL_TAB_LEN is calculated as:
  *   13 - sinus amplitude bits     (Y axis)
  *   2  - sinus sign bit           (Y axis)
@@ -400,6 +408,11 @@ static FM_IRQHANDLER sav_IRQHandler;
 static Uint8* pcmbufB = 0;
 static Uint32 pcmsizeB = 0;
 
+#if YM2610_FM_SIMD
+/* FM working copy used while rendering */
+static FM_SOA fm_soa;
+#endif
+
 /* Forecast to next Forecast (rate = *8) */
 /* 1/8 , 3/8 , 5/8 , 7/8 , 9/8 , 11/8 , 13/8 , 15/8 */
 static const Sint32 adpcmb_decode_table1[16] = { 1, 3, 5, 7, 9, 11, 13, 15, -1, -3,
@@ -923,6 +936,8 @@ static void set_sl_rr ( FM_SLOT* slot, Sint32 value )
     slot->eg_sh_rr = eg_rate_shift[slot->rr + slot->ksr];
     slot->eg_sel_rr = eg_rate_select[slot->rr + slot->ksr];
 }
+
+#if !YM2610_FM_SIMD
 /* ******************************************************************************************************************/
 /*!
 * \brief ???
@@ -971,6 +986,7 @@ static Sint32 op_calc1 ( Uint32 phase, Uint32 env, Sint32 pm )
 
     return ( tl_tab[p] );
 }
+#endif // !YM2610_FM_SIMD
 /* ******************************************************************************************************************/
 /*!
 * \brief Advances LFO to next sample.
@@ -1030,151 +1046,170 @@ static void advance_lfo ( FM_OPN* opn )
 }
 /* ******************************************************************************************************************/
 /*!
-* \brief ???
+* \brief Advances envelope generator of one operator.
 *
 * \param opn Todo.
-* \param slot Todo.
+* \param slot Operator configuration (rates, sustain level, SSG-EG).
+* \param volume Envelope counter.
+* \param state Envelope phase.
+* \param ssgn SSG-EG negated output.
+* \param swap_flag SSG-EG swap flag carried over from previous operator.
+* \return Updated swap flag.
 */
 /* ******************************************************************************************************************/
-static void advance_eg_channel ( const FM_OPN* opn, FM_SLOT* slot )
+static Uint32 advance_eg_slot ( const FM_OPN* opn, const FM_SLOT* slot, Sint32* volume, Uint8* state, Uint8 ssgn, Uint32 swap_flag )
 {
-    Uint32 out = 0;
-    Uint32 swap_flag = 0;
-    /* four operators per channel */
-    Uint32 i = 4;
-
-    do
+    switch ( *state )
     {
-        switch ( slot->state )
+    /* attack phase */
+    case ( EG_ATT ) :
         {
-        /* attack phase */
-        case ( EG_ATT ) :
+            if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_ar ) - 1 ) ) )
             {
-                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_ar ) - 1 ) ) )
-                {
-                    slot->volume += ( ~slot->volume
-                                      * ( eg_inc[slot->eg_sel_ar + ( ( opn->eg_cnt >> slot->eg_sh_ar ) & 7 )] ) ) >> 4;
+                *volume += ( ~*volume
+                                  * ( eg_inc[slot->eg_sel_ar + ( ( opn->eg_cnt >> slot->eg_sh_ar ) & 7 )] ) ) >> 4;
 
-                    if ( slot->volume <= MIN_ATT_INDEX )
-                    {
-                        slot->volume = MIN_ATT_INDEX;
-                        slot->state = EG_DEC;
-                    }
+                if ( *volume <= MIN_ATT_INDEX )
+                {
+                    *volume = MIN_ATT_INDEX;
+                    *state = EG_DEC;
                 }
             }
-            break;
-        /* decay phase */
-        case ( EG_DEC ) :
+        }
+        break;
+    /* decay phase */
+    case ( EG_DEC ) :
+        {
+            if ( slot->ssg & 0x08 ) /* SSG EG type envelope selected */
             {
-                if ( slot->ssg & 0x08 ) /* SSG EG type envelope selected */
+                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d1r ) - 1 ) ) )
                 {
-                    if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d1r ) - 1 ) ) )
-                    {
-                        slot->volume += ( eg_inc[slot->eg_sel_d1r + ( ( opn->eg_cnt >> slot->eg_sh_d1r ) & 7 )] << 2 );
+                    *volume += ( eg_inc[slot->eg_sel_d1r + ( ( opn->eg_cnt >> slot->eg_sh_d1r ) & 7 )] << 2 );
 
-                        if ( slot->volume >= slot->sl )
-                        {
-                            slot->state = EG_SUS;
-                        }
+                    if ( *volume >= slot->sl )
+                    {
+                        *state = EG_SUS;
                     }
                 }
-                else
+            }
+            else
+            {
+                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d1r ) - 1 ) ) )
                 {
-                    if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d1r ) - 1 ) ) )
-                    {
-                        slot->volume += eg_inc[slot->eg_sel_d1r + ( ( opn->eg_cnt >> slot->eg_sh_d1r ) & 7 )];
+                    *volume += eg_inc[slot->eg_sel_d1r + ( ( opn->eg_cnt >> slot->eg_sh_d1r ) & 7 )];
 
-                        if ( slot->volume >= slot->sl )
-                        {
-                            slot->state = EG_SUS;
-                        }
+                    if ( *volume >= slot->sl )
+                    {
+                        *state = EG_SUS;
                     }
                 }
-
             }
-            break;
-        /* sustain phase */
-        case ( EG_SUS ) :
+
+        }
+        break;
+    /* sustain phase */
+    case ( EG_SUS ) :
+        {
+            if ( slot->ssg & 0x08 ) /* SSG EG type envelope selected */
             {
-                if ( slot->ssg & 0x08 ) /* SSG EG type envelope selected */
+                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d2r ) - 1 ) ) )
                 {
-                    if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d2r ) - 1 ) ) )
+                    *volume += ( eg_inc[slot->eg_sel_d2r + ( ( opn->eg_cnt >> slot->eg_sh_d2r ) & 7 )] << 2 );
+
+                    if ( *volume >= MAX_ATT_INDEX )
                     {
-                        slot->volume += ( eg_inc[slot->eg_sel_d2r + ( ( opn->eg_cnt >> slot->eg_sh_d2r ) & 7 )] << 2 );
+                        *volume = MAX_ATT_INDEX;
 
-                        if ( slot->volume >= MAX_ATT_INDEX )
+                        if ( slot->ssg & 0x01 ) /* bit 0 = hold */
                         {
-                            slot->volume = MAX_ATT_INDEX;
-
-                            if ( slot->ssg & 0x01 ) /* bit 0 = hold */
+                            if ( ssgn & 1 ) /* have we swapped once ??? */
                             {
-                                if ( slot->ssgn & 1 ) /* have we swapped once ??? */
-                                {
-                                    /* yes, so do nothing, just hold current level */
-                                }
-                                else
-                                {
-                                    swap_flag = ( slot->ssg & 0x02 ) | 1;    /* bit 1 = alternate */
-                                }
-
+                                /* yes, so do nothing, just hold current level */
                             }
                             else
                             {
-                                /* same as KEY-ON operation */
+                                swap_flag = ( slot->ssg & 0x02 ) | 1;    /* bit 1 = alternate */
+                            }
 
-                                /* restart of the Phase Generator should be here,
-                                 only if AR is not maximum ??? */
-                                /*slot->phase = 0;*/
+                        }
+                        else
+                        {
+                            /* same as KEY-ON operation */
 
-                                /* phase -> Attack */
-                                slot->state = EG_ATT;
+                            /* restart of the Phase Generator should be here,
+                             only if AR is not maximum ??? */
+                            /*slot->phase = 0;*/
 
-                                swap_flag = ( slot->ssg & 0x02 ); /* bit 1 = alternate */
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d2r ) - 1 ) ) )
-                    {
-                        slot->volume += eg_inc[slot->eg_sel_d2r
-                                               + ( ( opn->eg_cnt >> slot->eg_sh_d2r ) & 7 )];
+                            /* phase -> Attack */
+                            *state = EG_ATT;
 
-                        if ( slot->volume >= MAX_ATT_INDEX )
-                        {
-                            slot->volume = MAX_ATT_INDEX;
-                            /* do not change slot->state (verified on real chip) */
+                            swap_flag = ( slot->ssg & 0x02 ); /* bit 1 = alternate */
                         }
                     }
-
                 }
             }
-            break;
-        /* release phase */
-        case ( EG_REL ) :
+            else
             {
-                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_rr ) - 1 ) ) )
+                if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_d2r ) - 1 ) ) )
                 {
-                    slot->volume += eg_inc[slot->eg_sel_rr
-                                           + ( ( opn->eg_cnt >> slot->eg_sh_rr ) & 7 )];
+                    *volume += eg_inc[slot->eg_sel_d2r
+                                           + ( ( opn->eg_cnt >> slot->eg_sh_d2r ) & 7 )];
 
-                    if ( slot->volume >= MAX_ATT_INDEX )
+                    if ( *volume >= MAX_ATT_INDEX )
                     {
-                        slot->volume = MAX_ATT_INDEX;
-                        slot->state = EG_OFF;
+                        *volume = MAX_ATT_INDEX;
+                        /* do not change state (verified on real chip) */
                     }
                 }
+
             }
-            break;
-            /*
-                    default :
-                        {
-                            zlog_error ( gngeox_config.loggingCat, "Unknown slot state %d", slot->state );
-                        }
-                        break;
-            */
         }
+        break;
+    /* release phase */
+    case ( EG_REL ) :
+        {
+            if ( ! ( opn->eg_cnt & ( ( 1 << slot->eg_sh_rr ) - 1 ) ) )
+            {
+                *volume += eg_inc[slot->eg_sel_rr
+                                       + ( ( opn->eg_cnt >> slot->eg_sh_rr ) & 7 )];
+
+                if ( *volume >= MAX_ATT_INDEX )
+                {
+                    *volume = MAX_ATT_INDEX;
+                    *state = EG_OFF;
+                }
+            }
+        }
+        break;
+        /*
+                default :
+                    {
+                        zlog_error ( gngeox_config.loggingCat, "Unknown slot state %d", *state );
+                    }
+                    break;
+        */
+    }
+
+    return ( swap_flag );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief ???
+*
+* \param opn Todo.
+* \param slot Todo.
+*/
+/* ******************************************************************************************************************/
+static void advance_eg_channel ( const FM_OPN* opn, FM_SLOT* slot )
+{
+    Uint32 out = 0;
+    Uint32 swap_flag = 0;
+    /* four operators per channel */
+    Uint32 i = 4;
+
+    do
+    {
+        swap_flag = advance_eg_slot ( opn, slot, &slot->volume, &slot->state, slot->ssgn, swap_flag );
 
         out = slot->tl + ( ( Uint32 ) slot->volume );
 
@@ -1195,6 +1230,8 @@ static void advance_eg_channel ( const FM_OPN* opn, FM_SLOT* slot )
     }
     while ( i );
 }
+
+#if !YM2610_FM_SIMD
 /* ******************************************************************************************************************/
 /*!
 * \brief ???
@@ -1319,6 +1356,301 @@ static void chan_calc ( FM_OPN* OPN, FM_CH* CH )
         CH->SLOT[SLOT4].phase += CH->SLOT[SLOT4].Incr;
     }
 }
+#endif // !YM2610_FM_SIMD
+
+#if YM2610_FM_SIMD
+/* ******************************************************************************************************************/
+/*!
+* \brief Looks up four table entries.
+*
+* \param table Table to read.
+* \param index Four indexes.
+* \return Four table entries.
+*/
+/* ******************************************************************************************************************/
+static inline __m128i fm_gather_x4 ( const Sint32* table, __m128i index )
+{
+#if defined ( __AVX2__ )
+    return ( _mm_i32gather_epi32 ( ( const int* ) table, index, 4 ) );
+#else
+    Sint32 i[4] __attribute__ ( ( aligned ( 16 ) ) );
+
+    _mm_store_si128 ( ( __m128i* ) i, index );
+
+    return ( _mm_set_epi32 ( table[i[3]], table[i[2]], table[i[1]], table[i[0]] ) );
+#endif
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Computes one operator of four channels, same as op_calc1 ().
+*
+* \param phase Phase counters.
+* \param env Envelopes.
+* \param pm Phase modulations (already shifted).
+* \return Operators output.
+*/
+/* ******************************************************************************************************************/
+static inline __m128i op_calc_x4 ( __m128i phase, __m128i env, __m128i pm )
+{
+    __m128i index = _mm_add_epi32 ( _mm_and_si128 ( phase, _mm_set1_epi32 ( ~FREQ_MASK ) ), pm );
+    __m128i p = _mm_and_si128 ( _mm_srli_epi32 ( index, FREQ_SH ), _mm_set1_epi32 ( SIN_MASK ) );
+    __m128i audible;
+
+    p = _mm_add_epi32 ( _mm_slli_epi32 ( env, 3 ), fm_gather_x4 ( ( const Sint32* ) sin_tab, p ) );
+
+    /* p >= TL_TAB_LEN (which includes env >= ENV_QUIET) gives a silent operator */
+    audible = _mm_cmplt_epi32 ( p, _mm_set1_epi32 ( TL_TAB_LEN ) );
+
+    return ( _mm_and_si128 ( fm_gather_x4 ( tl_tab, _mm_and_si128 ( p, audible ) ), audible ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Loads YM2610 FM channels into structure-of-arrays working copy.
+*
+* \param soa Working copy.
+* \param cch The four channels.
+*/
+/* ******************************************************************************************************************/
+static void fm_soa_load ( FM_SOA* soa, FM_CH** cch )
+{
+    soa->pms = 0;
+
+    for ( Sint32 c = 0; c < 4; c++ )
+    {
+        FM_CH* CH = cch[c];
+        Sint32* carrier = CH->connect4;
+
+        soa->CH[c] = CH;
+
+        for ( Sint32 s = 0; s < 4; s++ )
+        {
+            const FM_SLOT* SLOT = &CH->SLOT[s];
+
+            soa->phase[s][c] = soa->snap_phase[s][c] = SLOT->phase;
+            soa->Incr[s][c] = SLOT->Incr;
+            soa->volume[s][c] = SLOT->volume;
+            soa->vol_out[s][c] = SLOT->vol_out;
+            soa->tl[s][c] = SLOT->tl;
+            soa->AMmask[s][c] = SLOT->AMmask;
+            soa->state[s][c] = soa->snap_state[s][c] = SLOT->state;
+            soa->ssgn[s][c] = soa->snap_ssgn[s][c] = SLOT->ssgn;
+        }
+
+        soa->op1_out[0][c] = CH->op1_out[0];
+        soa->op1_out[1][c] = CH->op1_out[1];
+        soa->mem_value[c] = CH->mem_value;
+        soa->ams[c] = CH->ams;
+        soa->fb[c] = CH->FB;
+        soa->pms |= CH->pms;
+
+        /* algorithm 5 (connect1 == NULL) sends M1 to C1, MEM and C2 */
+        soa->op1_to_c1[c] = ( CH->connect1 == &c1 || CH->connect1 == NULL ) ? ~0 : 0;
+        soa->op1_to_c2[c] = ( CH->connect1 == &c2 || CH->connect1 == NULL ) ? ~0 : 0;
+        soa->op1_to_mem[c] = ( CH->connect1 == &mem || CH->connect1 == NULL ) ? ~0 : 0;
+        soa->op1_to_out[c] = ( CH->connect1 == carrier ) ? ~0 : 0;
+        soa->mem_to_m2[c] = ( CH->mem_connect == &m2 ) ? ~0 : 0;
+        soa->mem_to_c2[c] = ( CH->mem_connect == &c2 ) ? ~0 : 0;
+        soa->mem_to_mem[c] = ( CH->mem_connect == &mem ) ? ~0 : 0;
+        soa->op3_to_c2[c] = ( CH->connect3 == &c2 ) ? ~0 : 0;
+        soa->op3_to_out[c] = ( CH->connect3 == carrier ) ? ~0 : 0;
+        soa->op2_to_mem[c] = ( CH->connect2 == &mem ) ? ~0 : 0;
+        soa->op2_to_out[c] = ( CH->connect2 == carrier ) ? ~0 : 0;
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Stores structure-of-arrays working copy back into YM2610 FM channels.
+*
+* \param soa Working copy.
+*
+* \note   Operators keyed on/off (or SSG-EG reprogrammed) while rendering keep the new state.
+*/
+/* ******************************************************************************************************************/
+static void fm_soa_store ( const FM_SOA* soa )
+{
+    for ( Sint32 c = 0; c < 4; c++ )
+    {
+        FM_CH* CH = soa->CH[c];
+
+        for ( Sint32 s = 0; s < 4; s++ )
+        {
+            FM_SLOT* SLOT = &CH->SLOT[s];
+
+            if ( ( SLOT->phase == soa->snap_phase[s][c] ) && ( SLOT->state == soa->snap_state[s][c] )
+                    && ( SLOT->ssgn == soa->snap_ssgn[s][c] ) )
+            {
+                SLOT->phase = soa->phase[s][c];
+                SLOT->state = soa->state[s][c];
+                SLOT->ssgn = soa->ssgn[s][c];
+            }
+
+            SLOT->volume = soa->volume[s][c];
+            SLOT->vol_out = soa->vol_out[s][c];
+        }
+
+        CH->op1_out[0] = soa->op1_out[0][c];
+        CH->op1_out[1] = soa->op1_out[1][c];
+        CH->mem_value = soa->mem_value[c];
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Advances envelope generator of the four channels, same as advance_eg_channel ().
+*
+* \param soa Working copy.
+* \param opn Todo.
+*/
+/* ******************************************************************************************************************/
+static void fm_soa_advance_eg ( FM_SOA* soa, const FM_OPN* opn )
+{
+    for ( Sint32 c = 0; c < 4; c++ )
+    {
+        const FM_SLOT* SLOT = soa->CH[c]->SLOT;
+        Uint32 swap_flag = 0;
+
+        for ( Sint32 s = 0; s < 4; s++ )
+        {
+            swap_flag = advance_eg_slot ( opn, &SLOT[s], &soa->volume[s][c], &soa->state[s][c], soa->ssgn[s][c], swap_flag );
+
+            /* negate output (changes come from alternate bit, init comes from attack bit) */
+            soa->negate[s][c] = ( ( SLOT[s].ssg & 0x08 ) && ( soa->ssgn[s][c] & 2 ) ) ? ( ( 1 << ENV_BITS ) - 1 ) : 0;
+
+            soa->ssgn[s][c] ^= swap_flag;
+        }
+    }
+
+    /* envelope attenuation */
+    for ( Sint32 s = 0; s < 4; s++ )
+    {
+        __m128i out = _mm_add_epi32 ( _mm_loadu_si128 ( ( const __m128i* ) soa->tl[s] ),
+                                      _mm_loadu_si128 ( ( const __m128i* ) soa->volume[s] ) );
+
+        out = _mm_xor_si128 ( out, _mm_loadu_si128 ( ( const __m128i* ) soa->negate[s] ) );
+        _mm_storeu_si128 ( ( __m128i* ) soa->vol_out[s], out );
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Computes one sample of the four channels, same as chan_calc ().
+*
+* \param soa Working copy.
+* \param OPN Todo.
+*/
+/* ******************************************************************************************************************/
+static void fm_soa_calc ( FM_SOA* soa, const FM_OPN* OPN )
+{
+#define LOAD(x) _mm_loadu_si128 ( ( const __m128i* ) ( x ) )
+#define STORE(x, v) _mm_storeu_si128 ( ( __m128i* ) ( x ), v )
+    Sint32 pm1[4] __attribute__ ( ( aligned ( 16 ) ) );
+    __m128i am = _mm_set_epi32 ( LFO_AM >> soa->ams[3], LFO_AM >> soa->ams[2], LFO_AM >> soa->ams[1], LFO_AM >> soa->ams[0] );
+    __m128i env[4];
+    __m128i mv = LOAD ( soa->mem_value );
+    __m128i old0 = LOAD ( soa->op1_out[0] );
+    __m128i o1 = LOAD ( soa->op1_out[1] );
+    __m128i vm2, vc1, vc2, vmem, vout, op;
+
+    for ( Sint32 s = 0; s < 4; s++ )
+    {
+        env[s] = _mm_add_epi32 ( LOAD ( soa->vol_out[s] ), _mm_and_si128 ( am, LOAD ( soa->AMmask[s] ) ) );
+    }
+
+    /* restore delayed sample (MEM) value to m2 or c2 */
+    vm2 = _mm_and_si128 ( mv, LOAD ( soa->mem_to_m2 ) );
+    vc2 = _mm_and_si128 ( mv, LOAD ( soa->mem_to_c2 ) );
+    vmem = _mm_and_si128 ( mv, LOAD ( soa->mem_to_mem ) );
+
+    /* SLOT 1 */
+    vc1 = _mm_and_si128 ( o1, LOAD ( soa->op1_to_c1 ) );
+    vc2 = _mm_add_epi32 ( vc2, _mm_and_si128 ( o1, LOAD ( soa->op1_to_c2 ) ) );
+    vmem = _mm_add_epi32 ( vmem, _mm_and_si128 ( o1, LOAD ( soa->op1_to_mem ) ) );
+    vout = _mm_and_si128 ( o1, LOAD ( soa->op1_to_out ) );
+
+    STORE ( soa->op1_out[0], o1 );
+    STORE ( pm1, _mm_add_epi32 ( old0, o1 ) );
+
+    for ( Sint32 c = 0; c < 4; c++ )
+    {
+        pm1[c] = soa->fb[c] ? ( pm1[c] << soa->fb[c] ) : 0;
+    }
+
+    STORE ( soa->op1_out[1], op_calc_x4 ( LOAD ( soa->phase[SLOT1] ), env[SLOT1], LOAD ( pm1 ) ) );
+
+    /* SLOT 3 */
+    op = op_calc_x4 ( LOAD ( soa->phase[SLOT3] ), env[SLOT3], _mm_slli_epi32 ( vm2, 15 ) );
+    vc2 = _mm_add_epi32 ( vc2, _mm_and_si128 ( op, LOAD ( soa->op3_to_c2 ) ) );
+    vout = _mm_add_epi32 ( vout, _mm_and_si128 ( op, LOAD ( soa->op3_to_out ) ) );
+
+    /* SLOT 2 */
+    op = op_calc_x4 ( LOAD ( soa->phase[SLOT2] ), env[SLOT2], _mm_slli_epi32 ( vc1, 15 ) );
+    vmem = _mm_add_epi32 ( vmem, _mm_and_si128 ( op, LOAD ( soa->op2_to_mem ) ) );
+    vout = _mm_add_epi32 ( vout, _mm_and_si128 ( op, LOAD ( soa->op2_to_out ) ) );
+
+    /* SLOT 4 */
+    op = op_calc_x4 ( LOAD ( soa->phase[SLOT4] ), env[SLOT4], _mm_slli_epi32 ( vc2, 15 ) );
+    vout = _mm_add_epi32 ( vout, op );
+
+    /* store current MEM */
+    STORE ( soa->mem_value, vmem );
+    STORE ( soa->out, vout );
+
+    /* update phase counters AFTER output calculations */
+    if ( soa->pms )
+    {
+        Sint32 incr[4][4] __attribute__ ( ( aligned ( 16 ) ) );
+
+        memcpy ( incr, soa->Incr, sizeof ( incr ) );
+
+        for ( Sint32 c = 0; c < 4; c++ )
+        {
+            const FM_CH* CH = soa->CH[c];
+
+            if ( CH->pms )
+            {
+                Uint32 block_fnum = CH->block_fnum;
+                Uint32 fnum_lfo = ( ( block_fnum & 0x7f0 ) >> 4 ) * 32 * 8;
+                Sint32 lfo_fn_table_index_offset = lfo_pm_table[fnum_lfo + CH->pms + LFO_PM];
+
+                /* LFO phase modulation active */
+                if ( lfo_fn_table_index_offset )
+                {
+                    Uint8 blk = 0;
+                    Uint32 fn = 0;
+                    Sint32 kc = 0, fc = 0;
+
+                    block_fnum = block_fnum * 2 + lfo_fn_table_index_offset;
+
+                    blk = ( block_fnum & 0x7000 ) >> 12;
+                    fn = block_fnum & 0xfff;
+
+                    /* keyscale code */
+                    kc = ( blk << 2 ) | opn_fktable[fn >> 8];
+                    /* phase increment counter */
+                    fc = OPN->fn_table[fn] >> ( 7 - blk );
+
+                    for ( Sint32 s = 0; s < 4; s++ )
+                    {
+                        incr[s][c] = ( ( fc + CH->SLOT[s].DT[kc] ) * CH->SLOT[s].mul ) >> 1;
+                    }
+                }
+            }
+        }
+
+        for ( Sint32 s = 0; s < 4; s++ )
+        {
+            STORE ( soa->phase[s], _mm_add_epi32 ( LOAD ( soa->phase[s] ), LOAD ( incr[s] ) ) );
+        }
+    }
+    else
+    {
+        for ( Sint32 s = 0; s < 4; s++ )
+        {
+            STORE ( soa->phase[s], _mm_add_epi32 ( LOAD ( soa->phase[s] ), LOAD ( soa->Incr[s] ) ) );
+        }
+    }
+#undef LOAD
+#undef STORE
+}
+#endif // YM2610_FM_SIMD
 
 /* update phase increment and envelope generator */
 static void refresh_fc_eg_slot ( FM_SLOT* SLOT, Sint32 fc, Sint32 kc )
@@ -2918,6 +3250,88 @@ static void OPNB_ADPCMB_CALC ( ADPCMB* adpcmb )
     *adpcmb->pan += adpcmb->adpcml;
 }
 
+/* ADPCM A : move one channel address over length samples without decoding, keeps end flags exact */
+static void OPNB_ADPCMA_skip_chan ( ADPCMA* ch, Sint32 length )
+{
+    Uint32 step = 0;
+
+    ch->now_step += ch->step * ( Uint32 ) length;
+    step = ch->now_step >> ADPCM_SHIFT;
+    ch->now_step &= ( 1 << ADPCM_SHIFT ) - 1;
+
+    while ( step-- )
+    {
+        if ( ( ch->now_addr & ( ( 1 << 21 ) - 1 ) )
+                == ( ( ch->end << 1 ) & ( ( 1 << 21 ) - 1 ) ) )
+        {
+            ch->flag = 0;
+            YM2610.adpcm_arrivedEndAddress |= ch->flagMask;
+            return;
+        }
+
+        ch->now_addr++;
+    }
+
+    /* low nibble is taken from the byte latched on the even address */
+    if ( ch->now_addr & 1 )
+    {
+        ch->now_data = * ( pcmbufA + ( ch->now_addr >> 1 ) );
+    }
+}
+
+/* ADPCM B : move address over length samples without decoding, keeps limit, repeat and EOS exact */
+static void OPNB_ADPCMB_skip ( ADPCMB* adpcmb, Sint32 length )
+{
+    Uint32 step = 0;
+
+    adpcmb->now_step += adpcmb->step * ( Uint32 ) length;
+    step = adpcmb->now_step >> ADPCM_SHIFT;
+    adpcmb->now_step &= ( 1 << ADPCM_SHIFT ) - 1;
+
+    while ( step-- )
+    {
+        if ( adpcmb->now_addr == ( adpcmb->limit << 1 ) )
+        {
+            adpcmb->now_addr = 0;
+        }
+
+        if ( adpcmb->now_addr == ( adpcmb->end << 1 ) )
+        {
+            if ( adpcmb->portstate & 0x10 )
+            {
+                /* repeat start */
+                adpcmb->now_addr = adpcmb->start << 1;
+                adpcmb->acc = 0;
+                adpcmb->adpcmd = ADPCMB_DELTA_DEF;
+                adpcmb->prev_acc = 0;
+            }
+            else
+            {
+                /* set EOS bit in status register */
+                if ( adpcmb->status_change_EOS_bit )
+                    YM2610.adpcm_arrivedEndAddress |=
+                        adpcmb->status_change_EOS_bit;
+
+                /* clear PCM BUSY bit (reflected in status register) */
+                adpcmb->PCM_BSY = 0;
+
+                adpcmb->portstate = 0;
+                adpcmb->adpcml = 0;
+                adpcmb->prev_acc = 0;
+                return;
+            }
+        }
+
+        adpcmb->now_addr++;
+        adpcmb->now_addr &= ( ( 1 << ( 24 + 1 ) ) - 1 );
+    }
+
+    if ( adpcmb->now_addr & 1 )
+    {
+        adpcmb->now_data = * ( pcmbufB + ( adpcmb->now_addr >> 1 ) );
+    }
+}
+
 /*********************************************************************************************/
 
 /* YM2610(OPNB) */
@@ -3280,20 +3694,118 @@ void YM2610TimerOver ( Sint32 ch )
     }
 }
 
-/* Generate samples for one of the YM2610s */
-void YM2610Update_stream ( Sint32 length, Uint16* buffer )
+/* ******************************************************************************************************************/
+/*!
+* \brief Tells if a FM channel can produce anything.
+*
+* \param CH Channel.
+* \return 0 when all operators are off and quiet, and no feedback or delayed sample is pending.
+* \note   Phase of an off operator is never heard, key on restarts it. An off operator is
+*         not always quiet though, SSG-EG inversion may turn its maximum attenuation into full volume.
+*/
+/* ******************************************************************************************************************/
+static Sint32 fm_channel_active ( const FM_CH* CH )
 {
-    FM_OPN* OPN = &YM2610.OPN;
-    Sint32 outn = 0;
-    Sint32 lt = 0, rt = 0;
-    FM_CH* cch[6];
+    if ( CH->op1_out[0] | CH->op1_out[1] | CH->mem_value )
+    {
+        return ( 1 );
+    }
 
-    cch[0] = &YM2610.CH[1];
-    cch[1] = &YM2610.CH[2];
-    cch[2] = &YM2610.CH[4];
-    cch[3] = &YM2610.CH[5];
+    for ( Sint32 s = 0; s < 4; s++ )
+    {
+        const FM_SLOT* SLOT = &CH->SLOT[s];
+        /* what the envelope generator will compute on its next tick */
+        Uint32 out = SLOT->tl + ( ( Uint32 ) SLOT->volume );
 
-    /* update frequency counter */
+        if ( ( SLOT->ssg & 0x08 ) && ( SLOT->ssgn & 2 ) )
+        {
+            out ^= ( ( 1 << ENV_BITS ) - 1 );
+        }
+
+        if ( ( SLOT->state != EG_OFF ) || ( SLOT->vol_out < ENV_QUIET ) || ( out < ENV_QUIET ) )
+        {
+            return ( 1 );
+        }
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Tells if SSG can produce anything.
+*
+* \return 0 when the three channels are at volume 0 without envelope.
+* \note   Tone, noise and envelope counters are frozen while muted, resuming them only shifts the next note phase.
+*/
+/* ******************************************************************************************************************/
+static Sint32 ssg_active ( void )
+{
+    for ( Sint32 ch = 0; ch < 3; ch++ )
+    {
+        if ( SSG.envelope[ch] || SSG.vol[ch] )
+        {
+            return ( 1 );
+        }
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Tells if any ADPCM channel is playing.
+*
+* \return 0 when ADPCM-A flags and ADPCM-B port state are clear.
+*/
+/* ******************************************************************************************************************/
+static Sint32 adpcm_active ( void )
+{
+    if ( YM2610.adpcmb.portstate & 0x80 )
+    {
+        return ( 1 );
+    }
+
+    for ( Sint32 j = 0; j < 6; j++ )
+    {
+        if ( YM2610.adpcma[j].flag )
+        {
+            return ( 1 );
+        }
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief Advances LFO and envelope counters over a block without any FM channel to update.
+*
+* \param OPN FM part.
+* \param length Number of samples.
+* \note   Same counters as length calls to advance_lfo() and the envelope timer loop.
+*/
+/* ******************************************************************************************************************/
+static void advance_idle_fm ( FM_OPN* OPN, Sint32 length )
+{
+    Uint32 overflows = 0;
+
+    OPN->lfo_cnt += OPN->lfo_inc * ( Uint32 ) ( length - 1 );
+    advance_lfo ( OPN );
+
+    OPN->eg_timer += OPN->eg_timer_add * ( Uint32 ) length;
+    overflows = OPN->eg_timer / OPN->eg_timer_overflow;
+    OPN->eg_timer -= overflows * OPN->eg_timer_overflow;
+    OPN->eg_cnt += overflows;
+}
+
+/* ******************************************************************************************************************/
+/*!
+* \brief Updates phase increments and envelope rates after frequency writes.
+*
+* \param OPN FM part.
+* \param cch The four channels.
+*/
+/* ******************************************************************************************************************/
+static void refresh_fc_eg_channels ( FM_OPN* OPN, FM_CH** cch )
+{
     refresh_fc_eg_chan ( cch[0] );
 
     if ( OPN->ST.mode & 0xc0 )
@@ -3315,14 +3827,74 @@ void YM2610Update_stream ( Sint32 length, Uint16* buffer )
 
     refresh_fc_eg_chan ( cch[2] );
     refresh_fc_eg_chan ( cch[3] );
+}
+
+/* Generate samples for one of the YM2610s */
+void YM2610Update_stream ( Sint32 length, Uint16* buffer )
+{
+    FM_OPN* OPN = &YM2610.OPN;
+    Sint32 outn = 0;
+    Sint32 lt = 0, rt = 0;
+    FM_CH* cch[6];
+    Sint32 fm_active[4];
+    Sint32 fm_any = 0;
+    Sint32 ssg_on = 0;
+
+    if ( length <= 0 )
+    {
+        return;
+    }
+
+    cch[0] = &YM2610.CH[1];
+    cch[1] = &YM2610.CH[2];
+    cch[2] = &YM2610.CH[4];
+    cch[3] = &YM2610.CH[5];
+
+    for ( Sint32 c = 0; c < 4; c++ )
+    {
+        fm_active[c] = fm_channel_active ( cch[c] );
+        fm_any |= fm_active[c];
+    }
+
+    ssg_on = ssg_active();
+
+    /* @note (Tmesys#1#18/10/2026): Whole chip is silent (menus, between stages), only counters need to move. */
+    if ( !fm_any && !ssg_on && !adpcm_active() )
+    {
+        advance_idle_fm ( OPN, length );
+        memset ( buffer, 0, length * 2 * sizeof ( Uint16 ) );
+
+        INTERNAL_TIMER_B ( OPN->ST, length );
+        return;
+    }
+
+    /* update frequency counter */
+    refresh_fc_eg_channels ( OPN, cch );
+
+#if YM2610_FM_SIMD
+    /* @note (Tmesys#1#18/10/2026): Registers are copied once per call, so Z80 writes made while this buffer is rendered
+    are heard from the next buffer on, where the scalar path may pick them up in the middle of it. */
+    if ( fm_any )
+    {
+        fm_soa_load ( &fm_soa, cch );
+    }
+#endif
 
     /* calc SSG count */
     outn = SSG_calc_count ( length );
 
+    if ( !fm_any )
+    {
+        advance_idle_fm ( OPN, length );
+    }
+
     /* buffering */
     for ( Sint32 i = 0; i < length; i++ )
     {
-        advance_lfo ( OPN );
+        if ( fm_any )
+        {
+            advance_lfo ( OPN );
+        }
 
         /* clear output acc. */
         out_adpcma[OUTD_LEFT] = out_adpcma[OUTD_RIGHT] = out_adpcma[OUTD_CENTER] = 0;
@@ -3337,27 +3909,52 @@ void YM2610Update_stream ( Sint32 length, Uint16* buffer )
         /* clear outputs SSG */
         out_ssg = 0;
 
-        /* advance envelope generator */
-        OPN->eg_timer += OPN->eg_timer_add;
-
-        while ( OPN->eg_timer >= OPN->eg_timer_overflow )
+        if ( fm_any )
         {
-            OPN->eg_timer -= OPN->eg_timer_overflow;
-            OPN->eg_cnt++;
-            advance_eg_channel ( OPN, &cch[0]->SLOT[SLOT1] );
-            advance_eg_channel ( OPN, &cch[1]->SLOT[SLOT1] );
-            advance_eg_channel ( OPN, &cch[2]->SLOT[SLOT1] );
-            advance_eg_channel ( OPN, &cch[3]->SLOT[SLOT1] );
-        }
+            /* advance envelope generator */
+            OPN->eg_timer += OPN->eg_timer_add;
 
-        /* calculate FM */
-        chan_calc ( OPN, cch[0] ); /*remapped to 1*/
-        chan_calc ( OPN, cch[1] ); /*remapped to 2*/
-        chan_calc ( OPN, cch[2] ); /*remapped to 4*/
-        chan_calc ( OPN, cch[3] ); /*remapped to 5*/
+            while ( OPN->eg_timer >= OPN->eg_timer_overflow )
+            {
+                OPN->eg_timer -= OPN->eg_timer_overflow;
+                OPN->eg_cnt++;
+#if YM2610_FM_SIMD
+                fm_soa_advance_eg ( &fm_soa, OPN );
+#else
+                for ( Sint32 c = 0; c < 4; c++ )
+                {
+                    if ( fm_active[c] )
+                    {
+                        advance_eg_channel ( OPN, &cch[c]->SLOT[SLOT1] );
+                    }
+                }
+#endif
+            }
+
+            /* calculate FM */
+#if YM2610_FM_SIMD
+            fm_soa_calc ( &fm_soa, OPN );
+            out_fm[1] = fm_soa.out[0];
+            out_fm[2] = fm_soa.out[1];
+            out_fm[4] = fm_soa.out[2];
+            out_fm[5] = fm_soa.out[3];
+#else
+            /* remapped to 1, 2, 4 and 5 */
+            for ( Sint32 c = 0; c < 4; c++ )
+            {
+                if ( fm_active[c] )
+                {
+                    chan_calc ( OPN, cch[c] );
+                }
+            }
+#endif
+        }
 
         /* calculate SSG */
-        outn = SSG_CALC ( outn );
+        if ( ssg_on )
+        {
+            outn = SSG_CALC ( outn );
+        }
 
         /* deltaT ADPCM */
         if ( YM2610.adpcmb.portstate & 0x80 )
@@ -3407,6 +4004,65 @@ void YM2610Update_stream ( Sint32 length, Uint16* buffer )
         INTERNAL_TIMER_A ( OPN->ST, cch[1] );
     }
 
+#if YM2610_FM_SIMD
+    if ( fm_any )
+    {
+        fm_soa_store ( &fm_soa );
+    }
+#endif
+
+    INTERNAL_TIMER_B ( OPN->ST, length );
+}
+
+/* Advance one of the YM2610s by length samples without generating them */
+void YM2610Update_silent ( Sint32 length )
+{
+    FM_OPN* OPN = &YM2610.OPN;
+    FM_CH* cch[4];
+
+    if ( length <= 0 )
+    {
+        return;
+    }
+
+    cch[0] = &YM2610.CH[1];
+    cch[1] = &YM2610.CH[2];
+    cch[2] = &YM2610.CH[4];
+    cch[3] = &YM2610.CH[5];
+
+    refresh_fc_eg_channels ( OPN, cch );
+
+    /* @note (Tmesys#1#18/10/2026): Envelopes keep moving so that notes released meanwhile are over when sound comes back. */
+    OPN->lfo_cnt += OPN->lfo_inc * ( Uint32 ) ( length - 1 );
+    advance_lfo ( OPN );
+
+    OPN->eg_timer += OPN->eg_timer_add * ( Uint32 ) length;
+
+    while ( OPN->eg_timer >= OPN->eg_timer_overflow )
+    {
+        OPN->eg_timer -= OPN->eg_timer_overflow;
+        OPN->eg_cnt++;
+
+        for ( Sint32 c = 0; c < 4; c++ )
+        {
+            advance_eg_channel ( OPN, &cch[c]->SLOT[SLOT1] );
+        }
+    }
+
+    /* ADPCM end of sample flags are polled by sound drivers */
+    if ( YM2610.adpcmb.portstate & 0x80 )
+    {
+        OPNB_ADPCMB_skip ( &YM2610.adpcmb, length );
+    }
+
+    for ( Sint32 j = 0; j < 6; j++ )
+    {
+        if ( YM2610.adpcma[j].flag )
+        {
+            OPNB_ADPCMA_skip_chan ( &YM2610.adpcma[j], length );
+        }
+    }
+
     INTERNAL_TIMER_B ( OPN->ST, length );
 }
 
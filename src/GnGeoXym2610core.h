@@ -183,6 +183,42 @@ typedef struct
     Uint32 block_fnum; /* current blk/fnum value for this slot (can be different betweeen slots of one channel in 3slot mode) */
 } FM_CH;
 
+/* Working copy of the four YM2610 FM channels, operator state in structure-of-arrays form : [slot][channel] */
+typedef struct __attribute__ ( ( aligned ( 16 ) ) )
+{
+    Uint32 phase[4][4]; /* phase counter */
+    Sint32 Incr[4][4]; /* phase step */
+    Sint32 volume[4][4]; /* envelope counter */
+    Uint32 vol_out[4][4]; /* current output from EG circuit (without AM from LFO) */
+    Uint32 tl[4][4]; /* total level: TL << 3 */
+    Uint32 AMmask[4][4]; /* AM enable flag */
+    Uint32 negate[4][4]; /* SSG-EG output inversion (0 or 1023) */
+    Uint8 state[4][4]; /* phase type */
+    Uint8 ssgn[4][4]; /* SSG-EG negated output */
+    Uint32 snap_phase[4][4]; /* phase when loaded, to detect key on/off from the other side */
+    Uint8 snap_state[4][4]; /* state when loaded */
+    Uint8 snap_ssgn[4][4]; /* ssgn when loaded */
+    Sint32 op1_out[2][4]; /* op1 output for feedback */
+    Sint32 mem_value[4]; /* delayed sample (MEM) value */
+    Sint32 out[4]; /* channel output */
+    Uint32 ams[4]; /* channel AMS */
+    Uint32 fb[4]; /* feedback shift */
+    /* algorithm routing masks (0xffffffff = connected), derived from FM_CH connections */
+    Uint32 op1_to_c1[4];
+    Uint32 op1_to_c2[4];
+    Uint32 op1_to_mem[4];
+    Uint32 op1_to_out[4];
+    Uint32 mem_to_m2[4];
+    Uint32 mem_to_c2[4];
+    Uint32 mem_to_mem[4];
+    Uint32 op3_to_c2[4];
+    Uint32 op3_to_out[4];
+    Uint32 op2_to_mem[4];
+    Uint32 op2_to_out[4];
+    Uint32 pms; /* at least one channel uses LFO phase modulation */
+    FM_CH* CH[4]; /* channel configuration (read only while rendering) */
+} FM_SOA;
+
 typedef struct
 {
     Sint32 clock; /* master clock  (Hz)   */
@@ -351,5 +387,6 @@ void YM2610Write ( Sint32, Uint8 );
 Uint8 YM2610Read ( Sint32 ) __attribute__ ( ( warn_unused_result ) );
 void YM2610TimerOver ( Sint32 );
 void YM2610Update_stream ( Sint32, Uint16* );
+void YM2610Update_silent ( Sint32 );
 
 #endif // _GNGEOX_YM2610_CORE_H_
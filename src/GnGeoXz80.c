@@ -216,26 +216,26 @@ void z80_writeport16 ( Uint16 port, Uint8 value )
     /* Address A */
     case ( 0x4 ) :
         {
-            YM2610Write ( 0, value );
+            neo_ym2610_write ( 0, value );
         }
         break;
     /* Data A */
     /* IRQs are acknowledged by clearing reset flags in mode register */
     case ( 0x5 ) :
         {
-            YM2610Write ( 1, value );
+            neo_ym2610_write ( 1, value );
         }
         break;
     /* Address B */
     case ( 0x6 ) :
         {
-            YM2610Write ( 2, value );
+            neo_ym2610_write ( 2, value );
         }
         break;
     /* Data B */
     case ( 0x7 ) :
         {
-            YM2610Write ( 3, value );
+            neo_ym2610_write ( 3, value );
         }
         break;
     case ( 0x08 ) :
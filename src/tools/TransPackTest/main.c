@@ -0,0 +1,185 @@
+/*!
+*
+*   \file    main.c
+*   \brief   Transparency pack tile type table test.
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Checks the table built by neo_transpack_usage_init() against the range scan of neo_transpack_find()
+*            with the pen usage fallback, as the renderers used them. Random packs with overlapping ranges and every
+*            type code are tried, for tile counts that are and are not multiple of 16.
+*            Usage : TransPackTest [packs]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL2/SDL.h>
+#include "zlog.h"
+#include "qlibc.h"
+
+#include "GnGeoXtranspack.h"
+#include "GnGeoXconfig.h"
+
+#define TEST_PACK_RANGES 24
+
+struct_gngeoxconfig_params gngeox_config;
+
+extern struct_gngeoxtranspack_range* range_list;
+extern Uint32 range_list_size;
+
+static const Uint32 test_nb_of_tiles[] = { 0x1000, 0x1007, 0x100F, 5, 0x30, 0x3F };
+/* ******************************************************************************************************************/
+/*!
+* \brief  Sorts ranges by begin, like the pack query.
+*
+*/
+/* ******************************************************************************************************************/
+static int test_range_compare ( const void* a, const void* b )
+{
+    const struct_gngeoxtranspack_range* left = a;
+    const struct_gngeoxtranspack_range* right = b;
+
+    return ( ( left->begin > right->begin ) - ( left->begin < right->begin ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Tile type as the renderers found it before the table.
+*
+* \param  spr_usage Sprites pen usage.
+* \param  tile Tile number.
+* \return Tile type.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_reference ( const Uint32* spr_usage, Uint32 tile )
+{
+    Uint32 type = neo_transpack_find ( tile );
+
+    if ( type == TILE_TRANS_UNKNOWN )
+    {
+        return ( ( spr_usage[tile >> 4] >> ( ( tile & 0xF ) * 2 ) ) & 0x3 );
+    }
+
+    /* Other codes than the drawing ones are not drawn */
+    return ( ( type > TILE_TRANS_UNKNOWN ) ? TILE_INVISIBLE : type );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Builds a random pack and pen usage, then compares every tile.
+*
+* \param  nb_of_tiles Number of sprite tiles.
+* \return Number of tiles that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_pack ( Uint32 nb_of_tiles )
+{
+    struct_gngeoxtranspack_range ranges[TEST_PACK_RANGES];
+    Uint32 words = ( nb_of_tiles + 15 ) >> 4;
+    Uint32* spr_usage = NULL;
+    Uint32 errors = 0;
+
+    spr_usage = ( Uint32* ) calloc ( words, sizeof ( Uint32 ) );
+    if ( spr_usage == NULL )
+    {
+        printf ( "Memory allocation fail\n" );
+        return ( 1 );
+    }
+
+    /* Tiles past the last one stay normal, like the converter leaves them */
+    for ( Uint32 tile = 0; tile < nb_of_tiles; tile++ )
+    {
+        spr_usage[tile >> 4] |= ( Uint32 ) ( rand() & 0x3 ) << ( ( tile & 0xF ) * 2 );
+    }
+
+    range_list_size = 1 + rand() % TEST_PACK_RANGES;
+
+    for ( Uint32 loop = 0; loop < range_list_size; loop++ )
+    {
+        /* Some ranges run past the last tile */
+        ranges[loop].begin = rand() % ( nb_of_tiles + 16 );
+        ranges[loop].end = ranges[loop].begin + rand() % ( ( nb_of_tiles >> 3 ) + 2 );
+        ranges[loop].type = rand() % ( TILE_TRANS_MAX + 2 );
+    }
+
+    qsort ( ranges, range_list_size, sizeof ( ranges[0] ), test_range_compare );
+    range_list = ranges;
+
+    if ( neo_transpack_usage_init ( spr_usage, nb_of_tiles ) == SDL_FALSE )
+    {
+        printf ( "Unable to build the table for %u tiles\n", nb_of_tiles );
+        range_list = NULL;
+        free ( spr_usage );
+        return ( 1 );
+    }
+
+    for ( Uint32 tile = 0; tile < nb_of_tiles; tile++ )
+    {
+        Uint32 expected = test_reference ( spr_usage, tile );
+
+        if ( TILE_USAGE ( tile ) != expected )
+        {
+            if ( errors == 0 )
+            {
+                printf ( "%u tiles : tile 0x%X is %u instead of %u\n", nb_of_tiles, tile, TILE_USAGE ( tile ), expected );
+            }
+
+            errors++;
+        }
+    }
+
+    /* Ranges belong to the test, not to the pack */
+    range_list = NULL;
+    range_list_size = 0;
+
+    if ( neo_transpack_usage_init ( spr_usage, nb_of_tiles ) == SDL_FALSE )
+    {
+        errors++;
+    }
+
+    free ( spr_usage );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Entry point.
+*
+*/
+/* ******************************************************************************************************************/
+int main ( int argc, char* argv[] )
+{
+    Uint32 packs = 200;
+    Uint32 errors = 0;
+
+    if ( argc > 1 )
+    {
+        packs = strtoul ( argv[1], NULL, 10 );
+    }
+
+    if ( qalloc_init ( ) == false )
+    {
+        return ( EXIT_FAILURE );
+    }
+
+    SDL_zero ( gngeox_config );
+    gngeox_config.transpack = SDL_TRUE;
+    srand ( 1 );
+
+    for ( Uint32 count = 0; count < SDL_arraysize ( test_nb_of_tiles ); count++ )
+    {
+        Uint32 failed = 0;
+
+        for ( Uint32 pack = 0; pack < packs; pack++ )
+        {
+            failed += ( test_pack ( test_nb_of_tiles[count] ) != 0 ) ? 1 : 0;
+        }
+
+        printf ( "%u tiles : %u/%u packs %s\n", test_nb_of_tiles[count], packs - failed, packs, ( failed == 0 ) ? "OK" : "FAILED" );
+        errors += failed;
+    }
+
+    qalloc_exit ( );
+
+    return ( ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
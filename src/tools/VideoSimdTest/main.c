@@ -0,0 +1,855 @@
+/*!
+*
+*   \file    main.c
+*   \brief   Vectorized sprite rows and frame blending against the scalar code.
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Draws random tiles with both renderers, every x and y zoom, both flips and the three drawing modes,
+*            once with the scalar template and once with each kernel set the CPU has (AVX2, SSE4.1 or NEON),
+*            then checks that the frames are bit identical, with and without the tile rows masks.
+*            Also checks alpha_blend() against the division by 255 it replaced, for every color component,
+*            and each blend row kernel against it on random rows of random widths.
+*            Mask row kernels, used by the cached fix layer, are checked against the scalar loop the same way.
+*            Palette indexes kernels are checked against the scalar code the same way, as each kernel set selects them,
+*            and lines of more than SPRITES_PER_LINE slivers drawn like the line buffer does are checked against the
+*            scanline renderer drawing the first SPRITES_PER_LINE ones.
+*            Usage : VideoSimdTest [draws]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL2/SDL.h>
+#include "zlog.h"
+#include "qlibc.h"
+
+#include "GnGeoXroms.h"
+#include "GnGeoXvideo.h"
+#include "GnGeoXmemory.h"
+#include "GnGeoXconfig.h"
+#include "GnGeoXvideosimd.h"
+
+/* Kernels are static, each set is picked here whatever the running CPU prefers */
+#include "GnGeoXvideosimd.c"
+
+#define TEST_TILES 512
+#define TEST_WIDTH 352
+#define TEST_PITCH ( TEST_WIDTH + 29 )
+#define TEST_HEIGHT 256
+#define TEST_BLEND_WIDTH 400
+#define TEST_LINE_SPRITES ( SPRITES_PER_LINE + 24 )
+
+typedef struct
+{
+    const char* name;
+    SDL_bool available;
+    tile_rows_kernel rows[TILE_ROWS_MAX];
+    blend_row_kernel blend;
+    index_rows_kernel index_rows;
+    index_row_kernel index_row;
+    mask_row_kernel mask;
+} struct_videosimdtest_kernels;
+
+typedef struct
+{
+    Uint32 tileno;
+    Sint32 yoffs;
+    Sint32 sx;      /* Strip x position, -16 to 320 */
+    Sint32 zx;
+    Sint32 color;
+    Sint32 xflip;
+    Sint32 visible;
+} struct_videosimdtest_sliver;
+
+struct_gngeoxconfig_params gngeox_config;
+struct_gngeoxmemory_neogeo neogeo_memory;
+Uint32* current_pc_pal = NULL;
+SDL_Surface* sdl_surface_buffer = NULL;
+
+/* Same as the video tables */
+static char ddaxskip[16][16] =
+{
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+    { 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+    { 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0},
+    { 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0},
+    { 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1, 0},
+    { 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0},
+    { 0, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0},
+    { 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0},
+    { 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0},
+    { 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0},
+    { 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1},
+    { 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1},
+    { 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1},
+    { 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 1},
+    { 1, 1, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+    { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}
+};
+static char* dda_x_skip = NULL;
+static const char* dda_y_skip = NULL;
+static char full_y_skip[16] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+static Uint8* test_tiles = NULL;
+static Uint32* test_frames[2] = { NULL, NULL };
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gives a tile data, no sprite cache here.
+*
+*/
+/* ******************************************************************************************************************/
+static const Uint8* sprite_tile_data ( Uint32 tileno )
+{
+    return ( &test_tiles[( tileno % TEST_TILES ) << 7] );
+}
+
+#define RENAME(name) name##_tile
+#define ROWSMODE TILE_ROWS_OPAQUE
+#define PUTPIXEL(dst,src) dst=src
+#include "GnGeoXvideotemplate.h"
+#define RENAME(name) name##_tile_50
+#define ROWSMODE TILE_ROWS_BLEND50
+#define PUTPIXEL(dst,src) dst=BLEND16_50(src,dst)
+#include "GnGeoXvideotemplate.h"
+#define RENAME(name) name##_tile_25
+#define ROWSMODE TILE_ROWS_BLEND25
+#define PUTPIXEL(dst,src) dst=BLEND16_25(src,dst)
+#include "GnGeoXvideotemplate.h"
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gives a random 32 bits value.
+*
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_random ( void )
+{
+    return ( ( ( Uint32 ) rand() << 16 ) ^ ( Uint32 ) rand() );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gives a random y zoom, as computed by yzoom_value_init().
+*
+* \param  y_skip Rows to skip before each drawn row.
+* \return Number of drawn rows, zero when none.
+*/
+/* ******************************************************************************************************************/
+static Sint32 test_y_skip ( char y_skip[17] )
+{
+    Sint32 rzy = rand() % 256;
+    Sint32 dday = ( rand() % YZOOM_PHASES ) << 4;
+    Sint32 zy = 0;
+
+    memset ( y_skip, 0, 17 );
+
+    for ( Uint32 i = 0; i < 16; i++ )
+    {
+        dday -= ( rzy + 1 );
+
+        if ( dday <= 0 )
+        {
+            dday += 256;
+            zy++;
+        }
+
+        y_skip[zy]++;
+    }
+
+    return ( zy );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Builds random tiles, with empty, opaque and mixed rows, and their rows masks.
+*
+*/
+/* ******************************************************************************************************************/
+static void test_tiles_init ( Uint32* rows_masks )
+{
+    for ( Uint32 tile = 0; tile < TEST_TILES; tile++ )
+    {
+        Uint32* gfxdata = ( Uint32* ) &test_tiles[tile << 7];
+
+        rows_masks[tile] = 0;
+
+        for ( Uint32 row = 0; row < 16; row++ )
+        {
+            Uint32 kind = rand() % 4;
+            Uint32 opaque = 1;
+
+            for ( Uint32 half = 0; half < 2; half++ )
+            {
+                Uint32 word = 0;
+
+                for ( Uint32 pen = 0; pen < 8; pen++ )
+                {
+                    Uint32 value = ( kind == 0 ) ? 0 : ( kind == 1 ) ? 1 + rand() % 15 : rand() % 16;
+
+                    opaque &= ( value != 0 );
+                    word |= value << ( pen * 4 );
+                }
+
+                gfxdata[( row << 1 ) + half] = word;
+            }
+
+            if ( ( gfxdata[row << 1] | gfxdata[( row << 1 ) + 1] ) == 0 )
+            {
+                rows_masks[tile] |= ( Uint32 ) TILE_ROW_EMPTY << row;
+            }
+            else if ( opaque )
+            {
+                rows_masks[tile] |= ( Uint32 ) TILE_ROW_OPAQUE << row;
+            }
+        }
+    }
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Applies alpha transparency with divisions, as before DIV255().
+*
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_alpha_blend ( Uint32 dest, Uint32 src, Uint8 alpha )
+{
+    Uint32 beta = ( 255 - alpha );
+    Uint32 or = ( ( COLOR_RGB24_R ( src ) * alpha ) + ( COLOR_RGB24_R ( dest ) * beta ) ) / 255;
+    Uint32 og = ( ( COLOR_RGB24_G ( src ) * alpha ) + ( COLOR_RGB24_G ( dest ) * beta ) ) / 255;
+    Uint32 ob = ( ( COLOR_RGB24_B ( src ) * alpha ) + ( COLOR_RGB24_B ( dest ) * beta ) ) / 255;
+
+    return ( COLOR_RGB24_MAKE ( alpha, or, og, ob ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Checks DIV255() and alpha_blend() against divisions, for every value they can get.
+*
+* \return Number of values that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_alpha ( void )
+{
+    const Uint8 alphas[2] = { 127, 63 };
+    Uint32 errors = 0;
+
+    for ( Uint32 value = 0; value <= 255 * 255; value++ )
+    {
+        if ( DIV255 ( value ) != value / 255 )
+        {
+            printf ( "DIV255 ( %u ) is %u instead of %u\n", value, DIV255 ( value ), value / 255 );
+            errors++;
+        }
+    }
+
+    for ( Uint32 loop = 0; loop < 2; loop++ )
+    {
+        for ( Uint32 dest = 0; dest < 256; dest++ )
+        {
+            for ( Uint32 src = 0; src < 256; src++ )
+            {
+                /* Each component gets other values */
+                Uint32 dest_rgb = ( dest << 16 ) | ( ( 255 - dest ) << 8 ) | ( src ^ 0x5A );
+                Uint32 src_rgb = ( src << 16 ) | ( ( 255 - src ) << 8 ) | ( dest ^ 0xA5 );
+
+                if ( alpha_blend ( dest_rgb, src_rgb, alphas[loop] ) != test_alpha_blend ( dest_rgb, src_rgb, alphas[loop] ) )
+                {
+                    errors++;
+                }
+            }
+        }
+    }
+
+    printf ( "alpha_blend : %s\n", ( errors == 0 ) ? "identical" : "FAILED" );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Blends random rows with a kernel and with alpha_blend(), then compares them.
+*
+* \param  name Kernel name.
+* \param  blend Blend row kernel, NULL for neo_video_simd_blend_row().
+* \param  rows Number of rows.
+* \return Number of rows that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_blend ( const char* name, blend_row_kernel blend, Uint32 rows )
+{
+    static Uint32 expected[TEST_BLEND_WIDTH + 1], result[TEST_BLEND_WIDTH + 1], src[TEST_BLEND_WIDTH];
+    Uint32 errors = 0;
+
+    for ( Uint32 row = 0; row < rows; row++ )
+    {
+        Uint32 width = 1 + rand() % TEST_BLEND_WIDTH;
+        Sint32 alpha = ( row & 1 ) ? 127 : 63;
+
+        for ( Uint32 pixel = 0; pixel <= width; pixel++ )
+        {
+            expected[pixel] = result[pixel] = test_random();
+            src[pixel % TEST_BLEND_WIDTH] = test_random();
+        }
+
+        for ( Uint32 pixel = 0; pixel < width; pixel++ )
+        {
+            expected[pixel] = test_alpha_blend ( expected[pixel], src[pixel], alpha );
+        }
+
+        if ( blend != NULL )
+        {
+            blend ( result, src, width, alpha );
+        }
+        else
+        {
+            neo_video_simd_blend_row ( result, src, width, alpha );
+        }
+
+        /* The pixel after the row must stay untouched */
+        if ( memcmp ( expected, result, ( width + 1 ) * sizeof ( Uint32 ) ) != 0 )
+        {
+            errors++;
+        }
+    }
+
+    printf ( "%s blend : %u rows %s\n", name, rows, ( errors == 0 ) ? "identical" : "FAILED" );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Copies the opaque pixels of random rows with a kernel and with a loop, then compares them.
+*
+* \param  name Kernel name.
+* \param  mask Mask row kernel, NULL for the scalar code of neo_video_simd_mask_row().
+* \param  rows Number of rows.
+* \return Number of rows that differ.
+* \note   Top bits are random, so about half the pixels get copied, with their top byte cleared.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_mask ( const char* name, mask_row_kernel mask, Uint32 rows )
+{
+    static Uint32 expected[TEST_BLEND_WIDTH + 1], result[TEST_BLEND_WIDTH + 1], src[TEST_BLEND_WIDTH];
+    Uint32 errors = 0;
+
+    mask_row = mask;
+
+    for ( Uint32 row = 0; row < rows; row++ )
+    {
+        Uint32 width = 1 + rand() % TEST_BLEND_WIDTH;
+
+        for ( Uint32 pixel = 0; pixel <= width; pixel++ )
+        {
+            expected[pixel] = result[pixel] = test_random();
+            src[pixel % TEST_BLEND_WIDTH] = test_random() ^ ( ( Uint32 ) rand() << 24 );
+        }
+
+        for ( Uint32 pixel = 0; pixel < width; pixel++ )
+        {
+            if ( src[pixel] & 0x80000000 )
+            {
+                expected[pixel] = src[pixel] & 0x00FFFFFF;
+            }
+        }
+
+        neo_video_simd_mask_row ( result, src, width );
+
+        /* The pixel after the row must stay untouched */
+        if ( memcmp ( expected, result, ( width + 1 ) * sizeof ( Uint32 ) ) != 0 )
+        {
+            errors++;
+        }
+    }
+
+    printf ( "%s mask : %u rows %s\n", name, rows, ( errors == 0 ) ? "identical" : "FAILED" );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws the same random tiles with the scalar template and with a kernel set, then compares the frames.
+*
+* \param  kernels Kernel set.
+* \param  draws Number of tiles drawn.
+* \return Number of frames that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_rows ( const struct_videosimdtest_kernels* kernels, Uint32 draws )
+{
+    Uint32 errors = 0;
+    Uint32 seed = test_random();
+
+    for ( Uint32 frame = 0; frame < 2; frame++ )
+    {
+        Uint32 pixel = 0;
+
+        srand ( seed );
+
+        for ( pixel = 0; pixel < TEST_PITCH * TEST_HEIGHT; pixel++ )
+        {
+            test_frames[frame][pixel] = test_random();
+        }
+
+        for ( Sint32 mode = 0; mode < TILE_ROWS_MAX; mode++ )
+        {
+            neo_video_simd_rows[mode] = ( frame == 0 ) ? NULL : kernels->rows[mode];
+        }
+
+        for ( Uint32 draw = 0; draw < draws; draw++ )
+        {
+            Uint32 tileno = test_random() % TEST_TILES;
+            Sint32 mode = rand() % TILE_ROWS_MAX;
+            Sint32 color = rand() % 256;
+            Sint32 xflip = rand() & 1;
+            Sint32 sx = rand() % ( TEST_WIDTH - 16 );
+            Uint8* bmp = ( Uint8* ) test_frames[frame];
+
+            if ( rand() & 1 )
+            {
+                /* Whole tile */
+                Sint32 zx = 1 + rand() % 16;
+                static char y_skip[17];
+                Sint32 zy = test_y_skip ( y_skip );
+                Sint32 sy = rand() % ( TEST_HEIGHT - 16 );
+                Sint32 yflip = rand() & 1;
+
+                if ( zy == 0 )
+                {
+                    continue;
+                }
+
+                dda_y_skip = y_skip;
+                dda_x_skip = ddaxskip[zx - 1];
+
+                switch ( mode )
+                {
+                case ( TILE_ROWS_OPAQUE ) :
+                    {
+                        draw_tile ( tileno, sx, sy, zx, zy, color, xflip, yflip, bmp );
+                    }
+                    break;
+                case ( TILE_ROWS_BLEND50 ) :
+                    {
+                        draw_tile_50 ( tileno, sx, sy, zx, zy, color, xflip, yflip, bmp );
+                    }
+                    break;
+                case ( TILE_ROWS_BLEND25 ) :
+                case ( TILE_ROWS_MAX ) :
+                default :
+                    {
+                        draw_tile_25 ( tileno, sx, sy, zx, zy, color, xflip, yflip, bmp );
+                    }
+                    break;
+                }
+            }
+            else
+            {
+                /* One line of a tile, zoom 16 draws the 16 pixels too */
+                Sint32 zx = rand() % 17;
+                Sint32 yoffs = rand() % 16;
+                Sint32 line = rand() % TEST_HEIGHT;
+
+                dda_x_skip = ddaxskip[SDL_min ( zx, 15 )];
+
+                switch ( mode )
+                {
+                case ( TILE_ROWS_OPAQUE ) :
+                    {
+                        draw_scanline_tile ( tileno, yoffs, sx, line, zx, color, xflip, bmp );
+                    }
+                    break;
+                case ( TILE_ROWS_BLEND50 ) :
+                    {
+                        draw_scanline_tile_50 ( tileno, yoffs, sx, line, zx, color, xflip, bmp );
+                    }
+                    break;
+                case ( TILE_ROWS_BLEND25 ) :
+                case ( TILE_ROWS_MAX ) :
+                default :
+                    {
+                        draw_scanline_tile_25 ( tileno, yoffs, sx, line, zx, color, xflip, bmp );
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    for ( Uint32 pixel = 0; pixel < TEST_PITCH * TEST_HEIGHT; pixel++ )
+    {
+        if ( test_frames[0][pixel] != test_frames[1][pixel] )
+        {
+            printf ( "%s : pixel %u, %u is %08X instead of %08X\n", kernels->name, pixel % TEST_PITCH, pixel / TEST_PITCH,
+                     test_frames[1][pixel], test_frames[0][pixel] );
+            errors++;
+            break;
+        }
+    }
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws the same random tiles as palette indexes with the scalar code and with a kernel set, then compares them.
+*
+* \param  kernels Kernel set.
+* \param  rows_masks Tiles rows masks, NULL when there is no table.
+* \param  draws Number of tiles drawn.
+* \return Number of buffers that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_index_rows ( const struct_videosimdtest_kernels* kernels, const Uint32* rows_masks, Uint32 draws )
+{
+    /* Indexes buffers fit in the frames */
+    Uint16* buffers[2] = { ( Uint16* ) test_frames[0], ( Uint16* ) test_frames[1] };
+
+    for ( Uint32 pixel = 0; pixel < TEST_PITCH * TEST_HEIGHT; pixel++ )
+    {
+        buffers[0][pixel] = buffers[1][pixel] = test_random() & 0xFFF;
+    }
+
+    neo_video_simd_index_rows = kernels->index_rows;
+
+    for ( Uint32 draw = 0; draw < draws; draw++ )
+    {
+        Uint32 tileno = test_random() % TEST_TILES;
+        const Uint32* gfxdata = ( const Uint32* ) sprite_tile_data ( tileno );
+        Uint32 masks = ( rows_masks != NULL ) ? rows_masks[tileno] : 0;
+        Uint16 base = ( rand() % 256 ) << 4;
+        Sint32 xflip = rand() & 1;
+        Sint32 zoom = draw % 16;
+        Sint32 offset = rand() % ( TEST_WIDTH - 16 );
+        static char y_skip[17];
+        const char* skip = y_skip;
+        Sint32 rows = 0, step = 0;
+
+        if ( rand() & 1 )
+        {
+            /* Whole tile, bottom up when flipped like the band renderer */
+            Sint32 sy = rand() % ( TEST_HEIGHT - 16 );
+
+            rows = test_y_skip ( y_skip );
+
+            if ( rand() & 1 )
+            {
+                offset += ( sy + rows - 1 ) * TEST_PITCH;
+                step = -TEST_PITCH;
+            }
+            else
+            {
+                offset += sy * TEST_PITCH;
+                step = TEST_PITCH;
+            }
+        }
+        else
+        {
+            /* One tile row, like the line buffer */
+            Sint32 yoffs = rand() % 16;
+
+            offset += ( rand() % TEST_HEIGHT ) * TEST_PITCH;
+            gfxdata += yoffs << 1;
+            masks = TILE_ROWS_FROM ( masks, yoffs );
+            skip = neo_video_simd_no_skip;
+            rows = 1;
+        }
+
+        index_rows_scalar ( &buffers[0][offset], step, gfxdata, skip, rows, base, xflip, zoom, masks );
+        neo_video_simd_index_rows ( &buffers[1][offset], step, gfxdata, skip, rows, base, xflip, zoom, masks );
+    }
+
+    for ( Uint32 pixel = 0; pixel < TEST_PITCH * TEST_HEIGHT; pixel++ )
+    {
+        if ( buffers[0][pixel] != buffers[1][pixel] )
+        {
+            printf ( "%s indexes : pixel %u, %u is %03X instead of %03X\n", kernels->name, pixel % TEST_PITCH,
+                     pixel / TEST_PITCH, buffers[1][pixel], buffers[0][pixel] );
+            return ( 1 );
+        }
+    }
+
+    return ( 0 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Converts random rows of palette indexes with a kernel set and with the palette, then compares them.
+*
+* \param  kernels Kernel set.
+* \param  palette Palette colors.
+* \param  rows Number of rows.
+* \return Number of rows that differ.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_index_row ( const struct_videosimdtest_kernels* kernels, const Uint32* palette, Uint32 rows )
+{
+    static Uint32 expected[TEST_BLEND_WIDTH + 1], result[TEST_BLEND_WIDTH + 1];
+    static Uint16 src[TEST_BLEND_WIDTH];
+    Uint32 errors = 0;
+
+    /* NULL for the palette loop of neo_video_simd_index_row() */
+    index_row = kernels->index_row;
+
+    for ( Uint32 row = 0; row < rows; row++ )
+    {
+        Uint32 width = 1 + rand() % TEST_BLEND_WIDTH;
+
+        for ( Uint32 pixel = 0; pixel <= width; pixel++ )
+        {
+            expected[pixel] = result[pixel] = test_random();
+            src[pixel % TEST_BLEND_WIDTH] = test_random() & 0xFFF;
+        }
+
+        for ( Uint32 pixel = 0; pixel < width; pixel++ )
+        {
+            expected[pixel] = palette[src[pixel]];
+        }
+
+        neo_video_simd_index_row ( result, src, width, palette );
+
+        /* The pixel after the row must stay untouched */
+        if ( memcmp ( expected, result, ( width + 1 ) * sizeof ( Uint32 ) ) != 0 )
+        {
+            errors++;
+        }
+    }
+
+    printf ( "%s index row : %u rows %s\n", kernels->name, rows, ( errors == 0 ) ? "identical" : "FAILED" );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Draws random lines of too many slivers in a line buffer, then compares them with the scanline renderer.
+*
+* \param  kernels Kernel set.
+* \param  rows_masks Tiles rows masks, also without the table.
+* \param  lines Number of lines.
+* \return Number of lines that differ.
+* \note   Slivers are drawn with the calls of draw_line(), invisible ones count in the limit. The slivers past the
+*         limit are opaque and full width, so any of them drawn shows.
+*/
+/* ******************************************************************************************************************/
+static Uint32 test_line ( const struct_videosimdtest_kernels* kernels, const Uint32* rows_masks, Uint32 lines )
+{
+    static struct_videosimdtest_sliver slivers[TEST_LINE_SPRITES];
+    static Uint16 line_buffer[TEST_WIDTH];
+    static Uint32 result[TEST_WIDTH + 1];
+    Uint32* expected = test_frames[0];
+    Uint32 errors = 0;
+
+    neo_video_simd_index_rows = kernels->index_rows;
+    index_row = kernels->index_row;
+
+    for ( Uint32 line = 0; line < lines; line++ )
+    {
+        Sint32 sprites = 0;
+
+        for ( Sint32 index = 0; index < TEST_LINE_SPRITES; index++ )
+        {
+            struct_videosimdtest_sliver* sliver = &slivers[index];
+
+            sliver->tileno = test_random() % TEST_TILES;
+            sliver->yoffs = rand() % 16;
+            sliver->sx = -16 + rand() % 337;
+            sliver->zx = rand() % 16;
+            sliver->color = rand() % 256;
+            sliver->xflip = rand() & 1;
+            sliver->visible = ( rand() % 8 ) != 0;
+
+            if ( index >= SPRITES_PER_LINE )
+            {
+                while ( ( ( rows_masks[sliver->tileno] >> sliver->yoffs ) & TILE_ROW_OPAQUE ) == 0 )
+                {
+                    sliver->tileno = test_random() % TEST_TILES;
+                    sliver->yoffs = rand() % 16;
+                }
+
+                sliver->zx = 15;
+                sliver->visible = 1;
+            }
+        }
+
+        /* Line buffer */
+        for ( Uint32 pixel = 0; pixel < TEST_WIDTH; pixel++ )
+        {
+            line_buffer[pixel] = 4095;
+        }
+
+        for ( Sint32 index = 0; ( index < TEST_LINE_SPRITES ) && ( sprites < SPRITES_PER_LINE ); index++ )
+        {
+            const struct_videosimdtest_sliver* sliver = &slivers[index];
+
+            sprites++;
+
+            if ( !sliver->visible )
+            {
+                continue;
+            }
+
+            neo_video_simd_index_rows ( &line_buffer[sliver->sx + 16], 0,
+                                        ( const Uint32* ) sprite_tile_data ( sliver->tileno ) + ( sliver->yoffs << 1 ),
+                                        neo_video_simd_no_skip, 1, sliver->color << 4, sliver->xflip, sliver->zx,
+                                        TILE_ROWS_FROM ( TILE_ROWS ( sliver->tileno ), sliver->yoffs ) );
+        }
+
+        result[TEST_WIDTH] = expected[TEST_WIDTH] = test_random();
+        neo_video_simd_index_row ( result, line_buffer, TEST_WIDTH, current_pc_pal );
+
+        /* Scanline renderer, scalar, first slivers only */
+        for ( Sint32 mode = 0; mode < TILE_ROWS_MAX; mode++ )
+        {
+            neo_video_simd_rows[mode] = NULL;
+        }
+
+        for ( Uint32 pixel = 0; pixel < TEST_WIDTH; pixel++ )
+        {
+            expected[pixel] = current_pc_pal[4095];
+        }
+
+        for ( Sint32 index = 0; index < SPRITES_PER_LINE; index++ )
+        {
+            const struct_videosimdtest_sliver* sliver = &slivers[index];
+
+            if ( !sliver->visible )
+            {
+                continue;
+            }
+
+            dda_x_skip = ddaxskip[sliver->zx];
+            draw_scanline_tile ( sliver->tileno, sliver->yoffs, sliver->sx + 16, 0, sliver->zx, sliver->color,
+                                 sliver->xflip, ( Uint8* ) expected );
+        }
+
+        /* The pixel after the line must stay untouched */
+        if ( memcmp ( expected, result, ( TEST_WIDTH + 1 ) * sizeof ( Uint32 ) ) != 0 )
+        {
+            errors++;
+        }
+    }
+
+    printf ( "%s line buffer, %s masks : %u lines of %u slivers %s\n", kernels->name,
+             ( neogeo_memory.rom.spr_rows.p == NULL ) ? "without" : "with", lines, TEST_LINE_SPRITES,
+             ( errors == 0 ) ? "identical" : "FAILED" );
+
+    return ( errors );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Entry point.
+*
+*/
+/* ******************************************************************************************************************/
+int main ( int argc, char* argv[] )
+{
+    struct_videosimdtest_kernels kernels[] =
+    {
+#ifdef VIDEO_SIMD_X86
+        {
+            "AVX2", SDL_FALSE, { tile_rows_avx2_opaque, tile_rows_avx2_blend50, tile_rows_avx2_blend25 }, blend_row_avx2,
+            index_rows_sse41, index_row_avx2, mask_row_avx2
+        },
+        {
+            "SSE4.1", SDL_FALSE, { tile_rows_sse41_opaque, tile_rows_sse41_blend50, tile_rows_sse41_blend25 }, blend_row_sse41,
+            index_rows_sse41, NULL, mask_row_sse41
+        },
+#endif // VIDEO_SIMD_X86
+#ifdef VIDEO_SIMD_NEON
+        {
+            "NEON", SDL_TRUE, { tile_rows_neon_opaque, tile_rows_neon_blend50, tile_rows_neon_blend25 }, blend_row_neon,
+            index_rows_scalar, NULL, mask_row_neon
+        },
+#endif // VIDEO_SIMD_NEON
+        { NULL, SDL_FALSE, { NULL, NULL, NULL }, NULL, NULL, NULL, NULL }
+    };
+    static SDL_Surface surface;
+    static Uint32 rows_masks[TEST_TILES];
+    static Uint32 palette[4096];
+    Uint32 draws = 100000;
+    Uint32 errors = 0, tested = 0;
+
+    if ( argc > 1 )
+    {
+        draws = strtoul ( argv[1], NULL, 10 );
+    }
+
+    SDL_zero ( gngeox_config );
+    SDL_zero ( neogeo_memory );
+    srand ( 1 );
+
+#ifdef VIDEO_SIMD_X86
+    __builtin_cpu_init();
+    kernels[0].available = __builtin_cpu_supports ( "avx2" ) ? SDL_TRUE : SDL_FALSE;
+    kernels[1].available = __builtin_cpu_supports ( "sse4.1" ) ? SDL_TRUE : SDL_FALSE;
+#endif // VIDEO_SIMD_X86
+
+    test_tiles = ( Uint8* ) malloc ( TEST_TILES << 7 );
+    test_frames[0] = ( Uint32* ) malloc ( TEST_PITCH * TEST_HEIGHT * sizeof ( Uint32 ) );
+    test_frames[1] = ( Uint32* ) malloc ( TEST_PITCH * TEST_HEIGHT * sizeof ( Uint32 ) );
+
+    if ( ( test_tiles == NULL ) || ( test_frames[0] == NULL ) || ( test_frames[1] == NULL ) )
+    {
+        printf ( "Memory allocation fail\n" );
+        return ( EXIT_FAILURE );
+    }
+
+    /* Sets the zoom patterns up, kernels are picked below */
+    neo_video_simd_init ( ( const char ( * ) [16] ) ddaxskip );
+
+    test_tiles_init ( rows_masks );
+
+    for ( Uint32 color = 0; color < 4096; color++ )
+    {
+        palette[color] = test_random() & 0x00FFFFFF;
+    }
+
+    current_pc_pal = palette;
+    surface.pitch = TEST_PITCH * sizeof ( Uint32 );
+    sdl_surface_buffer = &surface;
+    neogeo_memory.nb_of_tiles = TEST_TILES;
+
+    errors += test_alpha();
+
+    /* Scalar fallback of the frame blend */
+    blend_row = NULL;
+    errors += test_blend ( "Scalar", NULL, draws / 10 );
+    errors += test_mask ( "Scalar", NULL, draws / 10 );
+
+    for ( Uint32 set = 0; kernels[set].name != NULL; set++ )
+    {
+        if ( kernels[set].available == SDL_FALSE )
+        {
+            printf ( "%s : not supported by this CPU\n", kernels[set].name );
+            continue;
+        }
+
+        errors += test_blend ( kernels[set].name, kernels[set].blend, draws / 10 );
+        errors += test_index_row ( &kernels[set], palette, draws / 10 );
+        errors += test_mask ( kernels[set].name, kernels[set].mask, draws / 10 );
+
+        for ( Uint32 masks = 0; masks < 2; masks++ )
+        {
+            Uint32 failed = 0;
+
+            /* Without the table, kernels test every row themselves */
+            neogeo_memory.rom.spr_rows.p = ( masks == 0 ) ? NULL : ( Uint8* ) rows_masks;
+
+            failed = test_rows ( &kernels[set], draws );
+            printf ( "%s rows, %s masks : %u draws %s\n", kernels[set].name, ( masks == 0 ) ? "without" : "with", draws,
+                     ( failed == 0 ) ? "identical" : "FAILED" );
+            errors += failed;
+
+            failed = test_index_rows ( &kernels[set], ( masks == 0 ) ? NULL : rows_masks, draws );
+            printf ( "%s index rows, %s masks : %u draws %s\n", kernels[set].name, ( masks == 0 ) ? "without" : "with",
+                     draws, ( failed == 0 ) ? "identical" : "FAILED" );
+            errors += failed;
+            errors += test_line ( &kernels[set], rows_masks, draws / 100 );
+            tested++;
+        }
+    }
+
+    free ( test_tiles );
+    free ( test_frames[0] );
+    free ( test_frames[1] );
+
+    if ( tested == 0 )
+    {
+        printf ( "No vectorized kernel to test\n" );
+    }
+
+    return ( ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,41 @@
+#!/bin/sh
+# Checks that the SSE2/AVX2 FM path of the YM2610 core produces the same samples as the scalar reference path.
+# Usage : ./compare.sh file.vgm [file.vgm ...]
+# Logs are written by GnGeoX in the saves directory with soundlog=1.
+# Every log is replayed at several rates by three builds of YmReplay, whose checksums cover every produced sample.
+
+if [ $# -lt 1 ]; then
+    echo "Usage : $0 file.vgm [file.vgm ...]"
+    exit 1
+fi
+
+CC=${CC:-gcc}
+FLAGS="-O2 -m64 -I../.. -I../../3rdParty/Zlog-1.2.12/src $CFLAGS"
+SOURCES="main.c ../../GnGeoXym2610core.c"
+
+$CC $FLAGS -march=native $SOURCES -o YmReplaySimd -lm || exit 1
+$CC $FLAGS -march=x86-64 $SOURCES -o YmReplaySse2 -lm || exit 1
+$CC $FLAGS -march=native -DYM2610_FM_SCALAR $SOURCES -o YmReplayScalar -lm || exit 1
+
+status=0
+
+for vgm in "$@"; do
+    for rate in 55555 44100 22050; do
+        scalar=$(./YmReplayScalar "$vgm" $rate | grep Checksum)
+
+        for simd in YmReplaySimd YmReplaySse2; do
+            result=$(./$simd "$vgm" $rate | grep Checksum)
+
+            if [ -z "$scalar" ] || [ "$result" != "$scalar" ]; then
+                echo "$vgm at $rate Hz : $simd differs from the scalar path ($result / $scalar)"
+                status=1
+            else
+                echo "$vgm at $rate Hz : $simd identical ($result)"
+            fi
+        done
+    done
+done
+
+rm -f YmReplaySimd YmReplaySse2 YmReplayScalar
+
+exit $status
@@ -0,0 +1,392 @@
+/*!
+*
+*   \file    main.c
+*   \brief   YM2610 register log replay and benchmark.
+*   \author  Mourad Reggadi (GnGeo-X)
+*   \version 01.00
+*   \date    18/10/2026
+*   \warning Licensed under the terms of the GNU General Public License v2 :
+*            https://tldrlegal.com/license/gnu-general-public-license-v2#fulltext
+*   \note    Replays a log written by GnGeoX with soundlog=1 through YM2610Update_stream()
+*            as fast as possible, then reports throughput and a checksum of the produced samples.
+*            Usage : YmReplay file.vgm [rate] [loops]
+*            compare.sh replays logs through the SIMD and scalar FM paths and checks that they give the same samples.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <SDL2/SDL.h>
+
+#include "GnGeoXym2610.h"
+#include "GnGeoXym2610core.h"
+
+#define REPLAY_CHUNK 1024
+
+static double replay_time = 0;
+
+/* ******************************************************************************************************************/
+/*!
+* \brief  Present time used by YM2610 busy flag emulation.
+*
+* \return Replay position in seconds.
+*/
+/* ******************************************************************************************************************/
+double neo_ym2610_count ( void )
+{
+    return ( replay_time );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Timers are not emulated while replaying, the log already holds the writes they caused.
+*
+*/
+/* ******************************************************************************************************************/
+static void replay_timer ( Sint32 timer_id, Sint32 count, double step_time )
+{
+    ( void ) timer_id;
+    ( void ) count;
+    ( void ) step_time;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  No Z80 to interrupt.
+*
+*/
+/* ******************************************************************************************************************/
+static void replay_irq ( Sint32 irq )
+{
+    ( void ) irq;
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Reads a little endian 32 bits value.
+*
+*/
+/* ******************************************************************************************************************/
+static Uint32 replay_u32 ( const Uint8* data )
+{
+    return ( data[0] | ( data[1] << 8 ) | ( data[2] << 16 ) | ( ( Uint32 ) data[3] << 24 ) );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Gives the size of a command, checked against the end of the stream.
+*
+* \param  data Command stream.
+* \param  pos Command position.
+* \param  size Command stream size.
+* \return Command size, 0 when the command is unknown or goes past the end of the stream.
+*/
+/* ******************************************************************************************************************/
+static Uint32 replay_command_size ( const Uint8* data, Uint32 pos, Uint32 size )
+{
+    Uint64 length = 0;
+
+    switch ( data[pos] )
+    {
+    case ( YM2610_LOG_CMD_PORT_A ) :
+    case ( YM2610_LOG_CMD_PORT_B ) :
+    case ( YM2610_LOG_CMD_WAIT ) :
+        {
+            length = 3;
+        }
+        break;
+    case ( YM2610_LOG_CMD_END ) :
+        {
+            length = 1;
+        }
+        break;
+    case ( YM2610_LOG_CMD_BLOCK ) :
+        {
+            if ( size - pos < 7 )
+            {
+                return ( 0 );
+            }
+
+            length = 7 + ( Uint64 ) replay_u32 ( &data[pos + 3] );
+        }
+        break;
+    default:
+        {
+            return ( 0 );
+        }
+        break;
+    }
+
+    if ( pos + length > size )
+    {
+        return ( 0 );
+    }
+
+    return ( ( Uint32 ) length );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Monotonic time in seconds.
+*
+*/
+/* ******************************************************************************************************************/
+static double replay_seconds ( void )
+{
+    struct timespec now;
+
+    clock_gettime ( CLOCK_MONOTONIC, &now );
+
+    return ( now.tv_sec + now.tv_nsec / 1e9 );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Loads ADPCM ROM data blocks.
+*
+* \param  data Command stream.
+* \param  size Command stream size.
+* \param  roms ADPCM-A and ADPCM-B ROMs.
+* \param  sizes ROM sizes.
+* \return SDL_FALSE when error, SDL_TRUE otherwise.
+*/
+/* ******************************************************************************************************************/
+static SDL_bool replay_load_roms ( const Uint8* data, Uint32 size, Uint8** roms, Uint32* sizes )
+{
+    Uint32 pos = 0;
+
+    while ( pos < size )
+    {
+        Uint32 command = replay_command_size ( data, pos, size );
+
+        if ( command == 0 )
+        {
+            printf ( "Unknown or truncated command 0x%02X at %u\n", data[pos], pos );
+            return ( SDL_FALSE );
+        }
+
+        switch ( data[pos] )
+        {
+        case ( YM2610_LOG_CMD_END ) :
+            {
+                return ( SDL_TRUE );
+            }
+            break;
+        case ( YM2610_LOG_CMD_BLOCK ) :
+            {
+                Uint8 type = data[pos + 2];
+                Uint32 length = replay_u32 ( &data[pos + 3] );
+                Uint32 total = replay_u32 ( &data[pos + 7] );
+                Uint32 start = replay_u32 ( &data[pos + 11] );
+                Sint32 index = type - YM2610_LOG_ROM_ADPCM_A;
+
+                if ( ( ( type == YM2610_LOG_ROM_ADPCM_A ) || ( type == YM2610_LOG_ROM_ADPCM_B ) ) && ( length >= 8 ) )
+                {
+                    if ( roms[index] == NULL )
+                    {
+                        roms[index] = calloc ( 1, total );
+                        sizes[index] = total;
+                    }
+
+                    if ( ( roms[index] == NULL ) || ( ( Uint64 ) start + length - 8 > sizes[index] ) )
+                    {
+                        printf ( "Bad ROM block at %u\n", pos );
+                        return ( SDL_FALSE );
+                    }
+
+                    memcpy ( roms[index] + start, &data[pos + 15], length - 8 );
+                }
+            }
+            break;
+        default:
+            break;
+        }
+
+        pos += command;
+    }
+
+    return ( SDL_TRUE );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Replays the command stream once.
+*
+* \param  data Command stream.
+* \param  size Command stream size.
+* \param  rate Synthesis rate.
+* \param  checksum FNV-1a hash of the produced samples.
+* \return Number of produced samples.
+*/
+/* ******************************************************************************************************************/
+static Uint64 replay_run ( const Uint8* data, Uint32 size, Uint32 rate, Uint64* checksum )
+{
+    static Uint16 buffer[REPLAY_CHUNK * 2];
+    Uint64 ticks = 0;
+    Uint64 produced = 0;
+    Uint32 pos = 0;
+
+    while ( pos < size )
+    {
+        Uint32 command = replay_command_size ( data, pos, size );
+        Uint32 wait = 0;
+
+        switch ( data[pos] )
+        {
+        case ( YM2610_LOG_CMD_PORT_A ) :
+        case ( YM2610_LOG_CMD_PORT_B ) :
+            {
+                Sint32 port = ( data[pos] == YM2610_LOG_CMD_PORT_B ) ? 2 : 0;
+
+                if ( command != 0 )
+                {
+                    YM2610Write ( port, data[pos + 1] );
+                    YM2610Write ( port + 1, data[pos + 2] );
+                }
+            }
+            break;
+        case ( YM2610_LOG_CMD_WAIT ) :
+            {
+                if ( command != 0 )
+                {
+                    wait = data[pos + 1] | ( data[pos + 2] << 8 );
+                }
+            }
+            break;
+        case ( YM2610_LOG_CMD_BLOCK ) :
+            break;
+        default:
+            {
+                command = 0;
+            }
+            break;
+        }
+
+        /* End of the stream, unknown or truncated command */
+        pos = ( command != 0 ) ? pos + command : size;
+
+        if ( wait != 0 )
+        {
+            Uint64 target = 0;
+
+            ticks += wait;
+            replay_time = ( double ) ticks / YM2610_LOG_RATE;
+            target = ( ticks * rate ) / YM2610_LOG_RATE;
+
+            while ( produced < target )
+            {
+                Sint32 count = ( Sint32 ) SDL_min ( target - produced, ( Uint64 ) REPLAY_CHUNK );
+
+                YM2610Update_stream ( count, buffer );
+
+                for ( Sint32 loop = 0; loop < count * 2; loop++ )
+                {
+                    *checksum = ( *checksum ^ buffer[loop] ) * 1099511628211ULL;
+                }
+
+                produced += count;
+            }
+        }
+    }
+
+    return ( produced );
+}
+/* ******************************************************************************************************************/
+/*!
+* \brief  Entry point.
+*
+*/
+/* ******************************************************************************************************************/
+int main ( int argc, char* argv[] )
+{
+    FILE* file = NULL;
+    Uint8* file_data = NULL;
+    long file_size = 0;
+    Uint8* roms[2] = { NULL, NULL };
+    Uint32 sizes[2] = { 0, 0 };
+    Uint32 rate = YM2610_NATIVE_RATE;
+    Uint32 loops = 1;
+    Uint32 clock = 0;
+    Uint32 offset = 0;
+    Uint64 checksum = 14695981039346656037ULL;
+    Uint64 samples = 0;
+    double start = 0, elapsed = 0;
+
+    if ( argc < 2 )
+    {
+        printf ( "Usage : %s file.vgm [rate] [loops]\n", argv[0] );
+        return ( EXIT_FAILURE );
+    }
+
+    if ( argc > 2 )
+    {
+        rate = strtoul ( argv[2], NULL, 10 );
+    }
+
+    if ( argc > 3 )
+    {
+        loops = strtoul ( argv[3], NULL, 10 );
+    }
+
+    file = fopen ( argv[1], "rb" );
+    if ( file == NULL )
+    {
+        printf ( "Can't open %s\n", argv[1] );
+        return ( EXIT_FAILURE );
+    }
+
+    fseek ( file, 0, SEEK_END );
+    file_size = ftell ( file );
+    fseek ( file, 0, SEEK_SET );
+
+    file_data = malloc ( file_size );
+    if ( ( file_data == NULL ) || ( fread ( file_data, 1, file_size, file ) != ( size_t ) file_size ) )
+    {
+        printf ( "Can't read %s\n", argv[1] );
+        fclose ( file );
+        return ( EXIT_FAILURE );
+    }
+    fclose ( file );
+
+    if ( ( file_size < YM2610_LOG_HEADER_SIZE ) || ( memcmp ( file_data, "Vgm ", 4 ) != 0 ) )
+    {
+        printf ( "%s is not a VGM file\n", argv[1] );
+        return ( EXIT_FAILURE );
+    }
+
+    /* YM2610B flag lives in bit 31 */
+    clock = replay_u32 ( &file_data[YM2610_LOG_CLOCK] ) & 0x7FFFFFFF;
+    offset = YM2610_LOG_DATA_OFFSET + replay_u32 ( &file_data[YM2610_LOG_DATA_OFFSET] );
+
+    if ( ( clock == 0 ) || ( offset >= ( Uint32 ) file_size ) || ( rate == 0 ) )
+    {
+        printf ( "%s has no YM2610 data\n", argv[1] );
+        return ( EXIT_FAILURE );
+    }
+
+    if ( replay_load_roms ( &file_data[offset], file_size - offset, roms, sizes ) == SDL_FALSE )
+    {
+        free ( roms[0] );
+        free ( roms[1] );
+        free ( file_data );
+        return ( EXIT_FAILURE );
+    }
+
+    start = replay_seconds();
+
+    for ( Uint32 loop = 0; loop < loops; loop++ )
+    {
+        replay_time = 0;
+        YM2610Init ( clock, rate, roms[0], sizes[0], roms[1], sizes[1], replay_timer, replay_irq );
+        samples += replay_run ( &file_data[offset], file_size - offset, rate, &checksum );
+    }
+
+    elapsed = replay_seconds() - start;
+
+    printf ( "%s : %llu samples at %u Hz in %.3f s\n", argv[1], ( unsigned long long ) samples, rate, elapsed );
+    if ( elapsed > 0 )
+    {
+        printf ( "%.0f samples/s (x%.1f real time)\n", samples / elapsed, ( samples / ( double ) rate ) / elapsed );
+    }
+    printf ( "Checksum %016llx\n", ( unsigned long long ) checksum );
+
+    free ( roms[0] );
+    free ( roms[1] );
+    free ( file_data );
+
+    return ( EXIT_SUCCESS );
+}